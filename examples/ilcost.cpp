@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//
+// static cost and register pressure report of IL kernel, no GPU is required
+// usage: ilcost file.il [wavefront size] [number of SIMDs] [optimize flags]
+// IL is read from standard input when file is "-"
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <boost/format.hpp>
+#include <cal/il/opt/cal_il_optimize.hpp>
+#include <cal/il/opt/cal_il_cost.hpp>
+
+using namespace cal::il;
+using boost::format;
+
+int main( int argc, char* argv[] )
+{
+    std::stringstream   source;
+    std::string         name;
+    int                 wavefront_size,simd_count,flags;
+
+    if( argc<2 ) {
+        std::cerr << "usage: ilcost file.il [wavefront size] [number of SIMDs] [optimize flags]\n";
+        return 1;
+    }
+
+    name           = argv[1];
+    wavefront_size = argc>2 ? std::atoi(argv[2]) : 64;
+    simd_count     = argc>3 ? std::atoi(argv[3]) : 0;
+    flags          = argc>4 ? std::atoi(argv[4]) : 0;
+
+    if( name=="-" ) source << std::cin.rdbuf();
+    else {
+        std::ifstream file(name.c_str());
+
+        if( !file ) {
+            std::cerr << "cannot open " << name << "\n";
+            return 1;
+        }
+        source << file.rdbuf();
+    }
+
+    std::string il = flags ? optimize(source.str(),flags) : source.str();
+    kernel_cost cost = estimate_cost(il,wavefront_size,simd_count);
+
+    std::cout << format("%-24s %8i\n") % "ALU float" % cost.alu_float;
+    std::cout << format("%-24s %8i\n") % "ALU int" % cost.alu_int;
+    std::cout << format("%-24s %8i\n") % "ALU double" % cost.alu_double;
+    std::cout << format("%-24s %8i\n") % "ALU transcendental" % cost.alu_transcendental;
+    std::cout << format("%-24s %8i\n") % "fetch/sample" % cost.fetch;
+    std::cout << format("%-24s %8i\n") % "LDS" % cost.lds;
+    std::cout << format("%-24s %8i\n") % "UAV" % cost.uav;
+    std::cout << format("%-24s %8i\n") % "atomics" % cost.atomic;
+    std::cout << format("%-24s %8i\n") % "flow control" % cost.flow;
+    std::cout << format("%-24s %8i\n") % "other" % cost.other;
+    std::cout << format("%-24s %8.2f\n") % "ALU:fetch" % cost.alu_fetch_ratio;
+    std::cout << format("%-24s %8i\n") % "max live registers" % cost.max_live;
+    std::cout << format("%-24s %8i\n") % "indexed temps" % cost.indexed_temps;
+    std::cout << format("%-24s %8i\n") % "GPRs" % cost.registers;
+    std::cout << format("%-24s %8i\n") % "wavefronts per SIMD" % cost.wavefronts_per_simd;
+    if( simd_count>0 ) std::cout << format("%-24s %8i\n") % "resident threads" % cost.resident_threads;
+    if( cost.scratch_registers>0 ) std::cout << format("warning: %i indexed temp registers are placed in scratch memory\n") % cost.scratch_registers;
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//
+// IL generation time of all example kernels, no GPU is required
+// second part generates all kernels with generate_all using 1,2,4... threads
+// usage: ilgenbench [iterations] [max threads]
+//
+
+// every thread needs its own Source for parallel generation
+#ifndef __CAL_THREADSAFE
+  #define __CAL_THREADSAFE
+#endif
+
+#ifdef _MSC_VER
+  #pragma warning( disable : 4522 )
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <boost/format.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <cal/cal.hpp>
+#include <cal/cal_il.hpp>
+#include <cal/cal_il_atomics.hpp>
+#include <cal/cal_il_batch.hpp>
+#include <cal/il/math/cal_il_rsqrt.hpp>
+#include "cal_il_double4.hpp"
+
+// every example is compiled in its own namespace, headers above are already included
+#define main example_main
+
+namespace ex_coalescingtest {
+#include "coalescingtest.cpp"
+}
+#undef WARPSIZE
+#undef WARPCOUNT
+#undef THREADS_PER_GRP
+#undef NR_ITERATIONS
+#undef NR_READS_Y
+#undef NR_READS_X
+#undef LINEWIDTH
+
+namespace ex_func {
+#include "func.cpp"
+}
+#undef WORKGROUP_SIZE
+#undef WORKGROUP_COUNT
+
+namespace ex_matrixmult {
+#include "matrixmult.cpp"
+}
+#undef BX
+#undef BY
+#undef BX4
+#undef BY4
+#undef ITER_COUNT
+#undef WIDTH
+#undef HEIGHT
+
+namespace ex_matrixmult2 {
+#include "matrixmult2.cpp"
+}
+#undef BX
+#undef BY
+#undef BX4
+#undef BY4
+#undef ITER_COUNT
+#undef WIDTH
+#undef HEIGHT
+
+namespace ex_matrixmult3 {
+#include "matrixmult3.cpp"
+}
+#undef BX
+#undef BY
+#undef BX4
+#undef ITER_COUNT
+#undef WIDTH
+#undef HEIGHT
+
+namespace ex_peekflops {
+#include "peekflops.cpp"
+}
+#undef MAX_THREADS
+#undef NR_ITERATIONS
+#undef NR_MAD_INST
+
+namespace ex_uavatomics {
+#include "uavatomics.cpp"
+}
+#undef WORKGROUP_SIZE
+#undef WORKGROUP_COUNT
+
+namespace ex_uavwrite {
+#include "uavwrite.cpp"
+}
+#undef WORKGROUP_SIZE
+#undef WORKGROUP_COUNT
+
+namespace ex_nbody {
+#include "nbody_kernel.cpp"
+}
+
+namespace ex_dbl_nbody {
+#include "dbl_nbody_kernel.cpp"
+}
+
+#undef main
+
+using namespace boost;
+using namespace cal::il;
+
+//
+// nbody kernels without device query ( 64 threads per wavefront, 10 SIMDs )
+//
+
+std::string create_nbody()
+{
+    std::stringstream code;
+
+    Source::begin();
+
+    input2d<float4>        input_data(0);
+    global<float4>         output_data;
+    named_variable<uint1>  data_size("cb0[0].x"),tile_count("cb0[0].y"), buffer_width("cb0[0].z");
+    named_variable<float1> _buffer_width("cb0[1].x"),_buffer_height2("cb0[1].y"),dT("cb0[1].z");
+
+    ex_nbody::nbody_kernel( input_data, output_data, data_size, tile_count, buffer_width,
+                            _buffer_width, _buffer_height2, dT, 0.01f, 64*4*10, 2, 4, 2, 2 );
+
+    Source::end();
+
+    Source::emitHeader(code);
+    Source::emitCode(code);
+
+    return code.str();
+}
+
+std::string create_dbl_nbody()
+{
+    std::stringstream code;
+
+    Source::begin();
+
+    input2d<double2>        input_data(0);
+    global<double2>         output_data;
+    named_variable<uint1>   data_size("cb0[0].x"),tile_count("cb0[0].y"), buffer_width("cb0[0].z");
+    named_variable<float1>  _buffer_width("cb0[1].x"),_buffer_height2("cb0[1].y");
+    named_variable<double1> dT("cb0[2].xy");
+
+    ex_dbl_nbody::nbody_kernel( input_data, output_data, data_size, tile_count, buffer_width,
+                                _buffer_width, _buffer_height2, dT, 0.01, 64*4*10, 2, 4, 2, 2, false );
+
+    Source::end();
+
+    Source::emitHeader(code);
+    Source::emitCode(code);
+
+    return code.str();
+}
+
+std::string create_coalescing()     { return ex_coalescingtest::create_kernel_coalescing(4); }
+std::string create_func()           { return ex_func::create_kernel(); }
+std::string create_matrixmult()     { return ex_matrixmult::create_kernel_matrixmul(); }
+std::string create_matrixmult2()    { return ex_matrixmult2::create_kernel_matrixmul(); }
+std::string create_matrixmult3()    { return ex_matrixmult3::create_kernel_matrixmul(); }
+std::string create_peekflops()      { return ex_peekflops::create_kernel_peekperf(64); }
+std::string create_uavatomics()     { return ex_uavatomics::create_kernel(ex_uavatomics::kernel_C); }
+std::string create_uavwrite()       { return ex_uavwrite::create_kernel(ex_uavwrite::kernel_C); }
+
+struct benchmark_info
+{
+    const char*     name;
+    std::string     (*create)();
+};
+
+static const benchmark_info benchmarks[] = {
+    { "coalescingtest", create_coalescing },
+    { "func",           create_func },
+    { "matrixmult",     create_matrixmult },
+    { "matrixmult2",    create_matrixmult2 },
+    { "matrixmult3",    create_matrixmult3 },
+    { "peekflops",      create_peekflops },
+    { "uavatomics",     create_uavatomics },
+    { "uavwrite",       create_uavwrite },
+    { "nbody",          create_nbody },
+    { "dbl_nbody",      create_dbl_nbody },
+    { NULL,             NULL }
+};
+
+long long elapsed( const posix_time::ptime& t1 )
+{
+    return posix_time::time_period(t1,posix_time::microsec_clock::local_time()).length().total_microseconds();
+}
+
+int main( int argc, char* argv[] )
+{
+    int         iterations = argc>1 ? std::atoi(argv[1]) : 100;
+    unsigned    max_threads = argc>2 ? std::atoi(argv[2]) : thread::hardware_concurrency();
+    long long   total = 0;
+
+    if( iterations<1 ) iterations = 1;
+    if( max_threads<1 ) max_threads = 1;
+
+    std::cout << format("%-16s %8s %12s %12s\n") % "kernel" % "lines" % "total[us]" % "kernel[us]";
+
+    for(int i=0;benchmarks[i].name;i++) {
+        std::string il = benchmarks[i].create(); // warm up
+        int         lines = 0;
+
+        for(std::string::size_type p=0;p<il.length();p++) if( il[p]=='\n' ) lines++;
+
+        posix_time::ptime t1 = posix_time::microsec_clock::local_time();
+        for(int k=0;k<iterations;k++) benchmarks[i].create();
+        long long t = elapsed(t1);
+
+        total += t;
+
+        std::cout << format("%-16s %8i %12i %12.1f\n") % benchmarks[i].name % lines % t % ((double)t/iterations);
+    }
+
+    std::cout << format("%-16s %8s %12i\n") % "total" % "" % total;
+
+    //
+    // every example kernel generated iterations times as independent jobs
+    //
+
+    std::vector<generate_job>   jobs;
+    std::vector<std::string>    serial;
+
+    for(int k=0;k<iterations;k++) {
+        for(int i=0;benchmarks[i].name;i++) {
+            jobs.push_back(benchmarks[i].create);
+            if( k==0 ) serial.push_back(benchmarks[i].create());
+        }
+    }
+
+    std::cout << format("\n%-16s %8s %12s %12s\n") % "threads" % "jobs" % "total[us]" % "speedup";
+
+    long long single = 0;
+
+    for(unsigned threads=1;;threads*=2) {
+        if( threads>max_threads ) threads = max_threads;
+
+        posix_time::ptime           t1 = posix_time::microsec_clock::local_time();
+        std::vector<std::string>    result = generate_all(jobs,generate_stage(),threads);
+        long long                   t = elapsed(t1);
+
+        if( threads==1 ) single = t;
+
+        for(std::size_t i=0;i<result.size();i++) {
+            if( result[i]!=serial[i%serial.size()] ) {
+                std::cout << "kernel " << i << " differs from serial generation\n";
+                return 1;
+            }
+        }
+
+        std::cout << format("%-16i %8i %12i %12.2f\n") % threads % jobs.size() % t % ((double)single/(t>0 ? t : 1));
+
+        if( threads==max_threads ) break;
+    }
+
+    return 0;
+}
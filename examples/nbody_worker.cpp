@@ -20,7 +20,11 @@
 
 #include <boost/format.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/bind.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_io.hpp>
 #include <cal/cal.hpp>
+#include <cal/cal_il_kernel_cache.hpp>
 #include "nbody_worker.h"
 
 std::string create_nbody_kernel( cal::Device& device, int num_threads, int workitem_size, int tile_size, int read_count, int unroll_count, float eps2 );
@@ -60,8 +64,11 @@ void NBodyWorker::init()
     _context = Context(_device);
     devices  = _context.getInfo<CAL_CONTEXT_DEVICES>();
 
-    // create program
-    std::string source = create_nbody_kernel(_device,opt.num_threads,opt.workitem_size,opt.tile_size,opt.read_count,opt.unroll_count,opt.eps2);
+    // create program ( workers with the same options share generated code )
+    static cal::il::KernelCache kernel_cache;
+
+    std::string source = kernel_cache.get( "nbody", boost::make_tuple(opt.num_threads,opt.workitem_size,opt.tile_size,opt.read_count,opt.unroll_count,opt.eps2), _device,
+                                           boost::bind(create_nbody_kernel,boost::ref(_device),opt.num_threads,opt.workitem_size,opt.tile_size,opt.read_count,opt.unroll_count,opt.eps2) );
     //std::cout << source; // Uncomment to emit IL code
     _program = Program( _context, source.c_str(), source.length() );
     _program.build(devices);
@@ -108,7 +108,7 @@ std::string create_kernel_findnearest()
     std::stringstream   code;
 
     code << "il_cs_2_0\n";
-    code << "dcl_cb cb0[2]\n";
+    code << "dcl_cb cb0[5]\n";
     code << format("dcl_num_thread_per_group %i\n") % THREADS_PER_GRP;
     code << format("dcl_struct_lds_id(0) 16,%i\n") % THREADS_PER_GRP;
     
@@ -118,8 +118,8 @@ std::string create_kernel_findnearest()
     global<float4>     error_vector;
           
     kernel_findnearest( A,B,error_vector,
-                        named_variable<float1>("cb0[1].x"), named_variable<float1>("cb0[1].y"),
-                        named_variable<float1>("cb0[1].z") );
+                        named_variable<float1>("cb0[4].x"), named_variable<float1>("cb0[4].y"),
+                        named_variable<float1>("cb0[4].z") );
 
     Source::end();
     
@@ -199,7 +199,7 @@ std::string create_kernel_reducematrix()
     std::stringstream   code;
 
     code << "il_cs_2_0\n";
-    code << "dcl_cb cb0[2]\n";
+    code << "dcl_cb cb0[5]\n";
     code << "dcl_cb cb1[4096]\n";
     code << format("dcl_num_thread_per_group %i\n") % (RM_LX*RM_LY);
 
@@ -210,8 +210,8 @@ std::string create_kernel_reducematrix()
     indexed_register<float4>    gidx("cb1");
 
     kernel_reducematrix( A,gidx,R,
-                         named_variable<uint1>("cb0[1].x"), named_variable<uint1>("cb0[1].y"),
-                         named_variable<uint1>("cb0[1].z"), named_variable<uint1>("cb0[1].w") );
+                         named_variable<uint1>("cb0[4].x"), named_variable<uint1>("cb0[4].y"),
+                         named_variable<uint1>("cb0[4].z"), named_variable<uint1>("cb0[4].w") );
 
     cal::il::Program::end();
 
@@ -267,10 +267,10 @@ void init()
     _kernel_findnearest.setArgBind(0,"i0"); // A
     _kernel_findnearest.setArgBind(1,"i1"); // R
     _kernel_findnearest.setArgBind(2,"g[]"); // gidx
-    _kernel_findnearest.setArgBind(3,"cb0",0,16); // flat2d data
-    _kernel_findnearest.setArgBind(4,"cb0",16,4); // Ax
-    _kernel_findnearest.setArgBind(5,"cb0",16+4,4); // Ay
-    _kernel_findnearest.setArgBind(6,"cb0",16+8,4); // Ry
+    flat2d::bind_flat_cb0(_kernel_findnearest,3); // flat2d data
+    _kernel_findnearest.setArgBind(3+flat2d::cb0_size,"cb0",16*flat2d::cb0_size,4); // Ax
+    _kernel_findnearest.setArgBind(3+flat2d::cb0_size+1,"cb0",16*flat2d::cb0_size+4,4); // Ay
+    _kernel_findnearest.setArgBind(3+flat2d::cb0_size+2,"cb0",16*flat2d::cb0_size+8,4); // Ry
     
     // create program
     source = create_kernel_reducematrix();
@@ -284,11 +284,11 @@ void init()
     _kernel_reducematrix.setArgBind(0,"i0"); // A
     _kernel_reducematrix.setArgBind(1,"cb1"); // gidx
     _kernel_reducematrix.setArgBind(2,"g[]"); // R
-    _kernel_reducematrix.setArgBind(3,"cb0",0,16); // flat2d data
-    _kernel_reducematrix.setArgBind(4,"cb0",16,4); // Ax
-    _kernel_reducematrix.setArgBind(5,"cb0",16+4,4); // Ay
-    _kernel_reducematrix.setArgBind(6,"cb0",16+8,4); // Rx
-    _kernel_reducematrix.setArgBind(7,"cb0",16+12,4); // Ry
+    flat2d::bind_flat_cb0(_kernel_reducematrix,3); // flat2d data
+    _kernel_reducematrix.setArgBind(3+flat2d::cb0_size,"cb0",16*flat2d::cb0_size,4); // Ax
+    _kernel_reducematrix.setArgBind(3+flat2d::cb0_size+1,"cb0",16*flat2d::cb0_size+4,4); // Ay
+    _kernel_reducematrix.setArgBind(3+flat2d::cb0_size+2,"cb0",16*flat2d::cb0_size+8,4); // Rx
+    _kernel_reducematrix.setArgBind(3+flat2d::cb0_size+3,"cb0",16*flat2d::cb0_size+12,4); // Ry
 
     // allocate data
     _A.resize(HEIGHT,WIDTH);
@@ -306,10 +306,10 @@ void run_findnearest( math::cal::matrix<float>& A, math::cal::matrix<float>& R,
     _kernel_findnearest.setArg(0,A.data());
     _kernel_findnearest.setArg(1,R.data());
     _kernel_findnearest.setArg(2,gidx);
-    _kernel_findnearest.setArg(3,flat2d::make_flat_cb0(global,local));
-    _kernel_findnearest.setArg(4,(float)((uint32_t)(A.size2()+3)/4));
-    _kernel_findnearest.setArg(5,(float)A.size1());
-    _kernel_findnearest.setArg(6,(float)R.size1());
+    flat2d::set_flat_cb0(_kernel_findnearest,3,global,local);
+    _kernel_findnearest.setArg(3+flat2d::cb0_size,(float)((uint32_t)(A.size2()+3)/4));
+    _kernel_findnearest.setArg(3+flat2d::cb0_size+1,(float)A.size1());
+    _kernel_findnearest.setArg(3+flat2d::cb0_size+2,(float)R.size1());
 
     _context.enqueueKernel( _kernel_findnearest,
                             flat2d::make_flat_global(global, local),
@@ -326,11 +326,11 @@ void run_reducematrix( math::cal::matrix<float>& A, math::cal::matrix<float>& R,
     _kernel_reducematrix.setArg(0,A.data());
     _kernel_reducematrix.setArg(1,gidx);
     _kernel_reducematrix.setArg(2,R.data());
-    _kernel_reducematrix.setArg(3,flat2d::make_flat_cb0(global,local));
-    _kernel_reducematrix.setArg(4,(uint32_t)(A.size2()+3)/4);
-    _kernel_reducematrix.setArg(5,(uint32_t)A.size1());
-    _kernel_reducematrix.setArg(6,(uint32_t)R.data_ld());
-    _kernel_reducematrix.setArg(7,(uint32_t)R.size1());
+    flat2d::set_flat_cb0(_kernel_reducematrix,3,global,local);
+    _kernel_reducematrix.setArg(3+flat2d::cb0_size,(uint32_t)(A.size2()+3)/4);
+    _kernel_reducematrix.setArg(3+flat2d::cb0_size+1,(uint32_t)A.size1());
+    _kernel_reducematrix.setArg(3+flat2d::cb0_size+2,(uint32_t)R.data_ld());
+    _kernel_reducematrix.setArg(3+flat2d::cb0_size+3,(uint32_t)R.size1());
 
     _context.enqueueKernel( _kernel_reducematrix,
                             flat2d::make_flat_global(global, local),
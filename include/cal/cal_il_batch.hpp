@@ -0,0 +1,165 @@
+/*
+ * C++ to IL compiler/generator parallel kernel generation
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_BATCH_HPP__
+#define __CAL_IL_BATCH_HPP__
+
+#include <vector>
+#include <string>
+#include <boost/function.hpp>
+#include <cal/cal_il.hpp>
+#ifdef __CAL_THREADSAFE
+  #include <boost/thread.hpp>
+  #include <boost/exception_ptr.hpp>
+#endif
+
+namespace cal {
+namespace il {
+
+typedef boost::function<std::string ()>                     generate_job;   // returns IL of one kernel
+typedef boost::function<void (int, const std::string&)>     generate_stage; // called with job index and its IL
+
+namespace detail {
+
+#ifdef __CAL_THREADSAFE
+//
+// jobs are taken in order by worker threads, every thread has its own Source
+//
+
+struct generate_queue
+{
+    const std::vector<generate_job>&    job;
+    std::vector<std::string>&           result;
+    const generate_stage&               stage;
+    boost::mutex                        mutex;
+    unsigned                            next;
+    boost::exception_ptr                error;
+
+    generate_queue( const std::vector<generate_job>& _job, std::vector<std::string>& _result, const generate_stage& _stage ) :
+        job(_job), result(_result), stage(_stage), next(0) {}
+
+    bool pop( unsigned& i )
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+
+        if( error || next>=job.size() ) return false;
+        i = next++;
+        return true;
+    }
+
+    void fail()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        if( !error ) error = boost::current_exception();
+    }
+
+    void operator()()
+    {
+        unsigned i;
+
+        while( pop(i) ) {
+            try {
+                result[i] = job[i]();
+                if( stage ) stage(i,result[i]);
+            }
+            catch(...) {
+                fail();
+            }
+        }
+    }
+};
+#endif
+
+} // detail
+
+//
+// runs independent kernel generators concurrently and returns IL in order of jobs
+// stage ( for example program compilation ) runs on the worker thread right after its job
+// jobs run one by one when __CAL_THREADSAFE is not defined ( Source is shared then )
+// threads==0 uses one thread per core, first exception thrown by a job is rethrown
+//
+
+inline std::vector<std::string> generate_all( const std::vector<generate_job>& jobs, const generate_stage& stage=generate_stage(), unsigned threads=0 )
+{
+    std::vector<std::string>    result(jobs.size());
+
+#ifdef __CAL_THREADSAFE
+    detail::generate_queue      queue(jobs,result,stage);
+    boost::thread_group         group;
+
+    if( threads==0 ) threads = boost::thread::hardware_concurrency();
+    if( threads==0 ) threads = 1;
+
+    // caller's Source is left untouched, it can be in the middle of kernel generation
+    for(unsigned k=0;k<threads && k<jobs.size();k++) group.create_thread(boost::ref(queue));
+    group.join_all();
+
+    if( queue.error ) boost::rethrow_exception(queue.error);
+#else
+    for(unsigned i=0;i<jobs.size();i++) {
+        result[i] = jobs[i]();
+        if( stage ) stage(i,result[i]);
+    }
+#endif
+
+    return result;
+}
+
+#if defined(__CAL_HPP__)
+namespace detail {
+
+struct build_stage
+{
+    const Context&              context;
+    const std::vector<Device>&  devices;
+    std::vector<Program>&       program;
+
+    build_stage( const Context& _context, const std::vector<Device>& _devices, std::vector<Program>& _program ) :
+        context(_context), devices(_devices), program(_program) {}
+
+    void operator()( int i, const std::string& source ) const
+    {
+        Program p(context, source.c_str(), source.length());
+        p.build(devices);
+        program[i] = p;
+    }
+};
+
+} // detail
+
+//
+// generates and compiles kernels, compilation of one kernel overlaps with generation of others
+//
+
+inline std::vector<Program> build_all( const Context& context, const std::vector<Device>& devices, const std::vector<generate_job>& jobs, unsigned threads=0 )
+{
+    std::vector<Program>    program(jobs.size());
+
+    generate_all(jobs,detail::build_stage(context,devices,program),threads);
+    return program;
+}
+#endif
+
+} // il
+} // cal
+
+#endif
@@ -24,9 +24,9 @@
 #define __CAL_IL_FLAT2D_H
 
 #include <cal/cal_il.hpp>
+#include <boost/cstdint.hpp>
 
 #ifdef __CAL_HPP__
-  #include <boost/cstdint.hpp>
   #include <boost/array.hpp>
 #endif
 
@@ -34,6 +34,43 @@ namespace cal {
 namespace il {
 namespace flat2d {
 
+//
+// cb0 layout ( filled by make_flat_cb0 )
+// cb0[0] - local width, local height, global width, global height
+// cb0[1] - division by local width ( multiplier, shift 1, shift 2 ), number of groups in x
+// cb0[2] - division by global width ( multiplier, shift 1, shift 2 ), number of groups in y
+// cb0[3] - division by number of groups in x ( multiplier, shift 1, shift 2 )
+//
+
+static const int cb0_size = 4; // number of cb0 entries used by flat2d
+
+//
+// magic numbers for division by runtime uniform d ( 1<=d<2^32 ) valid for every 32-bit dividend
+// n/d = (t + ((n-t) >> shift1)) >> shift2 with t = mul_hi(n,multiplier)
+// ( Granlund, Montgomery - "Division by Invariant Integers using Multiplication", figure 4.1 )
+//
+
+inline void get_div_magic( boost::uint32_t d, boost::uint32_t& multiplier, boost::uint32_t& shift1, boost::uint32_t& shift2 )
+{
+    int l=0;
+
+    assert( d>0 );
+    while( l<32 && (boost::uint64_t(1)<<l)<d ) l++; // ceil(log2(d))
+
+    multiplier = (boost::uint32_t)( ((boost::uint64_t(1)<<32)*((boost::uint64_t(1)<<l)-d))/d + 1 );
+    shift1     = l<1 ? l : 1;
+    shift2     = l>1 ? l-1 : 0;
+}
+
+// n divided by value with magic numbers in cb0[idx].xyz
+inline uint1 fast_div( const uint1& n, int idx )
+{
+    std::string cb = (::cal::il::detail::il_format("cb0[%i]") % idx).str();
+    uint1       t  = mul_hi( n, named_variable<uint1>(cb+".x") );
+
+    return (t + ((n - t) >> named_variable<uint1>(cb+".y"))) >> named_variable<uint1>(cb+".z");
+}
+
 inline uint4 get_local_size()
 {
     return named_variable<uint4>("cb0[0].xy00");
@@ -60,59 +97,63 @@ inline uint1 get_global_size( int i )
 
 inline uint4 get_local_id()
 {
-    return uint4( named_variable<uint1>("vTidInGrp.x") % named_variable<uint1>("cb0[0].x"),
-                  named_variable<uint1>("vTidInGrp.x") / named_variable<uint1>("cb0[0].x"),
-                  uint1(0), uint1(0) );
+    uint1 y = fast_div( named_variable<uint1>("vTidInGrp.x"), 1 );
+
+    return uint4( named_variable<uint1>("vTidInGrp.x") - y*named_variable<uint1>("cb0[0].x"), y, uint1(0), uint1(0) );
 }
 
 inline uint1 get_local_id( int i )
 {
     assert( i>=0 && i<2 );
-    if( i==0 ) return named_variable<uint1>("vTidInGrp.x") % named_variable<uint1>("cb0[0].x");
-    return named_variable<uint1>("vTidInGrp.x") / named_variable<uint1>("cb0[0].x");
+    uint1 y = fast_div( named_variable<uint1>("vTidInGrp.x"), 1 );
+
+    if( i==0 ) return named_variable<uint1>("vTidInGrp.x") - y*named_variable<uint1>("cb0[0].x");
+    return y;
 }
 
 inline uint4 get_global_id()
 {
-    return uint4( named_variable<uint1>("vAbsTid.x") % named_variable<uint1>("cb0[0].z"),
-                  named_variable<uint1>("vAbsTid.x") / named_variable<uint1>("cb0[0].z"),
-                  uint1(0), uint1(0) );
+    uint1 y = fast_div( named_variable<uint1>("vAbsTid.x"), 2 );
+
+    return uint4( named_variable<uint1>("vAbsTid.x") - y*named_variable<uint1>("cb0[0].z"), y, uint1(0), uint1(0) );
 }
 
 inline uint1 get_global_id( int i )
 {
     assert( i>=0 && i<2 );
-    if( i==0 ) return named_variable<uint1>("vAbsTid.x") % named_variable<uint1>("cb0[0].z");
-    return named_variable<uint1>("vAbsTid.x") / named_variable<uint1>("cb0[0].z");
+    uint1 y = fast_div( named_variable<uint1>("vAbsTid.x"), 2 );
+
+    if( i==0 ) return named_variable<uint1>("vAbsTid.x") - y*named_variable<uint1>("cb0[0].z");
+    return y;
 }
 
 
 inline uint4 get_num_groups()
 {
-    return uint4( named_variable<uint1>("cb0[0].z") / named_variable<uint1>("cb0[0].x"),
-                  named_variable<uint1>("cb0[0].w") / named_variable<uint1>("cb0[0].y"),
-                  uint1(0), uint1(0) );
+    return uint4( named_variable<uint1>("cb0[1].w"), named_variable<uint1>("cb0[2].w"), uint1(0), uint1(0) );
 }
 
 inline uint1 get_num_groups( int i )
 {
     assert( i>=0 && i<2 );
-    if( i==0 ) return named_variable<uint1>("cb0[0].z") / named_variable<uint1>("cb0[0].x");
-    return named_variable<uint1>("cb0[0].w") / named_variable<uint1>("cb0[0].y");
+    if( i==0 ) return named_variable<uint1>("cb0[1].w");
+    return named_variable<uint1>("cb0[2].w");
 }
 
 inline uint4 get_group_id()
 {
-    return uint4( named_variable<uint1>("vThreadGrpId.x") % get_num_groups(0),
-                  named_variable<uint1>("vThreadGrpId.x") / get_num_groups(0),
-                  uint1(0), uint1(0) );
+    uint1 y = fast_div( named_variable<uint1>("vThreadGrpId.x"), 3 );
+
+    return uint4( named_variable<uint1>("vThreadGrpId.x") - y*get_num_groups(0), y, uint1(0), uint1(0) );
 }
 
 inline uint1 get_group_id( int i )
 {
     assert( i>=0 && i<2 );
-    if( i==0 ) return named_variable<uint1>("vThreadGrpId.x") % get_num_groups(0);
-    return named_variable<uint1>("vThreadGrpId.x") / get_num_groups(0);
+    uint1 y = fast_div( named_variable<uint1>("vThreadGrpId.x"), 3 );
+
+    if( i==0 ) return named_variable<uint1>("vThreadGrpId.x") - y*get_num_groups(0);
+    return y;
 }
 
 #ifdef __CAL_HPP__
@@ -156,18 +197,42 @@ inline ::cal::NDRange make_flat_local( const ::cal::NDRange& _local )
     return local;
 }
 
-inline boost::array<boost::uint32_t,4> make_flat_cb0( const ::cal::NDRange& global, const ::cal::NDRange& local )
+inline boost::array<boost::array<boost::uint32_t,4>,cb0_size> make_flat_cb0( const ::cal::NDRange& global, const ::cal::NDRange& local )
 {
-    boost::array<boost::uint32_t,4>    result;
+    boost::array<boost::array<boost::uint32_t,4>,cb0_size>    result;
 
-    result[0] = local.width;
-    result[1] = local.height;
-    result[2] = local.width*((global.width+local.width-1)/local.width);
-    result[3] = local.height*((global.height+local.height-1)/local.height);
+    result[0][0] = local.width;
+    result[0][1] = local.height;
+    result[0][2] = local.width*((global.width+local.width-1)/local.width);
+    result[0][3] = local.height*((global.height+local.height-1)/local.height);
+
+    get_div_magic(result[0][0],result[1][0],result[1][1],result[1][2]);
+    result[1][3] = result[0][2]/result[0][0];
+    get_div_magic(result[0][2],result[2][0],result[2][1],result[2][2]);
+    result[2][3] = result[0][3]/result[0][1];
+    get_div_magic(result[1][3],result[3][0],result[3][1],result[3][2]);
+    result[3][3] = 0;
 
     return result;
 }
 
+//
+// kernel arguments first ... first+cb0_size-1 hold flat2d part of cb0 ( one cb0 entry each )
+// arguments have to be bound in increasing order, user data starts at cb0[cb0_size]
+//
+
+inline void bind_flat_cb0( ::cal::Kernel& kernel, int first )
+{
+    for(int i=0;i<cb0_size;i++) kernel.setArgBind(first+i,"cb0",16*i,16);
+}
+
+inline void set_flat_cb0( ::cal::Kernel& kernel, int first, const ::cal::NDRange& global, const ::cal::NDRange& local )
+{
+    boost::array<boost::array<boost::uint32_t,4>,cb0_size> cb0 = make_flat_cb0(global,local);
+
+    for(int i=0;i<cb0_size;i++) kernel.setArg(first+i,cb0[i]);
+}
+
 #endif
 
 } // flat2d
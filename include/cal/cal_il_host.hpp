@@ -0,0 +1,232 @@
+/*
+ * C++ to IL compiler/generator host interpreter of IL kernels
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_HOST_HPP__
+#define __CAL_IL_HOST_HPP__
+
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <stdexcept>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/exception_ptr.hpp>
+#include <cal/il/host/cal_il_host_image.hpp>
+#include <cal/il/host/cal_il_host_program.hpp>
+#include <cal/il/host/cal_il_host_interpreter.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+namespace detail {
+
+//
+// groups are taken in order by worker threads, every thread has its own executor
+//
+
+struct group_queue
+{
+    const host_program&     program;
+    const host_bindings&    memory;
+    host_group              group;
+    boost::mutex            mutex;
+    int                     next;
+    int                     total;
+    boost::exception_ptr    error;
+
+    group_queue( const host_program& _program, const host_bindings& _memory, const host_group& _group ) :
+        program(_program), memory(_memory), group(_group), next(0)
+    {
+        total = group.count[0]*group.count[1]*group.count[2];
+    }
+
+    bool pop( int& i )
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+
+        if( error || next>=total ) return false;
+        i = next++;
+        return true;
+    }
+
+    void fail()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        if( !error ) error = boost::current_exception();
+    }
+
+    void operator()()
+    {
+        try {
+            host_executor   executor(program,memory);
+            host_group      g = group;
+            int             i;
+
+            while( pop(i) ) {
+                g.id[0] = i%g.count[0];
+                g.id[1] = (i/g.count[0])%g.count[1];
+                g.id[2] = i/(g.count[0]*g.count[1]);
+                executor.run(g);
+            }
+        }
+        catch(...) {
+            fail();
+        }
+    }
+};
+
+//
+// memory names of kernel: "i0", "o0", "cb0", "uav0" and "g[]"
+//
+
+inline void bind_memory( host_bindings& memory, const std::string& name, const image& img )
+{
+    if( name=="g[]" ) memory.global = img;
+    else if( name.compare(0,3,"uav")==0 ) memory.uav[std::atoi(name.c_str()+3)] = img;
+    else if( name.compare(0,2,"cb")==0 ) memory.constant[std::atoi(name.c_str()+2)] = img;
+    else if( name[0]=='i' ) memory.input[std::atoi(name.c_str()+1)] = img;
+    else if( name[0]=='o' ) memory.output[std::atoi(name.c_str()+1)] = img;
+    else throw std::runtime_error("IL interpreter: unknown memory name \"" + name + "\"");
+}
+
+//
+// work-groups covering domain ( pixel tiles for pixel shader )
+//
+
+inline host_group make_group( const host_program& program, const ndrange& domain )
+{
+    host_group  group;
+    int         c;
+
+    group.domain[0] = domain.width;
+    group.domain[1] = domain.height;
+
+    if( program.type==HOST_PIXEL_SHADER ) {
+        if( domain.depth!=1 ) throw std::runtime_error("IL interpreter: pixel shader domain must be 2D");
+        group.count[0] = (domain.width+PIXEL_TILE-1)/PIXEL_TILE;
+        group.count[1] = domain.height;
+        group.count[2] = 1;
+    }
+    else {
+        const int size[3] = { domain.width, domain.height, domain.depth };
+
+        for(c=0;c<3;c++) {
+            if( size[c]%program.group[c] ) throw std::runtime_error("IL interpreter: domain is not divisible by group size");
+            group.count[c] = size[c]/program.group[c];
+        }
+    }
+
+    return group;
+}
+
+} // detail
+
+//
+// IL kernel executed on host CPU
+// it is meant for validation of generated kernels on machines without GPU
+//
+// memory is bound by names used in kernel: "i0" ( sample_resource, load_resource ), "o0" ( pixel shader outputs ),
+// "cb0" ( constant buffers ), "uav0" ( UAVs of any type ), "g[]" ( global buffer )
+// images are shared with caller, results can be read right after run
+//
+
+class kernel
+{
+protected:
+    boost::shared_ptr<detail::host_program> _program;
+    detail::host_bindings                   _memory;
+
+public:
+    kernel() {}
+    explicit kernel( const std::string& source ) { compile(source); }
+
+    void compile( const std::string& source )
+    {
+        _program.reset(new detail::host_program());
+        host::compile(source,*_program);
+    }
+
+    host_shader_type type() const
+    {
+        return _program->type;
+    }
+
+    // dcl_num_thread_per_group of compute shader
+    ndrange group_size() const
+    {
+        return ndrange(_program->group[0],_program->group[1],_program->group[2]);
+    }
+
+    void bind( const std::string& name, const image& img )
+    {
+        detail::bind_memory(_memory,name,img);
+    }
+
+    //
+    // pixel shader runs over domain of pixels
+    // compute shader runs over domain of work-items, domain must be divisible by group size
+    // threads==0 uses one thread per core, work-groups are the unit of work
+    // first exception thrown by a worker is rethrown
+    //
+
+    void run( const ndrange& domain, unsigned threads=0 )
+    {
+        detail::host_group  group = detail::make_group(*_program,domain);
+        boost::thread_group pool;
+
+        if( domain.size()<=0 ) return;
+
+        detail::group_queue queue(*_program,_memory,group);
+
+        if( threads==0 ) threads = boost::thread::hardware_concurrency();
+        if( threads==0 ) threads = 1;
+
+        for(unsigned k=0;k<threads && (int)k<queue.total;k++) pool.create_thread(boost::ref(queue));
+        pool.join_all();
+
+        if( queue.error ) boost::rethrow_exception(queue.error);
+    }
+};
+
+#if defined(__CAL_IL_H)
+//
+// kernel generated with Source ( call after Source::end, usually started with Source::begin_host )
+// header holds lines written before Source::emitHeader ( il_cs, dcl_num_thread_per_group, dcl_cb, ... )
+//
+
+inline kernel generated_kernel( const std::string& header )
+{
+    std::stringstream code;
+
+    code << header;
+    Source::emitHeader(code);
+    Source::emitCode(code);
+
+    return kernel(code.str());
+}
+#endif
+
+} // host
+} // il
+} // cal
+
+#endif
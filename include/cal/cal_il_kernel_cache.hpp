@@ -0,0 +1,268 @@
+/*
+ * C++ to IL compiler/generator kernel cache
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_KERNEL_CACHE_HPP__
+#define __CAL_IL_KERNEL_CACHE_HPP__
+
+#include <map>
+#include <list>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <boost/function.hpp>
+#include <boost/functional/hash.hpp>
+#include <cal/cal_il.hpp>
+#ifdef __CAL_THREADSAFE
+  #include <boost/thread/mutex.hpp>
+  #include <boost/thread/locks.hpp>
+#endif
+
+namespace cal {
+namespace il {
+
+//
+// generated IL memoized by generator name, parameters and device target
+// parameters can be any type with operator<< ( for boost::tuple include <boost/tuple/tuple_io.hpp> )
+// recently used kernels are kept in memory, optionally all kernels are stored in directory
+//
+// static KernelCache cache;
+// source = cache.get( "nbody", boost::make_tuple(num_threads,workitem_size,eps2), device,
+//                     boost::bind(create_nbody_kernel,boost::ref(device),num_threads,workitem_size,eps2) );
+//
+
+class KernelCache
+{
+public:
+    typedef boost::function<std::string ()>     generator_type;
+
+    struct options_t
+    {
+        std::size_t capacity;       // kernels kept in memory
+        std::string directory;      // existing directory for disk cache, empty disables it
+    };
+
+    struct stats_t
+    {
+        unsigned    hits;           // found in memory
+        unsigned    disk_hits;      // loaded from directory
+        unsigned    misses;         // generated
+    };
+
+public:
+    options_t opt;
+
+protected:
+    typedef std::list<std::pair<std::string,std::string> >      lru_list;   // key and IL, most recent first
+    typedef std::map<std::string,lru_list::iterator>            lru_map;
+
+protected:
+    lru_list    _lru;
+    lru_map     _index;
+    stats_t     _stats;
+#ifdef __CAL_THREADSAFE
+    boost::mutex _mutex;
+#endif
+
+protected:
+    template<class P>
+    static std::string make_key( const std::string& name, const P& params, int target )
+    {
+        std::ostringstream  key;
+
+        key << std::setprecision(17) << name << '|' << target << '|' << params;
+        return key.str();
+    }
+
+    std::string get_file_name( const std::string& key )
+    {
+        std::ostringstream  name;
+
+        name << opt.directory << "/" << std::hex << std::setw(2*sizeof(std::size_t)) << std::setfill('0') << boost::hash<std::string>()(key) << ".il";
+        return name.str();
+    }
+
+    bool find( const std::string& key, std::string& code )
+    {
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(_mutex);
+#endif
+        lru_map::iterator   i = _index.find(key);
+
+        if( i==_index.end() ) return false;
+
+        _lru.splice(_lru.begin(),_lru,i->second);
+        code = i->second->second;
+        _stats.hits++;
+        return true;
+    }
+
+    void insert( const std::string& key, const std::string& code, bool from_disk )
+    {
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(_mutex);
+#endif
+        if( from_disk ) _stats.disk_hits++;
+        else _stats.misses++;
+
+        if( _index.find(key)!=_index.end() || opt.capacity==0 ) return; // generated by other thread in the meantime
+
+        _lru.push_front(std::make_pair(key,code));
+        _index[key] = _lru.begin();
+
+        while( _lru.size()>opt.capacity ) {
+            _index.erase(_lru.back().first);
+            _lru.pop_back();
+        }
+    }
+
+    //
+    // file has "<key length> <code length>" line followed by key and code
+    //
+
+    bool load( const std::string& key, std::string& code )
+    {
+        if( opt.directory.empty() ) return false;
+
+        std::ifstream       input(get_file_name(key).c_str(), std::ios::in | std::ios::binary);
+        std::size_t         key_length,code_length;
+        std::string         file_key;
+
+        if( !(input >> key_length >> code_length) || input.get()!='\n' || key_length!=key.length() ) return false;
+
+        file_key.resize(key_length);
+        code.resize(code_length);
+        if( key_length>0 ) input.read(&file_key[0],key_length);
+        if( code_length>0 ) input.read(&code[0],code_length);
+
+        return input && file_key==key;
+    }
+
+    void store( const std::string& key, const std::string& code )
+    {
+        if( opt.directory.empty() ) return;
+
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(_mutex);
+#endif
+        std::string     name = get_file_name(key);
+        std::string     temp = name + ".tmp";
+        std::ofstream   output(temp.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        output << key.length() << " " << code.length() << "\n";
+        output.write(key.data(),key.length());
+        output.write(code.data(),code.length());
+        output.close();
+
+        // readers never see partially written file
+        if( output ) std::rename(temp.c_str(),name.c_str());
+        else std::remove(temp.c_str());
+    }
+
+    static int current_target()
+    {
+#if defined(__CAL_HPP__) || defined(__CAL_H__)
+        if( Source::info().available ) return Source::info().target;
+#endif
+        return -1;
+    }
+
+public:
+    KernelCache()
+    {
+        opt.capacity = 64;
+        clear();
+    }
+    virtual ~KernelCache() {}
+
+    //
+    // IL for generator with given parameters, generator runs only when kernel is not cached
+    //
+
+    template<class P>
+    std::string get( const std::string& name, const P& params, int target, const generator_type& generator )
+    {
+        std::string key = make_key(name,params,target);
+        std::string code;
+
+        if( find(key,code) ) return code;
+
+        if( load(key,code) ) {
+            insert(key,code,true);
+            return code;
+        }
+
+        code = generator();
+        insert(key,code,false);
+        store(key,code);
+
+        return code;
+    }
+
+    // target of device selected by last Source::begin
+    template<class P>
+    std::string get( const std::string& name, const P& params, const generator_type& generator )
+    {
+        return get(name,params,current_target(),generator);
+    }
+
+#if defined(__CAL_HPP__)
+    template<class P>
+    std::string get( const std::string& name, const P& params, const cal::Device& device, const generator_type& generator )
+    {
+        return get(name,params,(int)device.getInfo<CAL_DEVICE_TARGET>(),generator);
+    }
+#endif
+
+    void clear()
+    {
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(_mutex);
+#endif
+        _lru.clear();
+        _index.clear();
+        std::memset( &_stats, 0, sizeof(_stats) );
+    }
+
+    std::size_t size()
+    {
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(_mutex);
+#endif
+        return _lru.size();
+    }
+
+    stats_t stats()
+    {
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(_mutex);
+#endif
+        return _stats;
+    }
+};
+
+} // il
+} // cal
+
+#endif
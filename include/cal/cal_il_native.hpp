@@ -0,0 +1,352 @@
+/*
+ * C++ to IL compiler/generator native host execution of IL kernels
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_NATIVE_HPP__
+#define __CAL_IL_NATIVE_HPP__
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <boost/format.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <cal/cal_il_host.hpp>
+#include <cal/il/host/cal_il_host_translate.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+
+//
+// system compiler used to build translated kernels
+// defaults: compiler $CXX or "c++", cache directory $CALPP_NATIVE_CACHE, $TMPDIR or "/tmp"
+// flags keep IL float semantics ( no contraction of mul and add to fma )
+//
+
+struct native_options
+{
+    std::string compiler;
+    std::string flags;
+    std::string cache;
+
+    native_options() : flags("-O2 -ffp-contract=off -shared -fPIC")
+    {
+        const char* e;
+
+        compiler = (e=std::getenv("CXX")) && *e ? e : "c++";
+        if( (e=std::getenv("CALPP_NATIVE_CACHE")) && *e ) cache = e;
+        else cache = (e=std::getenv("TMPDIR")) && *e ? e : "/tmp";
+    }
+};
+
+namespace detail {
+
+// FNV-1a, stable between runs and builds
+inline boost::uint64_t native_hash( const std::string& s )
+{
+    boost::uint64_t h = 14695981039346656037ULL;
+
+    for(std::string::size_type i=0;i<s.length();i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+inline bool file_exists( const std::string& name )
+{
+    return access(name.c_str(),R_OK)==0;
+}
+
+class native_library
+{
+protected:
+    void*               handle;
+    native_run_function _run;
+
+    native_library( const native_library& );
+    native_library& operator=( const native_library& );
+
+public:
+    explicit native_library( const std::string& name ) : handle(NULL), _run(NULL)
+    {
+        native_abi_function abi;
+
+        handle = dlopen(name.c_str(),RTLD_NOW|RTLD_LOCAL);
+        if( !handle ) throw std::runtime_error(std::string("IL native: ") + dlerror());
+
+        abi  = (native_abi_function)dlsym(handle,"cal_il_native_abi");
+        _run = (native_run_function)dlsym(handle,"cal_il_native_run");
+        if( !abi || !_run || abi()!=NATIVE_ABI_VERSION ) {
+            dlclose(handle);
+            throw std::runtime_error("IL native: invalid kernel library " + name);
+        }
+    }
+
+    ~native_library()
+    {
+        dlclose(handle);
+    }
+
+    void run( const native_args& args, int first, int count ) const
+    {
+        _run(&args,first,count);
+    }
+};
+
+//
+// shared object of translated kernel, name is hash of C++ source and compiler command
+// library is built under temporary name and renamed, so processes can share cache directory
+//
+
+inline boost::shared_ptr<native_library> native_build( const std::string& code, const native_options& options )
+{
+    std::string     command = options.compiler + " " + options.flags;
+    std::string     base = str( boost::format("%s/calpp_native_%016x") % options.cache % native_hash(command + "\n" + code) );
+    std::string     library = base + ".so";
+
+    if( !file_exists(library) ) {
+        std::string     source = base + ".cpp";
+        std::string     log = base + ".log";
+        std::string     temporary = str( boost::format("%s.%i.tmp") % library % getpid() );
+        std::ofstream   out(source.c_str());
+
+        out << code;
+        out.close();
+        if( !out ) throw std::runtime_error("IL native: cannot write " + source);
+
+        command += " -o \"" + temporary + "\" \"" + source + "\" >\"" + log + "\" 2>&1";
+        if( std::system(command.c_str())!=0 ) {
+            std::ifstream       in(log.c_str());
+            std::stringstream   msg;
+
+            std::remove(temporary.c_str());
+            msg << "IL native: compilation failed ( " << source << " )\n" << in.rdbuf();
+            throw std::runtime_error(msg.str());
+        }
+        if( std::rename(temporary.c_str(),library.c_str())!=0 ) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("IL native: cannot create " + library);
+        }
+        std::remove(log.c_str());
+    }
+
+    return boost::shared_ptr<native_library>(new native_library(library));
+}
+
+//
+// groups are taken in chunks by worker threads
+//
+
+struct native_queue
+{
+    const native_library&   library;
+    const native_args&      args;
+    boost::mutex            mutex;
+    int                     next;
+    int                     total;
+    int                     chunk;
+
+    native_queue( const native_library& _library, const native_args& _args, int _total, int _chunk ) :
+        library(_library), args(_args), next(0), total(_total), chunk(_chunk) {}
+
+    bool pop( int& first, int& count )
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+
+        if( next>=total ) return false;
+        first = next;
+        count = std::min(chunk,total-next);
+        next += count;
+        return true;
+    }
+
+    void operator()()
+    {
+        int first,count;
+
+        while( pop(first,count) ) library.run(args,first,count);
+    }
+};
+
+} // detail
+
+//
+// IL kernel translated to C++ and compiled with system compiler ( see host_translator )
+// interface is the same as of host::kernel, results match the interpreter
+// kernels with LDS and fences are rejected, they need lock-step execution of host::kernel
+// requires POSIX dlopen and compiler accepting GCC options and builtins
+//
+
+class native_kernel
+{
+protected:
+    boost::shared_ptr<detail::host_program>     _program;
+    boost::shared_ptr<detail::native_library>   _library;
+    detail::host_bindings                       _memory;
+
+    static void set( detail::native_image& d, const image& img )
+    {
+        d.data       = const_cast<image&>(img).data();
+        d.width      = img.width();
+        d.height     = img.height();
+        d.components = img.components();
+    }
+
+    static void set( detail::native_image* d, int limit, const std::map<int,image>& m )
+    {
+        for(std::map<int,image>::const_iterator i=m.begin();i!=m.end();i++) {
+            if( i->first>=0 && i->first<limit && i->second.valid() ) set(d[i->first],i->second);
+        }
+    }
+
+    static void check( const detail::native_image* d, int limit, int id, const char* name )
+    {
+        if( id<0 || id>=limit || !d[id].data ) {
+            std::ostringstream s;
+            s << name << id;
+            detail::host_error("unbound memory",s.str());
+        }
+    }
+
+    // generated code does not check bindings
+    void arguments( detail::native_args& args ) const
+    {
+        const detail::host_program& p = *_program;
+        unsigned                    k;
+
+        std::memset(&args,0,sizeof(args));
+        if( _memory.global.valid() ) set(args.global,_memory.global);
+        set(args.input,detail::NATIVE_INPUTS,_memory.input);
+        set(args.output,detail::NATIVE_OUTPUTS,_memory.output);
+        set(args.constant,detail::NATIVE_CONSTANTS,_memory.constant);
+        set(args.uav,detail::NATIVE_UAVS,_memory.uav);
+
+        if( p.uses_global && !args.global.data ) detail::host_error("unbound memory","g[]");
+        for(std::map<int,detail::host_resource>::const_iterator i=p.resource.begin();i!=p.resource.end();i++) check(args.input,detail::NATIVE_INPUTS,i->first,"i");
+        for(std::map<int,detail::host_uav>::const_iterator i=p.uav.begin();i!=p.uav.end();i++) check(args.uav,detail::NATIVE_UAVS,i->first,"uav");
+        for(k=0;k<p.constant.size();k++) check(args.constant,detail::NATIVE_CONSTANTS,p.constant[k].source,"cb");
+        for(k=0;k<p.code.size();k++) {
+            for(int j=0;j<p.code[k].count;j++) {
+                if( p.code[k].operand[j].kind==detail::OPERAND_CONSTANT ) check(args.constant,detail::NATIVE_CONSTANTS,p.code[k].operand[j].size,"cb");
+            }
+        }
+        if( p.type==HOST_PIXEL_SHADER ) {
+            for(k=0;k<p.output.size();k++) check(args.output,detail::NATIVE_OUTPUTS,p.output[k].second,"o");
+        }
+    }
+
+public:
+    native_kernel() {}
+    explicit native_kernel( const std::string& source, const native_options& options=native_options() ) { compile(source,options); }
+
+    // translated source is compiled once, later runs load cached library
+    void compile( const std::string& source, const native_options& options=native_options() )
+    {
+        std::ostringstream code;
+
+        _program.reset(new detail::host_program());
+        host::compile(source,*_program);
+        translate(*_program,code);
+        _library = detail::native_build(code.str(),options);
+    }
+
+    host_shader_type type() const
+    {
+        return _program->type;
+    }
+
+    ndrange group_size() const
+    {
+        return ndrange(_program->group[0],_program->group[1],_program->group[2]);
+    }
+
+    void bind( const std::string& name, const image& img )
+    {
+        detail::bind_memory(_memory,name,img);
+    }
+
+    //
+    // domain rules are the same as of host::kernel::run
+    // threads==0 uses one thread per core, every thread takes several work-groups at once
+    //
+
+    void run( const ndrange& domain, unsigned threads=0 )
+    {
+        detail::host_group  group = detail::make_group(*_program,domain);
+        detail::native_args args;
+        boost::thread_group pool;
+        int                 total,chunk;
+
+        if( domain.size()<=0 ) return;
+
+        arguments(args);
+        for(int c=0;c<3;c++) args.count[c] = group.count[c];
+        args.domain[0] = group.domain[0];
+        args.domain[1] = group.domain[1];
+
+        if( threads==0 ) threads = boost::thread::hardware_concurrency();
+        if( threads==0 ) threads = 1;
+
+        total = group.count[0]*group.count[1]*group.count[2];
+        chunk = std::max(total/(int)(4*threads),1);
+
+        if( threads==1 ) {
+            _library->run(args,0,total);
+            return;
+        }
+
+        detail::native_queue queue(*_library,args,total,chunk);
+
+        for(unsigned k=0;k<threads && (int)k<total;k++) pool.create_thread(boost::ref(queue));
+        pool.join_all();
+    }
+};
+
+#if defined(__CAL_IL_H)
+//
+// kernel generated with Source, see host::generated_kernel
+//
+
+inline native_kernel generated_native_kernel( const std::string& header, const native_options& options=native_options() )
+{
+    std::stringstream code;
+
+    code << header;
+    Source::emitHeader(code);
+    Source::emitCode(code);
+
+    return native_kernel(code.str(),options);
+}
+#endif
+
+} // host
+} // il
+} // cal
+
+#endif
@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_EXPRESSION_ASSIGNABLE_H
 #define __CAL_IL_EXPRESSION_ASSIGNABLE_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
 
@@ -94,8 +94,7 @@ public:
 
     std::string resultCode() const
     {
-        int     idx = Source::code().getLiteral( _data.hex );
-        return detail::make_swizzle( (boost::format("l%i") % idx).str(), value_type::type_size );
+        return Source::code().getLiteral( _data.hex, value_type::type_size, sizeof(component_type)/sizeof(boost::uint32_t) );
     }
 
     component_type getValue() const { return _data.base[0]; }
@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_EXPRESSION_SWIZZLE_H
 #define __CAL_IL_EXPRESSION_SWIZZLE_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
 #include <cal/il/cal_il_swizzle_traits.hpp>
@@ -61,7 +61,7 @@ protected:
     {
         e.emitCode();
         _e.emitCode();
-        Source::code() << boost::format("mov %s,%s\n") % mask_output(resultCode()) % match_input_to_output(resultCode(),e.resultCode());
+        Source::code() << detail::il_format("mov %s,%s\n") % mask_output(resultCode()) % match_input_to_output(resultCode(),e.resultCode());
     }
 
 public:
@@ -129,12 +129,16 @@ class swizzable_expression : public assignable_expression<T,E>
 protected:
     using expression<E>::index;
 
+    // register name is built once, index changes only when variable becomes function argument
+    mutable std::string     _result_code;
+    mutable int             _result_index;
+
 public:
     using assignable_expression<T,E>::operator=;
 
 public:
-    swizzable_expression() : assignable_expression<T,E>() {}
-    swizzable_expression( const swizzable_expression& rhs ) : assignable_expression<T,E>(rhs) {}
+    swizzable_expression() : assignable_expression<T,E>(), _result_index(-1) {}
+    swizzable_expression( const swizzable_expression& rhs ) : assignable_expression<T,E>(rhs), _result_index(-1) {}
     ~swizzable_expression() {}
 
     std::string resultCode() const
@@ -143,7 +147,12 @@ public:
 
         int     idx = index+E::temp_reg_count;
 
-        return make_swizzle( (boost::format("r%i") % idx).str(), E::value_type::type_size );
+        if( idx!=_result_index ) {
+            _result_code = make_swizzle( make_register('r',idx), E::value_type::type_size );
+            _result_index = idx;
+        }
+
+        return _result_code;
     }
 
     swizzle<E,1,0,0,0> x() const
@@ -25,7 +25,7 @@
 
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 
 namespace cal {
 namespace il {
@@ -200,8 +200,8 @@ public:
 
     std::string resultCode() const
     {
-        if( _offset>0 ) return (boost::format("%s+%i") % _e.resultCode() % _offset).str();
-        else if( _offset<0 ) return (boost::format("%s-%i") % _e.resultCode() % (-_offset)).str();
+        if( _offset>0 ) return (detail::il_format("%s+%i") % _e.resultCode() % _offset).str();
+        else if( _offset<0 ) return (detail::il_format("%s-%i") % _e.resultCode() % (-_offset)).str();
         return _e.resultCode();
     }
 };
@@ -231,7 +231,7 @@ public:
 
     std::string resultCode() const
     {
-        return (boost::format("%i") % _offset).str();
+        return (detail::il_format("%i") % _offset).str();
     }
 };
 
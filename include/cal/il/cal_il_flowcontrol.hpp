@@ -23,6 +23,7 @@
 #ifndef _CAL_IL_FLOWCONTROL_H
 #define _CAL_IL_FLOWCONTROL_H
 
+#include <boost/static_assert.hpp>
 #include <cal/il/cal_il_flowcontrol_cmp.hpp>
 
 namespace cal {
@@ -178,6 +179,48 @@ inline void emit_endloop()
 
 } // detail
 
+enum CALILUnrollEnum
+{
+    CAL_UNROLL_REMAINDER = 0,   // iterations left after main loop are run by il_if ladder
+    CAL_UNROLL_DIVISIBLE = 1    // iteration count is multiple of N, no remainder code
+};
+
+//
+// loop from begin to end ( exclusive ) with body unrolled N times, body is called with loop index
+// main loop runs N copies of body per iteration, remainder has N-1 nested il_if blocks
+//
+// il_for_unrolled<4>( uint1(0), count, 1, boost::bind(accumulate,boost::ref(sum),_1) );
+//
+
+template<int N,class E1,class E2,class F>
+void il_for_unrolled( const detail::expression<E1>& begin, const detail::expression<E2>& end,
+                      const typename E1::value_type::component_type& step, F body, int flags=CAL_UNROLL_REMAINDER )
+{
+    typedef typename E1::value_type::component_type component_type;
+
+    BOOST_STATIC_ASSERT( N>0 );
+    variable<typename E1::value_type> i(begin());
+    int                               k;
+
+    if( flags&CAL_UNROLL_DIVISIBLE ) detail::emit_while( i<end() );
+    else detail::emit_while( i+component_type((N-1)*step)<end() );
+
+    for(k=0;k<N;k++) {
+        body(i);
+        i += step;
+    }
+    detail::emit_endloop();
+
+    if( flags&CAL_UNROLL_DIVISIBLE ) return;
+
+    for(k=1;k<N;k++) {
+        detail::emit_if( i<end() );
+        body(i);
+        if( k<N-1 ) i += step;
+    }
+    for(k=1;k<N;k++) detail::emit_endif();
+}
+
 #define il_if(V) ::cal::il::detail::emit_if(V);
 #define il_else  ::cal::il::detail::emit_else();
 #define il_endif ::cal::il::detail::emit_endif();
@@ -38,7 +38,7 @@ template<typename T,class E0,class E1,class E2,class S1,class S2>
 void emit_cmp_lt( T tt, const detail::expression<E0>& e0, const detail::expression<E1>& e1, const detail::expression<E2>& e2, S1, S2, bool neg )
 {
     e0().emitCode();    
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2>
@@ -46,14 +46,14 @@ void emit_cmp_lt( T tt, const detail::expression<E0>& e0, const detail::expressi
 {
     e1().emitCode();
     e2().emitCode();
-    Source::code() << boost::format(neg?T::relop_ge:T::relop_lt) % e1().resultCode() % e2().resultCode();
+    Source::code() << detail::il_format(neg?T::relop_ge:T::relop_lt) % e1().resultCode() % e2().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2,class S1,class S2>
 void emit_cmp_le( T tt, const detail::expression<E0>& e0, const detail::expression<E1>& e1, const detail::expression<E2>& e2, S1, S2, bool neg )
 {
     e0().emitCode();
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2>
@@ -61,14 +61,14 @@ void emit_cmp_le( T tt, const detail::expression<E0>& e0, const detail::expressi
 {
     e1().emitCode();
     e2().emitCode();
-    Source::code() << boost::format(neg?T::relop_gt:T::relop_le) % e1().resultCode() % e2().resultCode();
+    Source::code() << detail::il_format(neg?T::relop_gt:T::relop_le) % e1().resultCode() % e2().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2,class S1,class S2>
 void emit_cmp_ne( T tt, const detail::expression<E0>& e0, const detail::expression<E1>& e1, const detail::expression<E2>& e2, S1, S2, bool neg )
 {
     e0().emitCode();
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2>
@@ -76,14 +76,14 @@ void emit_cmp_ne( T tt, const detail::expression<E0>& e0, const detail::expressi
 {
     e1().emitCode();
     e2().emitCode();
-    Source::code() << boost::format(neg?T::relop_eq:T::relop_ne) % e1().resultCode() % e2().resultCode();
+    Source::code() << detail::il_format(neg?T::relop_eq:T::relop_ne) % e1().resultCode() % e2().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2,class S1,class S2>
 void emit_cmp_eq( T tt, const detail::expression<E0>& e0, const detail::expression<E1>& e1, const detail::expression<E2>& e2, S1, S2, bool neg )
 {
     e0().emitCode();
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2>
@@ -91,14 +91,14 @@ void emit_cmp_eq( T tt, const detail::expression<E0>& e0, const detail::expressi
 {
     e1().emitCode();
     e2().emitCode();
-    Source::code() << boost::format(neg?T::relop_ne:T::relop_eq) % e1().resultCode() % e2().resultCode();
+    Source::code() << detail::il_format(neg?T::relop_ne:T::relop_eq) % e1().resultCode() % e2().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2,class S1,class S2>
 void emit_cmp_ge( T tt, const detail::expression<E0>& e0, const detail::expression<E1>& e1, const detail::expression<E2>& e2, S1, S2, bool neg )
 {
     e0().emitCode();
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2>
@@ -106,14 +106,14 @@ void emit_cmp_ge( T tt, const detail::expression<E0>& e0, const detail::expressi
 {
     e1().emitCode();
     e2().emitCode();
-    Source::code() << boost::format(neg?T::relop_lt:T::relop_ge) % e1().resultCode() % e2().resultCode();
+    Source::code() << detail::il_format(neg?T::relop_lt:T::relop_ge) % e1().resultCode() % e2().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2,class S1,class S2>
 void emit_cmp_gt( T tt, const detail::expression<E0>& e0, const detail::expression<E1>& e1, const detail::expression<E2>& e2, S1, S2, bool neg )
 {
     e0().emitCode();
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e0().resultCode();
 }
 
 template<typename T,class E0,class E1,class E2>
@@ -121,7 +121,7 @@ void emit_cmp_gt( T tt, const detail::expression<E0>& e0, const detail::expressi
 {
     e1().emitCode();
     e2().emitCode();
-    Source::code() << boost::format(neg?T::relop_le:T::relop_gt) % e1().resultCode() % e2().resultCode();
+    Source::code() << detail::il_format(neg?T::relop_le:T::relop_gt) % e1().resultCode() % e2().resultCode();
 }
 
 //
@@ -172,21 +172,21 @@ template<typename T,class E>
 void emit_cmp( T tt, const detail::expression<E>& e, uint_type, bool neg )
 {
     e().emitCode();    
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e().resultCode();
 }
 
 template<typename T,class E>
 void emit_cmp( T tt, const detail::expression<E>& e, int_type, bool neg )
 {
     e().emitCode();        
-    Source::code() << boost::format(neg?T::logicalz:T::logicalnz) % e().resultCode();
+    Source::code() << detail::il_format(neg?T::logicalz:T::logicalnz) % e().resultCode();
 }
 
 template<typename T,class E>
 void emit_cmp( T tt, const detail::expression<E>& e,  float_type, bool neg )
 {
     e().emitCode();        
-    Source::code() << boost::format(neg?T::z:T::nz) % e().resultCode();
+    Source::code() << detail::il_format(neg?T::z:T::nz) % e().resultCode();
 }
 
 template<typename T,class E>
@@ -0,0 +1,205 @@
+/*
+ * C++ to IL compiler/generator text formatting
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_FORMAT_H
+#define __CAL_IL_FORMAT_H
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <ostream>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// integer to text without streams
+//
+
+inline void append_uint( std::string& out, unsigned long long v )
+{
+    char    buf[24];
+    int     p=sizeof(buf);
+
+    do {
+        buf[--p] = '0' + (char)(v%10);
+        v /= 10;
+    } while( v );
+
+    out.append(buf+p,sizeof(buf)-p);
+}
+
+inline void append_int( std::string& out, long long v )
+{
+    if( v<0 ) {
+        out += '-';
+        append_uint(out,0ull-(unsigned long long)v);
+    }
+    else append_uint(out,(unsigned long long)v);
+}
+
+inline void append_hex( std::string& out, unsigned long long v )
+{
+    char    buf[16];
+    int     p=sizeof(buf);
+
+    do {
+        buf[--p] = "0123456789abcdef"[v&15];
+        v >>= 4;
+    } while( v );
+
+    out.append(buf+p,sizeof(buf)-p);
+}
+
+//
+// register name like "r12" or "l3"
+//
+
+inline std::string make_register( char prefix, int index )
+{
+    std::string r(1,prefix);
+    append_int(r,index);
+    return r;
+}
+
+//
+// replacement for boost::format limited to what code generator uses
+// "%s" "%i" "%x" with arguments in order and "%1%" ... "%12%" with arguments by position
+// string arguments are kept by pointer so formatter must be used in single expression
+// ( "(il_format("mov %s,%s\n") % a % b).str()" or "Source::code() << il_format(...) % ..." )
+//
+
+class il_format
+{
+protected:
+    static const int max_args=12;
+
+    struct argument
+    {
+        const char*         str;
+        std::size_t         length;
+        long long           value;
+        bool                number;
+        std::string         text;       // arguments converted with stream
+    };
+
+protected:
+    const char*     _fmt;
+    argument        _arg[max_args];
+    int             _count;
+
+protected:
+    argument& next()
+    {
+        assert( _count<max_args );
+        return _arg[_count++];
+    }
+
+    void append_arg( std::string& out, int idx, char type ) const
+    {
+        assert( idx<_count ); // not enough arguments
+        const argument& a = _arg[idx];
+
+        if( !a.number ) out.append(a.str,a.length);
+        else if( type=='x' ) append_hex(out,(unsigned long long)a.value);
+        else append_int(out,a.value);
+    }
+
+public:
+    explicit il_format( const char* fmt ) : _fmt(fmt), _count(0) {}
+    explicit il_format( const std::string& fmt ) : _fmt(fmt.c_str()), _count(0) {}
+
+    il_format& operator%( const std::string& v )
+    {
+        argument& a = next();
+        a.str = v.data(); a.length = v.length(); a.number = false;
+        return *this;
+    }
+
+    il_format& operator%( const char* v )
+    {
+        argument& a = next();
+        a.str = v; a.length = std::strlen(v); a.number = false;
+        return *this;
+    }
+
+    il_format& operator%( int v )                   { argument& a = next(); a.value = v; a.number = true; return *this; }
+    il_format& operator%( unsigned v )              { argument& a = next(); a.value = v; a.number = true; return *this; }
+    il_format& operator%( long v )                  { argument& a = next(); a.value = v; a.number = true; return *this; }
+    il_format& operator%( unsigned long v )         { argument& a = next(); a.value = (long long)v; a.number = true; return *this; }
+    il_format& operator%( long long v )             { argument& a = next(); a.value = v; a.number = true; return *this; }
+    il_format& operator%( unsigned long long v )    { argument& a = next(); a.value = (long long)v; a.number = true; return *this; }
+
+    template<class T>
+    il_format& operator%( const T& v )
+    {
+        std::stringstream   str;
+        argument&           a = next();
+
+        str << v;
+        a.text = str.str();
+        a.str = a.text.data(); a.length = a.text.length(); a.number = false;
+        return *this;
+    }
+
+    void append_to( std::string& out ) const
+    {
+        const char* p = _fmt;
+        int         seq = 0;
+
+        while( *p ) {
+            const char* e = p;
+            while( *e && *e!='%' ) e++;
+            out.append(p,e-p);
+            if( !*e ) break;
+
+            int         idx = 0;
+            const char* d = e+1;
+            while( *d>='0' && *d<='9' ) idx = 10*idx + (*d++ - '0');
+
+            if( e[1]=='%' ) { out += '%'; p = e+2; }
+            else if( d>e+1 && *d=='%' ) { append_arg(out,idx-1,'i'); p = d+1; }
+            else if( e[1] ) { append_arg(out,seq++,e[1]); p = e+2; }
+            else p = e+1;
+        }
+    }
+
+    std::string str() const
+    {
+        std::string out;
+        append_to(out);
+        return out;
+    }
+};
+
+inline std::ostream& operator<<( std::ostream& _out, const il_format& f )
+{
+    return _out << f.str();
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -25,6 +25,10 @@
 
 #include <boost/type_traits.hpp>
 #include <boost/bind.hpp>
+#ifdef __CAL_THREADSAFE
+  #include <boost/thread/mutex.hpp>
+  #include <boost/thread/locks.hpp>
+#endif
 
 namespace cal {
 namespace il {
@@ -254,7 +258,7 @@ void func_emit_call( const std::string& name, T0& v0 )
     Source::func_info& func(Source::code().getFunc(name));
     
     Source::code() << func.pre_call(0,v0);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);    
 }
 
@@ -265,7 +269,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1 )
     
     Source::code() << func.pre_call(0,v0);
     Source::code() << func.pre_call(1,v1);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
 }
@@ -278,7 +282,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2 )
     Source::code() << func.pre_call(0,v0);
     Source::code() << func.pre_call(1,v1);
     Source::code() << func.pre_call(2,v2);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -293,7 +297,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3 )
     Source::code() << func.pre_call(1,v1);
     Source::code() << func.pre_call(2,v2);
     Source::code() << func.pre_call(3,v3);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -310,7 +314,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
     Source::code() << func.pre_call(2,v2);
     Source::code() << func.pre_call(3,v3);
     Source::code() << func.pre_call(4,v4);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -329,7 +333,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
     Source::code() << func.pre_call(3,v3);
     Source::code() << func.pre_call(4,v4);
     Source::code() << func.pre_call(5,v5);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -350,7 +354,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
     Source::code() << func.pre_call(4,v4);
     Source::code() << func.pre_call(5,v5);
     Source::code() << func.pre_call(6,v6);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -373,7 +377,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
     Source::code() << func.pre_call(5,v5);
     Source::code() << func.pre_call(6,v6);
     Source::code() << func.pre_call(7,v7);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -398,7 +402,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
     Source::code() << func.pre_call(6,v6);
     Source::code() << func.pre_call(7,v7);
     Source::code() << func.pre_call(8,v8);
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -425,7 +429,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
     Source::code() << func.pre_call(7,v7);
     Source::code() << func.pre_call(8,v8);
     Source::code() << func.pre_call(9,v9);    
-    Source::code() << boost::format("call %i\n") % func.fid;
+    Source::code() << detail::il_format("call %i\n") % func.fid;
     Source::code() << func.post_call(0,v0);
     Source::code() << func.post_call(1,v1);
     Source::code() << func.post_call(2,v2);
@@ -440,7 +444,7 @@ void func_emit_call( const std::string& name, T0& v0, T1& v1, T2& v2, T3& v3, T4
 
 inline std::string func_name( const std::string& file, int line, int id )
 {
-    return (boost::format("func:%s:%i:%i") % file % line % id).str();
+    return (detail::il_format("func:%s:%i:%i") % file % line % id).str();
 }
 
 template<typename T0>
@@ -528,28 +532,50 @@ inline void func_end()
     Source::code().endFunc();
 }
 
+inline void func_set_inline( const std::string& name, int policy )
+{
+    Source::code().getFunc(name).inline_policy = policy;
+}
+
 template<int N>
 class func_name_helper
 {
 protected:    
     static int counter;
+#ifdef __CAL_THREADSAFE
+    static boost::mutex counter_lock; // functions can be first reached by kernels generated in parallel
+#endif
 
 protected:    
     int id;
     
 public:    
-    func_name_helper() : id(counter++) {}
+    func_name_helper()
+    {
+#ifdef __CAL_THREADSAFE
+        boost::lock_guard<boost::mutex> lock(counter_lock);
+#endif
+        id = counter++;
+    }
     int operator()() const { return id; }
 };
 
 template<int N>
 int func_name_helper<N>::counter=0;
+#ifdef __CAL_THREADSAFE
+template<int N>
+boost::mutex func_name_helper<N>::counter_lock;
+#endif
 
 } // detail
     
 #define il_func(...) { static ::cal::il::detail::func_name_helper<0> __id; ::cal::il::detail::func_begin(::cal::il::detail::func_name(__FILE__, __LINE__, __id()), __VA_ARGS__); }
 #define il_endfunc { ::cal::il::detail::func_end(); }
 
+// function with CAL_INLINE_ALWAYS / CAL_INLINE_NEVER policy ( used when CAL_OPT_INLINE is enabled )
+#define il_func_inline(...) { static ::cal::il::detail::func_name_helper<0> __id; std::string __name = ::cal::il::detail::func_name(__FILE__, __LINE__, __id()); ::cal::il::detail::func_begin(__name, __VA_ARGS__); ::cal::il::detail::func_set_inline(__name, ::cal::il::CAL_INLINE_ALWAYS); }
+#define il_func_noinline(...) { static ::cal::il::detail::func_name_helper<0> __id; std::string __name = ::cal::il::detail::func_name(__FILE__, __LINE__, __id()); ::cal::il::detail::func_begin(__name, __VA_ARGS__); ::cal::il::detail::func_set_inline(__name, ::cal::il::CAL_INLINE_NEVER); }
+
 template<typename T>
 const detail::func_in_wrapper<T> _in( const variable<T>& v )
 {
@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_FUNCTORS_H
 #define __CAL_IL_FUNCTORS_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
 #include <cal/il/cal_il_functors_bitop.hpp>
@@ -51,7 +51,7 @@ struct cal_ternary_cmov_logical {
         BOOST_STATIC_ASSERT( assert_value::value );
         BOOST_STATIC_ASSERT( S1::type_size==1 || S1::type_size==S2::type_size );
 
-        return (boost::format("cmov_logical %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("cmov_logical %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -72,10 +72,10 @@ struct cal_ternary_select {
         BOOST_STATIC_ASSERT( S1::component_count==1 || S1::component_count==S2::component_count );
 
         if( S1::component_count==2 && S2::component_size==2 ) {
-            return (boost::format("cmov_logical %1%,%2%,%3%,%4%\n") % r % make_swizzle(s0,1,1,2,2) % s1 % s2).str();
+            return (detail::il_format("cmov_logical %1%,%2%,%3%,%4%\n") % r % make_swizzle(s0,1,1,2,2) % s1 % s2).str();
         }
 
-        return (boost::format("cmov_logical %1%,%2%,%3%,%4%\n") % mask_output(r) % s0 % s1 % s2).str();
+        return (detail::il_format("cmov_logical %1%,%2%,%3%,%4%\n") % mask_output(r) % s0 % s1 % s2).str();
     }
 };
 
@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_FUNCTORS_BITOP_H
 #define __CAL_IL_FUNCTORS_BITOP_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 
 namespace cal {
@@ -54,7 +54,7 @@ struct cal_unary_bitnot<int_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -66,7 +66,7 @@ struct cal_unary_bitnot<int2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -78,7 +78,7 @@ struct cal_unary_bitnot<int4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -90,7 +90,7 @@ struct cal_unary_bitnot<uint_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -102,7 +102,7 @@ struct cal_unary_bitnot<uint2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -114,7 +114,7 @@ struct cal_unary_bitnot<uint4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -126,7 +126,7 @@ struct cal_unary_bitnot<float_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -138,7 +138,7 @@ struct cal_unary_bitnot<float2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -150,7 +150,7 @@ struct cal_unary_bitnot<float4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -162,7 +162,7 @@ struct cal_unary_bitnot<double_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -174,7 +174,7 @@ struct cal_unary_bitnot<double2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inot %s,%s\n") % r % s0).str();
+        return (detail::il_format("inot %s,%s\n") % r % s0).str();
     }
 };
 
@@ -203,7 +203,7 @@ struct cal_binary_shl<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -215,7 +215,7 @@ struct cal_binary_shl<int2_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -227,8 +227,8 @@ struct cal_binary_shl<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -241,7 +241,7 @@ struct cal_binary_shl<int4_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -253,10 +253,10 @@ struct cal_binary_shl<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -269,7 +269,7 @@ struct cal_binary_shl<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -281,7 +281,7 @@ struct cal_binary_shl<int2_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -293,8 +293,8 @@ struct cal_binary_shl<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -306,7 +306,7 @@ struct cal_binary_shl<int4_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -318,10 +318,10 @@ struct cal_binary_shl<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -333,7 +333,7 @@ struct cal_binary_shl<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -345,7 +345,7 @@ struct cal_binary_shl<uint2_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -357,8 +357,8 @@ struct cal_binary_shl<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -370,7 +370,7 @@ struct cal_binary_shl<uint4_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -382,10 +382,10 @@ struct cal_binary_shl<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -397,7 +397,7 @@ struct cal_binary_shl<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -409,7 +409,7 @@ struct cal_binary_shl<uint2_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -421,8 +421,8 @@ struct cal_binary_shl<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -434,7 +434,7 @@ struct cal_binary_shl<uint4_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishl %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishl %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -446,10 +446,10 @@ struct cal_binary_shl<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ishl %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -478,7 +478,7 @@ struct cal_binary_shr<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -490,7 +490,7 @@ struct cal_binary_shr<int2_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -502,8 +502,8 @@ struct cal_binary_shr<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -515,7 +515,7 @@ struct cal_binary_shr<int4_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -527,10 +527,10 @@ struct cal_binary_shr<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -542,7 +542,7 @@ struct cal_binary_shr<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -554,7 +554,7 @@ struct cal_binary_shr<int2_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -566,8 +566,8 @@ struct cal_binary_shr<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -579,7 +579,7 @@ struct cal_binary_shr<int4_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ishr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ishr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -591,10 +591,10 @@ struct cal_binary_shr<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ishr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -606,7 +606,7 @@ struct cal_binary_shr<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ushr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ushr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -618,7 +618,7 @@ struct cal_binary_shr<uint2_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ushr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ushr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -630,8 +630,8 @@ struct cal_binary_shr<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -643,7 +643,7 @@ struct cal_binary_shr<uint4_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ushr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ushr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -655,10 +655,10 @@ struct cal_binary_shr<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -670,7 +670,7 @@ struct cal_binary_shr<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ushr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ushr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -682,7 +682,7 @@ struct cal_binary_shr<uint2_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ushr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ushr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -694,8 +694,8 @@ struct cal_binary_shr<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
+        return  (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str();
     }
 };
 
@@ -707,7 +707,7 @@ struct cal_binary_shr<uint4_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ushr %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ushr %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -719,10 +719,10 @@ struct cal_binary_shr<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return  (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
-                (boost::format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
+        return  (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,0,0,0) % make_swizzle(s1,1,0,0,0) ).str() + 
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,0,0,0) % make_swizzle(s1,2,0,0,0) ).str() +
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,3,0,0,0)) % make_swizzle(s0,3,0,0,0) % make_swizzle(s1,3,0,0,0) ).str() +
+                (detail::il_format("ushr %s,%s,%s\n") % mask_output(make_swizzle(r,4,0,0,0)) % make_swizzle(s0,4,0,0,0) % make_swizzle(s1,4,0,0,0) ).str();
     }
 };
 
@@ -751,7 +751,7 @@ struct cal_binary_bitor<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -763,7 +763,7 @@ struct cal_binary_bitor<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -775,7 +775,7 @@ struct cal_binary_bitor<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -787,7 +787,7 @@ struct cal_binary_bitor<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -799,7 +799,7 @@ struct cal_binary_bitor<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -811,7 +811,7 @@ struct cal_binary_bitor<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -823,7 +823,7 @@ struct cal_binary_bitor<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -835,7 +835,7 @@ struct cal_binary_bitor<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -847,7 +847,7 @@ struct cal_binary_bitor<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -859,7 +859,7 @@ struct cal_binary_bitor<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -871,7 +871,7 @@ struct cal_binary_bitor<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -883,7 +883,7 @@ struct cal_binary_bitor<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -895,7 +895,7 @@ struct cal_binary_bitor<float_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -907,7 +907,7 @@ struct cal_binary_bitor<float_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -919,7 +919,7 @@ struct cal_binary_bitor<float2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -931,7 +931,7 @@ struct cal_binary_bitor<float2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -943,7 +943,7 @@ struct cal_binary_bitor<float4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -955,7 +955,7 @@ struct cal_binary_bitor<float4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -967,7 +967,7 @@ struct cal_binary_bitor<double_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -979,7 +979,7 @@ struct cal_binary_bitor<double_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -991,7 +991,7 @@ struct cal_binary_bitor<double2_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %1%,%2%,%3%\n") % r % s0 % s1).str();
     }
 };
 
@@ -1003,7 +1003,7 @@ struct cal_binary_bitor<double2_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ior %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("ior %1%,%2%,%3%\n") % r % s0 % s1).str();
     }
 };
 
@@ -1032,7 +1032,7 @@ struct cal_binary_bitxor<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1044,7 +1044,7 @@ struct cal_binary_bitxor<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1056,7 +1056,7 @@ struct cal_binary_bitxor<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1068,7 +1068,7 @@ struct cal_binary_bitxor<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1080,7 +1080,7 @@ struct cal_binary_bitxor<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1092,7 +1092,7 @@ struct cal_binary_bitxor<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1104,7 +1104,7 @@ struct cal_binary_bitxor<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1116,7 +1116,7 @@ struct cal_binary_bitxor<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1128,7 +1128,7 @@ struct cal_binary_bitxor<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1140,7 +1140,7 @@ struct cal_binary_bitxor<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1152,7 +1152,7 @@ struct cal_binary_bitxor<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1164,7 +1164,7 @@ struct cal_binary_bitxor<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1176,7 +1176,7 @@ struct cal_binary_bitxor<float_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1188,7 +1188,7 @@ struct cal_binary_bitxor<float_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1200,7 +1200,7 @@ struct cal_binary_bitxor<float2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1212,7 +1212,7 @@ struct cal_binary_bitxor<float2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1224,7 +1224,7 @@ struct cal_binary_bitxor<float4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1236,7 +1236,7 @@ struct cal_binary_bitxor<float4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1248,7 +1248,7 @@ struct cal_binary_bitxor<double_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1260,7 +1260,7 @@ struct cal_binary_bitxor<double_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1272,7 +1272,7 @@ struct cal_binary_bitxor<double2_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %1%,%2%,%3%\n") % r % s0 % s1).str();
     }
 };
 
@@ -1284,7 +1284,7 @@ struct cal_binary_bitxor<double2_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ixor %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("ixor %1%,%2%,%3%\n") % r % s0 % s1).str();
     }
 };
 
@@ -1314,7 +1314,7 @@ struct cal_binary_bitand<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1326,7 +1326,7 @@ struct cal_binary_bitand<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1338,7 +1338,7 @@ struct cal_binary_bitand<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1350,7 +1350,7 @@ struct cal_binary_bitand<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1362,7 +1362,7 @@ struct cal_binary_bitand<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1374,7 +1374,7 @@ struct cal_binary_bitand<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1386,7 +1386,7 @@ struct cal_binary_bitand<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1398,7 +1398,7 @@ struct cal_binary_bitand<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1410,7 +1410,7 @@ struct cal_binary_bitand<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1422,7 +1422,7 @@ struct cal_binary_bitand<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1434,7 +1434,7 @@ struct cal_binary_bitand<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1446,7 +1446,7 @@ struct cal_binary_bitand<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1458,7 +1458,7 @@ struct cal_binary_bitand<float_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1470,7 +1470,7 @@ struct cal_binary_bitand<float_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1482,7 +1482,7 @@ struct cal_binary_bitand<float2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1494,7 +1494,7 @@ struct cal_binary_bitand<float2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1506,7 +1506,7 @@ struct cal_binary_bitand<float4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1518,7 +1518,7 @@ struct cal_binary_bitand<float4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1530,7 +1530,7 @@ struct cal_binary_bitand<double_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1542,7 +1542,7 @@ struct cal_binary_bitand<double_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -1554,7 +1554,7 @@ struct cal_binary_bitand<double2_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %1%,%2%,%3%\n") % r % s0 % s1).str();
     }
 };
 
@@ -1566,7 +1566,7 @@ struct cal_binary_bitand<double2_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iand %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("iand %1%,%2%,%3%\n") % r % s0 % s1).str();
     }
 };
 
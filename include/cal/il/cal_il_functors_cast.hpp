@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_FUNCTORS_CAST_H
 #define __CAL_IL_FUNCTORS_CAST_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 
 namespace cal {
@@ -54,7 +54,7 @@ struct cal_unary_cast<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -66,7 +66,7 @@ struct cal_unary_cast<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -78,7 +78,7 @@ struct cal_unary_cast<int_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ftoi %s,%s\n") % r % s0).str();
+        return (detail::il_format("ftoi %s,%s\n") % r % s0).str();
     }
 };
 
@@ -90,7 +90,7 @@ struct cal_unary_cast<int_type,double_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("d2f r%3%.x, %2%\n"
+        return (detail::il_format("d2f r%3%.x, %2%\n"
                               "ftoi %1%,r%3%.x\n") % r % s0 % t0).str();
     }
 };
@@ -103,7 +103,7 @@ struct cal_unary_cast<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -115,7 +115,7 @@ struct cal_unary_cast<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -127,7 +127,7 @@ struct cal_unary_cast<int2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ftoi %s,%s\n") % r % s0).str();
+        return (detail::il_format("ftoi %s,%s\n") % r % s0).str();
     }
 };
 
@@ -139,7 +139,7 @@ struct cal_unary_cast<int2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("d2f r%4%.x___, %2%\n"
+        return (detail::il_format("d2f r%4%.x___, %2%\n"
                               "d2f r%4%._y__, %3%\n"
                               "ftoi %1%,r%4%.xy\n") % r % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0) % t0).str();
     }
@@ -153,7 +153,7 @@ struct cal_unary_cast<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -165,7 +165,7 @@ struct cal_unary_cast<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -177,7 +177,7 @@ struct cal_unary_cast<int4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ftoi %s,%s\n") % r % s0).str();
+        return (detail::il_format("ftoi %s,%s\n") % r % s0).str();
     }
 };
 
@@ -189,7 +189,7 @@ struct cal_unary_cast<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -201,7 +201,7 @@ struct cal_unary_cast<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -213,7 +213,7 @@ struct cal_unary_cast<uint_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ftou %s,%s\n") % r % s0).str();
+        return (detail::il_format("ftou %s,%s\n") % r % s0).str();
     }
 };
 
@@ -225,7 +225,7 @@ struct cal_unary_cast<uint_type,double_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("d2f r%3%.x, %2%\n"
+        return (detail::il_format("d2f r%3%.x, %2%\n"
                               "ftou %1%,r%3%.x\n") % r % s0 % t0).str();
     }
 };
@@ -238,7 +238,7 @@ struct cal_unary_cast<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -250,7 +250,7 @@ struct cal_unary_cast<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -262,7 +262,7 @@ struct cal_unary_cast<uint2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ftou %s,%s\n") % r % s0).str();
+        return (detail::il_format("ftou %s,%s\n") % r % s0).str();
     }
 };
 
@@ -274,7 +274,7 @@ struct cal_unary_cast<uint2_type,double2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("d2f r%4%.x___, %2%\n"
+        return (detail::il_format("d2f r%4%.x___, %2%\n"
                               "d2f r%4%._y__, %3%\n"
                               "ftou %1%,r%4%.xy\n") % r % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0) % t0).str();
     }
@@ -288,7 +288,7 @@ struct cal_unary_cast<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -300,7 +300,7 @@ struct cal_unary_cast<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -312,7 +312,7 @@ struct cal_unary_cast<uint4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ftou %s,%s\n") % r % s0).str();
+        return (detail::il_format("ftou %s,%s\n") % r % s0).str();
     }
 };
 
@@ -324,7 +324,7 @@ struct cal_unary_cast<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -336,7 +336,7 @@ struct cal_unary_cast<float_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("itof %s,%s\n") % r % s0).str();
+        return (detail::il_format("itof %s,%s\n") % r % s0).str();
     }
 };
 
@@ -348,7 +348,7 @@ struct cal_unary_cast<float_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("utof %s,%s\n") % r % s0).str();
+        return (detail::il_format("utof %s,%s\n") % r % s0).str();
     }
 };
 
@@ -360,7 +360,7 @@ struct cal_unary_cast<float_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("d2f %s,%s\n") % r % s0).str();
+        return (detail::il_format("d2f %s,%s\n") % r % s0).str();
     }
 };
 
@@ -372,7 +372,7 @@ struct cal_unary_cast<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -384,7 +384,7 @@ struct cal_unary_cast<float2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("itof %s,%s\n") % r % s0).str();
+        return (detail::il_format("itof %s,%s\n") % r % s0).str();
     }
 };
 
@@ -396,7 +396,7 @@ struct cal_unary_cast<float2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("utof %s,%s\n") % r % s0).str();
+        return (detail::il_format("utof %s,%s\n") % r % s0).str();
     }
 };
 
@@ -408,7 +408,7 @@ struct cal_unary_cast<float2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("d2f r%4%.x___, %2%\n"
+        return (detail::il_format("d2f r%4%.x___, %2%\n"
                               "d2f r%4%._y__, %3%\n"
                               "mov %1%,r%4%.xy\n") % r % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0) % t0).str();
     }
@@ -422,7 +422,7 @@ struct cal_unary_cast<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -434,7 +434,7 @@ struct cal_unary_cast<float4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("itof %s,%s\n") % r % s0).str();
+        return (detail::il_format("itof %s,%s\n") % r % s0).str();
     }
 };
 
@@ -446,7 +446,7 @@ struct cal_unary_cast<float4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("utof %s,%s\n") % r % s0).str();
+        return (detail::il_format("utof %s,%s\n") % r % s0).str();
     }
 };
 
@@ -458,7 +458,7 @@ struct cal_unary_cast<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -470,7 +470,7 @@ struct cal_unary_cast<double_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("itof r%3%.x,%2%\n"
+        return (detail::il_format("itof r%3%.x,%2%\n"
                               "f2d %1%,r%3%.x\n") % r % s0 % t0).str();
     }
 };
@@ -483,7 +483,7 @@ struct cal_unary_cast<double_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("utof r%3%.x,%2%\n"
+        return (detail::il_format("utof r%3%.x,%2%\n"
                               "f2d %1%,r%3%.x\n") % r % s0 % t0).str();
     }
 };
@@ -496,7 +496,7 @@ struct cal_unary_cast<double_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("f2d %s,%s\n") % r % s0).str();
+        return (detail::il_format("f2d %s,%s\n") % r % s0).str();
     }
 };
 
@@ -508,7 +508,7 @@ struct cal_unary_cast<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -520,7 +520,7 @@ struct cal_unary_cast<double2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("itof r%4%.xy,%3%\n"
+        return (detail::il_format("itof r%4%.xy,%3%\n"
                               "f2d %1%,r%4%.x\n"
                               "f2d %2%,r%4%.y\n") % make_swizzle(r,1,2,0,0) % make_swizzle(r,3,4,0,0) % s0 % t0).str();
     }
@@ -534,7 +534,7 @@ struct cal_unary_cast<double2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("utof r%4%.xy,%3%\n"
+        return (detail::il_format("utof r%4%.xy,%3%\n"
                               "f2d %1%,r%4%.x\n"
                               "f2d %2%,r%4%.y\n") % make_swizzle(r,1,2,0,0) % make_swizzle(r,3,4,0,0) % s0 % t0).str();
     }
@@ -548,7 +548,7 @@ struct cal_unary_cast<double2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov r%4%.xy,%3%\n"
+        return (detail::il_format("mov r%4%.xy,%3%\n"
                               "f2d %1%,r%4%.x\n"
                               "f2d %2%,r%4%.y\n") % make_swizzle(r,1,2,0,0) % make_swizzle(r,3,4,0,0) % s0 % t0).str();
     }
@@ -578,7 +578,7 @@ struct cal_unary_bitcast<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -590,7 +590,7 @@ struct cal_unary_bitcast<int_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -602,7 +602,7 @@ struct cal_unary_bitcast<int_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -614,7 +614,7 @@ struct cal_unary_bitcast<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -626,7 +626,7 @@ struct cal_unary_bitcast<int2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -638,7 +638,7 @@ struct cal_unary_bitcast<int2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -650,7 +650,7 @@ struct cal_unary_bitcast<int2_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -662,7 +662,7 @@ struct cal_unary_bitcast<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -674,7 +674,7 @@ struct cal_unary_bitcast<int4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -686,7 +686,7 @@ struct cal_unary_bitcast<int4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -698,7 +698,7 @@ struct cal_unary_bitcast<int4_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -710,7 +710,7 @@ struct cal_unary_bitcast<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -722,7 +722,7 @@ struct cal_unary_bitcast<uint_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -734,7 +734,7 @@ struct cal_unary_bitcast<uint_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -746,7 +746,7 @@ struct cal_unary_bitcast<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -758,7 +758,7 @@ struct cal_unary_bitcast<uint2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -770,7 +770,7 @@ struct cal_unary_bitcast<uint2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -782,7 +782,7 @@ struct cal_unary_bitcast<uint2_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -794,7 +794,7 @@ struct cal_unary_bitcast<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -806,7 +806,7 @@ struct cal_unary_bitcast<uint4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -818,7 +818,7 @@ struct cal_unary_bitcast<uint4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -830,7 +830,7 @@ struct cal_unary_bitcast<uint4_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -842,7 +842,7 @@ struct cal_unary_bitcast<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -854,7 +854,7 @@ struct cal_unary_bitcast<float_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -866,7 +866,7 @@ struct cal_unary_bitcast<float_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -878,7 +878,7 @@ struct cal_unary_bitcast<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -890,7 +890,7 @@ struct cal_unary_bitcast<float2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -902,7 +902,7 @@ struct cal_unary_bitcast<float2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -914,7 +914,7 @@ struct cal_unary_bitcast<float2_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -926,7 +926,7 @@ struct cal_unary_bitcast<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -938,7 +938,7 @@ struct cal_unary_bitcast<float4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -950,7 +950,7 @@ struct cal_unary_bitcast<float4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -962,7 +962,7 @@ struct cal_unary_bitcast<float4_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -974,7 +974,7 @@ struct cal_unary_bitcast<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -986,7 +986,7 @@ struct cal_unary_bitcast<double_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -998,7 +998,7 @@ struct cal_unary_bitcast<double_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -1010,7 +1010,7 @@ struct cal_unary_bitcast<double_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -1022,7 +1022,7 @@ struct cal_unary_bitcast<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -1034,7 +1034,7 @@ struct cal_unary_bitcast<double2_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -1046,7 +1046,7 @@ struct cal_unary_bitcast<double2_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -1058,7 +1058,7 @@ struct cal_unary_bitcast<double2_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s\n") % r % s0).str();
     }
 };
 
@@ -1087,7 +1087,7 @@ struct cal_binary_cast<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.x,%2%\n"
+        return (detail::il_format("mov r%4%.x,%2%\n"
                               "mov r%4%._y__,%3%\n"
                               "mov %1%,r%4%.xy\n") % r % s0 % make_swizzle(s1,1,1,1,1) % t0).str();
     }
@@ -1101,7 +1101,7 @@ struct cal_binary_cast<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.xy,%2%\n"
+        return (detail::il_format("mov r%4%.xy,%2%\n"
                               "mov r%4%.__zw,%3%\n"
                               "mov %1%,r%4%\n") % r % s0 % make_swizzle(s1,1,2,1,2) % t0).str();
     }
@@ -1115,7 +1115,7 @@ struct cal_binary_cast<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.x,%2%\n"
+        return (detail::il_format("mov r%4%.x,%2%\n"
                               "mov r%4%._y__,%3%\n"
                               "mov %1%,r%4%.xy\n") % r % s0 % make_swizzle(s1,1,1,1,1) % t0).str();
     }
@@ -1129,7 +1129,7 @@ struct cal_binary_cast<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.xy,%2%\n"
+        return (detail::il_format("mov r%4%.xy,%2%\n"
                               "mov r%4%.__zw,%3%\n"
                               "mov %1%,r%4%\n") % r % s0 % make_swizzle(s1,1,2,1,2) % t0).str();
     }
@@ -1143,7 +1143,7 @@ struct cal_binary_cast<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.x,%2%\n"
+        return (detail::il_format("mov r%4%.x,%2%\n"
                               "mov r%4%._y__,%3%\n"
                               "mov %1%,r%4%.xy\n") % r % s0 % make_swizzle(s1,1,1,1,1) % t0).str();
     }
@@ -1157,7 +1157,7 @@ struct cal_binary_cast<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.xy,%2%\n"
+        return (detail::il_format("mov r%4%.xy,%2%\n"
                               "mov r%4%.__zw,%3%\n"
                               "mov %1%,r%4%\n") % r % s0 % make_swizzle(s1,1,2,1,2) % t0).str();
     }
@@ -1171,7 +1171,7 @@ struct cal_binary_cast<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mov r%4%.xy,%2%\n"
+        return (detail::il_format("mov r%4%.xy,%2%\n"
                               "mov r%4%.__zw,%3%\n"
                               "mov %1%,r%4%\n") % r % s0 % make_swizzle(s1,1,2,1,2) % t0).str();
     }
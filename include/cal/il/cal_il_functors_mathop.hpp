@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_FUNCTORS_MATHOP_H
 #define __CAL_IL_FUNCTORS_MATHOP_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 
 namespace cal {
@@ -54,7 +54,7 @@ struct cal_unary_neg<int_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inegate %s,%s\n") % r % s0).str();
+        return (detail::il_format("inegate %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -66,7 +66,7 @@ struct cal_unary_neg<int2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inegate %s,%s\n") % r % s0).str();
+        return (detail::il_format("inegate %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -78,7 +78,7 @@ struct cal_unary_neg<int4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("inegate %s,%s\n") % r % s0).str();
+        return (detail::il_format("inegate %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -90,7 +90,7 @@ struct cal_unary_neg<float_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s_neg(x)\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s_neg(x)\n") % r % s0).str();
     }    
 };
 
@@ -102,7 +102,7 @@ struct cal_unary_neg<float2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s_neg(xy)\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s_neg(xy)\n") % r % s0).str();
     }    
 };
 
@@ -114,7 +114,7 @@ struct cal_unary_neg<float4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s_neg(xyzw)\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s_neg(xyzw)\n") % r % s0).str();
     }    
 };
 
@@ -126,7 +126,7 @@ struct cal_unary_neg<double_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s_neg(y)\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s_neg(y)\n") % r % s0).str();
     }    
 };
 
@@ -138,7 +138,7 @@ struct cal_unary_neg<double2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %s,%s_neg(yw)\n") % r % s0).str();
+        return (detail::il_format("mov %s,%s_neg(yw)\n") % r % s0).str();
     }
 };
 
@@ -167,7 +167,7 @@ struct cal_binary_add<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -179,7 +179,7 @@ struct cal_binary_add<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -191,7 +191,7 @@ struct cal_binary_add<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -203,7 +203,7 @@ struct cal_binary_add<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -215,7 +215,7 @@ struct cal_binary_add<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -227,7 +227,7 @@ struct cal_binary_add<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("iadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("iadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -239,7 +239,7 @@ struct cal_binary_add<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("add %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("add %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -251,7 +251,7 @@ struct cal_binary_add<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("add %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("add %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -263,7 +263,7 @@ struct cal_binary_add<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("add %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("add %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -275,7 +275,7 @@ struct cal_binary_add<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dadd %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("dadd %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -287,7 +287,7 @@ struct cal_binary_add<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dadd %1%,%3%,%5%\n"
+        return (detail::il_format("dadd %1%,%3%,%5%\n"
                               "dadd %2%,%4%,%6%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                     % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                     % make_swizzle(s1,1,2,0,0) % make_swizzle(s1,3,4,0,0)).str();
@@ -319,7 +319,7 @@ struct cal_binary_sub<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("inegate r%4%.x,%3%\n"
+        return (detail::il_format("inegate r%4%.x,%3%\n"
                               "iadd %1%,%2%,r%4%.x\n"
                              ) % r % s0 % s1 % t0).str();
     }
@@ -333,7 +333,7 @@ struct cal_binary_sub<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("inegate r%4%.xy,%3%\n"
+        return (detail::il_format("inegate r%4%.xy,%3%\n"
                               "iadd %1%,%2%,r%4%.xy\n"
                              ) % r % s0 % s1 % t0).str();        
     }
@@ -347,7 +347,7 @@ struct cal_binary_sub<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("inegate r%4%,%3%\n"
+        return (detail::il_format("inegate r%4%,%3%\n"
                               "iadd %1%,%2%,r%4%\n"
                              ) % r % s0 % s1 % t0).str();                
     }
@@ -361,7 +361,7 @@ struct cal_binary_sub<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("inegate r%4%.x,%3%\n"
+        return (detail::il_format("inegate r%4%.x,%3%\n"
                               "iadd %1%,%2%,r%4%.x\n"
                              ) % r % s0 % s1 % t0).str();
     }
@@ -375,7 +375,7 @@ struct cal_binary_sub<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("inegate r%4%.xy,%3%\n"
+        return (detail::il_format("inegate r%4%.xy,%3%\n"
                               "iadd %1%,%2%,r%4%.xy\n"
                              ) % r % s0 % s1 % t0).str();        
     }
@@ -389,7 +389,7 @@ struct cal_binary_sub<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("inegate r%4%,%3%\n"
+        return (detail::il_format("inegate r%4%,%3%\n"
                               "iadd %1%,%2%,r%4%\n"
                              ) % r % s0 % s1 % t0).str();                
     }
@@ -403,7 +403,7 @@ struct cal_binary_sub<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("sub %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("sub %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -415,7 +415,7 @@ struct cal_binary_sub<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("sub %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("sub %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -427,7 +427,7 @@ struct cal_binary_sub<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("sub %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("sub %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -439,7 +439,7 @@ struct cal_binary_sub<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dadd %s,%s,%s_neg(y)\n") % r % s0 % s1).str();
+        return (detail::il_format("dadd %s,%s,%s_neg(y)\n") % r % s0 % s1).str();
     }
 };
 
@@ -451,7 +451,7 @@ struct cal_binary_sub<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dadd %1%,%3%,%5%_neg(y)\n"
+        return (detail::il_format("dadd %1%,%3%,%5%_neg(y)\n"
                               "dadd %2%,%4%,%6%_neg(y)\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                            % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                            % make_swizzle(s1,1,2,0,0) % make_swizzle(s1,3,4,0,0)).str();
@@ -483,7 +483,7 @@ struct cal_binary_mul<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("imul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("imul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -495,7 +495,7 @@ struct cal_binary_mul<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("imul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("imul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -507,7 +507,7 @@ struct cal_binary_mul<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("imul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("imul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -519,7 +519,7 @@ struct cal_binary_mul<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("umul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("umul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -531,7 +531,7 @@ struct cal_binary_mul<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("umul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("umul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -543,7 +543,7 @@ struct cal_binary_mul<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("umul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("umul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -556,7 +556,7 @@ struct cal_binary_mul<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("mul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -568,7 +568,7 @@ struct cal_binary_mul<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("mul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -580,7 +580,7 @@ struct cal_binary_mul<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("mul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -592,7 +592,7 @@ struct cal_binary_mul<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dmul %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("dmul %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -604,13 +604,102 @@ struct cal_binary_mul<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dmul %1%,%3%,%5%\n"
+        return (detail::il_format("dmul %1%,%3%,%5%\n"
                               "dmul %2%,%4%,%6%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                     % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                     % make_swizzle(s1,1,2,0,0) % make_swizzle(s1,3,4,0,0)).str();
     }
 };
 
+//
+// mul high ( upper 32 bits of product )
+//
+
+template<class S1,class S2>
+struct cal_binary_mul_high
+{
+    typedef invalid_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        BOOST_STATIC_ASSERT(sizeof(S1) != sizeof(S1));
+        return std::string();
+    }    
+};
+
+template<>
+struct cal_binary_mul_high<int_type,int_type>
+{
+    typedef int_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        return (detail::il_format("imul_high %s,%s,%s\n") % r % s0 % s1).str();
+    }
+};
+
+template<>
+struct cal_binary_mul_high<int2_type,int2_type>
+{
+    typedef int2_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        return (detail::il_format("imul_high %s,%s,%s\n") % r % s0 % s1).str();
+    }
+};
+
+template<>
+struct cal_binary_mul_high<int4_type,int4_type>
+{
+    typedef int4_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        return (detail::il_format("imul_high %s,%s,%s\n") % r % s0 % s1).str();
+    }
+};
+
+template<>
+struct cal_binary_mul_high<uint_type,uint_type>
+{
+    typedef uint_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        return (detail::il_format("umul_high %s,%s,%s\n") % r % s0 % s1).str();
+    }
+};
+
+template<>
+struct cal_binary_mul_high<uint2_type,uint2_type>
+{
+    typedef uint2_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        return (detail::il_format("umul_high %s,%s,%s\n") % r % s0 % s1).str();
+    }
+};
+
+template<>
+struct cal_binary_mul_high<uint4_type,uint4_type>
+{
+    typedef uint4_type value_type;
+    static const int temp_reg_count=0;
+
+    static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
+    {
+        return (detail::il_format("umul_high %s,%s,%s\n") % r % s0 % s1).str();
+    }
+};
+
 //
 // div
 //
@@ -636,7 +725,7 @@ struct cal_binary_div<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format( "ilt          r%5%,%2%,l0\n"
+        return (detail::il_format( "ilt          r%5%,%2%,l0\n"
                                "ilt          r%6%,%3%,l0\n"
                                "inegate      r%7%,%2%\n"
                                "inegate      r%8%,%3%\n"
@@ -657,7 +746,7 @@ struct cal_binary_div<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format( "ilt          r%5%,%2%,l0\n"
+        return (detail::il_format( "ilt          r%5%,%2%,l0\n"
                                "ilt          r%6%,%3%,l0\n"
                                "inegate      r%7%,%2%\n"
                                "inegate      r%8%,%3%\n"
@@ -678,7 +767,7 @@ struct cal_binary_div<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format( "ilt          r%5%,%2%,l0\n"
+        return (detail::il_format( "ilt          r%5%,%2%,l0\n"
                                "ilt          r%6%,%3%,l0\n"
                                "inegate      r%7%,%2%\n"
                                "inegate      r%8%,%3%\n"
@@ -699,7 +788,7 @@ struct cal_binary_div<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("udiv %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("udiv %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -711,7 +800,7 @@ struct cal_binary_div<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("udiv %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("udiv %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -723,7 +812,7 @@ struct cal_binary_div<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("udiv %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("udiv %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -736,7 +825,7 @@ struct cal_binary_div<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("div %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("div %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -748,7 +837,7 @@ struct cal_binary_div<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("div %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("div %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -760,7 +849,7 @@ struct cal_binary_div<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("div %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("div %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -772,7 +861,7 @@ struct cal_binary_div<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ddiv %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ddiv %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -784,7 +873,7 @@ struct cal_binary_div<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ddiv %1%,%3%,%5%\n"
+        return (detail::il_format("ddiv %1%,%3%,%5%\n"
                               "ddiv %2%,%4%,%6%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                     % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                     % make_swizzle(s1,1,2,0,0) % make_swizzle(s1,3,4,0,0)).str();
@@ -817,7 +906,7 @@ struct cal_binary_mod<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("umod %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("umod %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -829,7 +918,7 @@ struct cal_binary_mod<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("umod %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("umod %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -841,7 +930,7 @@ struct cal_binary_mod<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("umod %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("umod %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -853,7 +942,7 @@ struct cal_binary_mod<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mod %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("mod %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -865,7 +954,7 @@ struct cal_binary_mod<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mod %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("mod %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -877,7 +966,7 @@ struct cal_binary_mod<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("mod %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("mod %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -905,7 +994,7 @@ struct cal_ternary_mad<int_type,int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("imad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("imad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -917,7 +1006,7 @@ struct cal_ternary_mad<int2_type,int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("imad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("imad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -929,7 +1018,7 @@ struct cal_ternary_mad<int4_type,int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("imad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("imad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -941,7 +1030,7 @@ struct cal_ternary_mad<uint_type,uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("umad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("umad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -953,7 +1042,7 @@ struct cal_ternary_mad<uint2_type,uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("umad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("umad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -965,7 +1054,7 @@ struct cal_ternary_mad<uint4_type,uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("umad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("umad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -978,7 +1067,7 @@ struct cal_ternary_mad<float_type,float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("fma %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("fma %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -990,7 +1079,7 @@ struct cal_ternary_mad<float2_type,float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("fma %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("fma %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -1002,7 +1091,7 @@ struct cal_ternary_mad<float4_type,float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("fma %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("fma %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 #else
@@ -1014,7 +1103,7 @@ struct cal_ternary_mad<float_type,float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("mad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("mad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -1026,7 +1115,7 @@ struct cal_ternary_mad<float2_type,float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("mad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("mad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -1038,7 +1127,7 @@ struct cal_ternary_mad<float4_type,float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("mad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("mad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 #endif
@@ -1051,7 +1140,7 @@ struct cal_ternary_mad<double_type,double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("dmad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("dmad %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -1063,7 +1152,7 @@ struct cal_ternary_mad<double2_type,double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("dmad %1%,%3%,%5%,%7%\n"
+        return (detail::il_format("dmad %1%,%3%,%5%,%7%\n"
                               "dmad %2%,%4%,%6%,%8%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                         % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                         % make_swizzle(s1,1,2,0,0) % make_swizzle(s1,3,4,0,0)
@@ -25,7 +25,7 @@
 
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 
 namespace cal {
 namespace il {
@@ -51,7 +51,7 @@ struct cal_ternary_bitalign
         std::string    res;
 
         for(int i=1;i<=S1::component_count;i++) {
-            res += (boost::format("bitalign %1%,%2%,%3%,%4%\n") % mask_output(make_swizzle(r,i,0,0,0)) 
+            res += (detail::il_format("bitalign %1%,%2%,%3%,%4%\n") % mask_output(make_swizzle(r,i,0,0,0)) 
                                                                 % make_swizzle(s0,i,0,0,0) 
                                                                 % make_swizzle(s1,i,0,0,0) 
                                                                 % make_swizzle(s2,i,0,0,0) ).str();
@@ -81,7 +81,7 @@ struct cal_ternary_bytealign
         std::string    res;
 
         for(int i=1;i<=S1::component_count;i++) {
-            res += (boost::format("bytealign %1%,%2%,%3%,%4%\n") % mask_output(make_swizzle(r,i,0,0,0)) 
+            res += (detail::il_format("bytealign %1%,%2%,%3%,%4%\n") % mask_output(make_swizzle(r,i,0,0,0)) 
                                                                  % make_swizzle(s0,i,0,0,0) 
                                                                  % make_swizzle(s1,i,0,0,0) 
                                                                  % make_swizzle(s2,i,0,0,0) ).str();
@@ -108,7 +108,7 @@ struct cal_ternary_bfi
         BOOST_STATIC_ASSERT( S1::type_size==S3::type_size ); 
         BOOST_STATIC_ASSERT( S1::component_count==S3::component_count );
 
-        return (boost::format("bfi %1%,%2%,%3%,%4%\n") % r  % s0 % s1 % s2).str();
+        return (detail::il_format("bfi %1%,%2%,%3%,%4%\n") % r  % s0 % s1 % s2).str();
     }
 };
 
@@ -137,7 +137,7 @@ struct cal_ternary_bitextract<uint_type,uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("ubit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("ubit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -149,7 +149,7 @@ struct cal_ternary_bitextract<uint2_type,uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("ubit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("ubit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -161,7 +161,7 @@ struct cal_ternary_bitextract<uint4_type,uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("ubit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("ubit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -173,7 +173,7 @@ struct cal_ternary_bitextract<int_type,uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("ibit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("ibit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -185,7 +185,7 @@ struct cal_ternary_bitextract<int2_type,uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("ibit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("ibit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -197,7 +197,7 @@ struct cal_ternary_bitextract<int4_type,uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, const std::string& s2, int t0 )
     {
-        return (boost::format("ibit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
+        return (detail::il_format("ibit_extract %1%,%2%,%3%,%4%\n") % r % s0 % s1 % s2).str();
     }
 };
 
@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_FUNCTORS_RELOP_H
 #define __CAL_IL_FUNCTORS_RELOP_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 
 namespace cal {
@@ -54,7 +54,7 @@ struct cal_unary_not<int_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0.x,l1.x\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0.x,l1.x\n") % r % s0).str();
     }    
 };
 
@@ -66,7 +66,7 @@ struct cal_unary_not<int2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0.xy,l1.xy\n") % r % s0).str();        
+        return (detail::il_format("cmov_logical %s,%s,l0.xy,l1.xy\n") % r % s0).str();        
     }    
 };
 
@@ -78,7 +78,7 @@ struct cal_unary_not<int4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0,l1\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0,l1\n") % r % s0).str();
     }    
 };
 
@@ -90,7 +90,7 @@ struct cal_unary_not<uint_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0.x,l1.x\n") % r % s0).str();        
+        return (detail::il_format("cmov_logical %s,%s,l0.x,l1.x\n") % r % s0).str();        
     }    
 };
 
@@ -102,7 +102,7 @@ struct cal_unary_not<uint2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0.xy,l1.xy\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0.xy,l1.xy\n") % r % s0).str();
     }    
 };
 
@@ -114,7 +114,7 @@ struct cal_unary_not<uint4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0,l1\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0,l1\n") % r % s0).str();
     }    
 };
 
@@ -126,7 +126,7 @@ struct cal_unary_not<float_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0.x,l1.x\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0.x,l1.x\n") % r % s0).str();
     }    
 };
 
@@ -138,7 +138,7 @@ struct cal_unary_not<float2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0.xy,l1.xy\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0.xy,l1.xy\n") % r % s0).str();
     }    
 };
 
@@ -150,7 +150,7 @@ struct cal_unary_not<float4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("cmov_logical %s,%s,l0,l1\n") % r % s0).str();
+        return (detail::il_format("cmov_logical %s,%s,l0,l1\n") % r % s0).str();
     }    
 };
 
@@ -179,7 +179,7 @@ struct cal_binary_eq<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ieq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ieq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -191,7 +191,7 @@ struct cal_binary_eq<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ieq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ieq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -203,7 +203,7 @@ struct cal_binary_eq<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ieq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ieq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -215,7 +215,7 @@ struct cal_binary_eq<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ieq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ieq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -227,7 +227,7 @@ struct cal_binary_eq<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ieq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ieq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -239,7 +239,7 @@ struct cal_binary_eq<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ieq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ieq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -252,7 +252,7 @@ struct cal_binary_eq<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("eq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("eq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -264,7 +264,7 @@ struct cal_binary_eq<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("eq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("eq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -276,7 +276,7 @@ struct cal_binary_eq<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("eq %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("eq %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -288,7 +288,7 @@ struct cal_binary_eq<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("deq r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("deq r%4%.xy,%2%,%3%\n"
                               "mov %1%,r%4%.x\n") % r % s0 % s1 % t0).str();
     }
 };
@@ -301,7 +301,7 @@ struct cal_binary_eq<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("deq r%6%.xy,%2%,%4%\n"
+        return (detail::il_format("deq r%6%.xy,%2%,%4%\n"
                               "deq r%6%.zw,%3%,%5%\n"
                               "mov %1%,r%6%.xz\n") % r
                                                    % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
@@ -335,7 +335,7 @@ struct cal_binary_ne<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ine %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ine %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -347,7 +347,7 @@ struct cal_binary_ne<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ine %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ine %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -359,7 +359,7 @@ struct cal_binary_ne<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ine %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ine %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -371,7 +371,7 @@ struct cal_binary_ne<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ine %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ine %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -383,7 +383,7 @@ struct cal_binary_ne<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ine %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ine %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -395,7 +395,7 @@ struct cal_binary_ne<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ine %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ine %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -408,7 +408,7 @@ struct cal_binary_ne<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ne %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ne %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -420,7 +420,7 @@ struct cal_binary_ne<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ne %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ne %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -432,7 +432,7 @@ struct cal_binary_ne<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ne %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ne %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -444,7 +444,7 @@ struct cal_binary_ne<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dne r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("dne r%4%.xy,%2%,%3%\n"
                               "mov %1%,r%4%.x\n") % r % s0 % s1 % t0).str();
     }
 };
@@ -457,7 +457,7 @@ struct cal_binary_ne<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dne r%6%.xy,%2%,%4%\n"
+        return (detail::il_format("dne r%6%.xy,%2%,%4%\n"
                               "dne r%6%.zw,%3%,%5%\n"
                               "mov %1%,r%6%.xz\n") % r 
                                                    % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
@@ -491,7 +491,7 @@ struct cal_binary_ge<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ige %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ige %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -503,7 +503,7 @@ struct cal_binary_ge<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ige %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ige %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -515,7 +515,7 @@ struct cal_binary_ge<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ige %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ige %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -527,7 +527,7 @@ struct cal_binary_ge<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("uge %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("uge %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -539,7 +539,7 @@ struct cal_binary_ge<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("uge %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("uge %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -551,7 +551,7 @@ struct cal_binary_ge<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("uge %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("uge %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -564,7 +564,7 @@ struct cal_binary_ge<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ge %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ge %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -576,7 +576,7 @@ struct cal_binary_ge<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ge %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ge %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -588,7 +588,7 @@ struct cal_binary_ge<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ge %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ge %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -600,7 +600,7 @@ struct cal_binary_ge<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dge r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("dge r%4%.xy,%2%,%3%\n"
                               "mov %1%,r%4%.x\n") % r % s0 % s1 % t0).str();
     }
 };
@@ -613,7 +613,7 @@ struct cal_binary_ge<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dge r%6%.xy,%2%,%4%\n"
+        return (detail::il_format("dge r%6%.xy,%2%,%4%\n"
                               "dge r%6%.zw,%3%,%5%\n"
                               "mov %1%,r%6%.xz\n") % r
                                                    % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
@@ -647,7 +647,7 @@ struct cal_binary_lt<int_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ilt %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ilt %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -659,7 +659,7 @@ struct cal_binary_lt<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ilt %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ilt %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -671,7 +671,7 @@ struct cal_binary_lt<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ilt %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ilt %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -683,7 +683,7 @@ struct cal_binary_lt<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ult %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ult %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -695,7 +695,7 @@ struct cal_binary_lt<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ult %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ult %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -707,7 +707,7 @@ struct cal_binary_lt<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ult %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("ult %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -720,7 +720,7 @@ struct cal_binary_lt<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("lt %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("lt %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -732,7 +732,7 @@ struct cal_binary_lt<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("lt %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("lt %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -744,7 +744,7 @@ struct cal_binary_lt<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("lt %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("lt %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -756,7 +756,7 @@ struct cal_binary_lt<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dlt r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("dlt r%4%.xy,%2%,%3%\n"
                               "mov %1%,r%4%.x\n") % r % s0 % s1 % t0).str();
     }
 };
@@ -769,7 +769,7 @@ struct cal_binary_lt<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dlt r%6%.xy,%2%,%4%\n"
+        return (detail::il_format("dlt r%6%.xy,%2%,%4%\n"
                               "dlt r%6%.zw,%3%,%5%\n"
                               "mov %1%,r%6%.xz\n") % r
                                                    % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
@@ -804,7 +804,7 @@ struct cal_binary_le<int_type,int_type>
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
         
-        return (boost::format("ilt r%4%.x,%2%,%3%\n"
+        return (detail::il_format("ilt r%4%.x,%2%,%3%\n"
                               "ieq r%5%.x,%2%,%3%\n"
                               "ior %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -818,7 +818,7 @@ struct cal_binary_le<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ilt r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("ilt r%4%.xy,%2%,%3%\n"
                               "ieq r%5%.xy,%2%,%3%\n"
                               "ior %1%,r%4%.xy,r%5%.xy\n") % r % s0 % s1 % t0 % (t0+1)).str();        
     }
@@ -832,7 +832,7 @@ struct cal_binary_le<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ilt r%4%,%2%,%3%\n"
+        return (detail::il_format("ilt r%4%,%2%,%3%\n"
                               "ieq r%5%,%2%,%3%\n"
                               "ior %1%,r%4%,r%5%\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -846,7 +846,7 @@ struct cal_binary_le<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ult r%4%.x,%2%,%3%\n"
+        return (detail::il_format("ult r%4%.x,%2%,%3%\n"
                               "ieq r%5%.x,%2%,%3%\n"
                               "ior %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();        
     }
@@ -860,7 +860,7 @@ struct cal_binary_le<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ult r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("ult r%4%.xy,%2%,%3%\n"
                               "ieq r%5%.xy,%2%,%3%\n"
                               "ior %1%,r%4%.xy,r%5%.xy\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -874,7 +874,7 @@ struct cal_binary_le<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ult r%4%,%2%,%3%\n"
+        return (detail::il_format("ult r%4%,%2%,%3%\n"
                               "ieq r%5%,%2%,%3%\n"
                               "ior %1%,r%4%,r%5%\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -889,7 +889,7 @@ struct cal_binary_le<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("lt  r%4%.x,%2%,%3%\n"
+        return (detail::il_format("lt  r%4%.x,%2%,%3%\n"
                               "eq  r%5%.x,%2%,%3%\n"
                               "ior %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -903,7 +903,7 @@ struct cal_binary_le<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("lt  r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("lt  r%4%.xy,%2%,%3%\n"
                               "eq  r%5%.xy,%2%,%3%\n"
                               "ior %1%,r%4%.xy,r%5%.xy\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -917,7 +917,7 @@ struct cal_binary_le<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("lt  r%4%,%2%,%3%\n"
+        return (detail::il_format("lt  r%4%,%2%,%3%\n"
                               "eq  r%5%,%2%,%3%\n"
                               "ior %1%,r%4%,r%5%\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -931,7 +931,7 @@ struct cal_binary_le<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dlt r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("dlt r%4%.xy,%2%,%3%\n"
                               "deq r%5%.xy,%2%,%3%\n"
                               "ior %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -945,7 +945,7 @@ struct cal_binary_le<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dlt r%6%.xy,%2%,%4%\n"
+        return (detail::il_format("dlt r%6%.xy,%2%,%4%\n"
                               "dlt r%6%.zw,%3%,%5%\n"
                               "deq r%7%.xy,%2%,%4%\n"
                               "deq r%7%.zw,%3%,%5%\n"
@@ -982,7 +982,7 @@ struct cal_binary_gt<int_type,int_type>
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
         
-        return (boost::format("ige  r%4%.x,%2%,%3%\n"
+        return (detail::il_format("ige  r%4%.x,%2%,%3%\n"
                               "ine  r%5%.x,%2%,%3%\n"
                               "iand %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -996,7 +996,7 @@ struct cal_binary_gt<int2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ige r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("ige r%4%.xy,%2%,%3%\n"
                               "ine r%5%.xy,%2%,%3%\n"
                               "iand %1%,r%4%.xy,r%5%.xy\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1010,7 +1010,7 @@ struct cal_binary_gt<int4_type,int4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ige r%4%,%2%,%3%\n"
+        return (detail::il_format("ige r%4%,%2%,%3%\n"
                               "ine r%5%,%2%,%3%\n"
                               "iand %1%,r%4%,r%5%\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1024,7 +1024,7 @@ struct cal_binary_gt<uint_type,uint_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("uge r%4%.x,%2%,%3%\n"
+        return (detail::il_format("uge r%4%.x,%2%,%3%\n"
                               "ine r%5%.x,%2%,%3%\n"
                               "iand %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1038,7 +1038,7 @@ struct cal_binary_gt<uint2_type,uint2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("uge r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("uge r%4%.xy,%2%,%3%\n"
                               "ine r%5%.xy,%2%,%3%\n"
                               "iand %1%,r%4%.xy,r%5%.xy\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1052,7 +1052,7 @@ struct cal_binary_gt<uint4_type,uint4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("uge r%4%,%2%,%3%\n"
+        return (detail::il_format("uge r%4%,%2%,%3%\n"
                               "ine r%5%,%2%,%3%\n"
                               "iand %1%,r%4%,r%5%\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1067,7 +1067,7 @@ struct cal_binary_gt<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ge  r%4%.x,%2%,%3%\n"
+        return (detail::il_format("ge  r%4%.x,%2%,%3%\n"
                               "ne  r%5%.x,%2%,%3%\n"
                               "iand %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1081,7 +1081,7 @@ struct cal_binary_gt<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ge  r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("ge  r%4%.xy,%2%,%3%\n"
                               "ne  r%5%.xy,%2%,%3%\n"
                               "iand %1%,r%4%.xy,r%5%.xy\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1095,7 +1095,7 @@ struct cal_binary_gt<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("ge  r%4%,%2%,%3%\n"
+        return (detail::il_format("ge  r%4%,%2%,%3%\n"
                               "ne  r%5%,%2%,%3%\n"
                               "iand %1%,r%4%,r%5%\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1109,7 +1109,7 @@ struct cal_binary_gt<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dge r%4%.xy,%2%,%3%\n"
+        return (detail::il_format("dge r%4%.xy,%2%,%3%\n"
                               "dne r%5%.xy,%2%,%3%\n"
                               "iand %1%,r%4%.x,r%5%.x\n") % r % s0 % s1 % t0 % (t0+1)).str();
     }
@@ -1123,7 +1123,7 @@ struct cal_binary_gt<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dge r%6%.xy,%2%,%4%\n"
+        return (detail::il_format("dge r%6%.xy,%2%,%4%\n"
                               "dge r%6%.zw,%3%,%5%\n"
                               "dne r%7%.xy,%2%,%4%\n"
                               "dne r%7%.zw,%3%,%5%\n"
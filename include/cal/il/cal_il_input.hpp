@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_INPUT_H
 #define __CAL_IL_INPUT_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
 #include <boost/array.hpp>
@@ -71,13 +71,13 @@ public:
             int        idx;
             conv.base[0] = xoffset; conv.base[1] = yoffset; conv.base[2] = 0; conv.base[3] = 0;
             idx = Source::code().getLiteral( conv.hex );
-            Source::code() << boost::format("add r%1%,%2%000,l%3%.x000\n") % (index+1) % make_swizzle(_e.resultCode(),1,0,0,0) % idx;
-            Source::code() << boost::format("sample_resource(%1%)_sampler(%2%) %3%,r%4%\n") % input_index % s % resultCode() % (index+1);
+            Source::code() << detail::il_format("add r%1%,%2%000,l%3%.x000\n") % (index+1) % make_swizzle(_e.resultCode(),1,0,0,0) % idx;
+            Source::code() << detail::il_format("sample_resource(%1%)_sampler(%2%) %3%,r%4%\n") % input_index % s % resultCode() % (index+1);
             return;
         }
 
-        if( xoffset!=0 || yoffset!=0 ) Source::code() << boost::format("sample_resource(%1%)_sampler(%2%)_aoffimmi(%3%,%4%,0) %5%,%6%000\n") % input_index % s % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
-        else Source::code() << boost::format("sample_resource(%1%)_sampler(%2%) %3%,%4%000\n") % input_index % s % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
+        if( xoffset!=0 || yoffset!=0 ) Source::code() << detail::il_format("sample_resource(%1%)_sampler(%2%)_aoffimmi(%3%,%4%,0) %5%,%6%000\n") % input_index % s % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
+        else Source::code() << detail::il_format("sample_resource(%1%)_sampler(%2%) %3%,%4%000\n") % input_index % s % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
     }
 
     void iemitCode( int s, float2_type ) const
@@ -87,13 +87,13 @@ public:
             int        idx;
             conv.base[0] = xoffset; conv.base[1] = yoffset; conv.base[2] = 0; conv.base[3] = 0;
             idx = Source::code().getLiteral( conv.hex );
-            Source::code() << boost::format("add r%1%,%2%00,l%3%.xy00\n") % (index+1) % make_swizzle(_e.resultCode(),1,2,0,0) % idx;
-            Source::code() << boost::format("sample_resource(%1%)_sampler(%2%) %3%,r%4%\n") % input_index % s % resultCode() % (index+1);
+            Source::code() << detail::il_format("add r%1%,%2%00,l%3%.xy00\n") % (index+1) % make_swizzle(_e.resultCode(),1,2,0,0) % idx;
+            Source::code() << detail::il_format("sample_resource(%1%)_sampler(%2%) %3%,r%4%\n") % input_index % s % resultCode() % (index+1);
             return;
         }
 
-        if( xoffset!=0 || yoffset!=0 ) Source::code() << boost::format("sample_resource(%1%)_sampler(%2%)_aoffimmi(%3%,%4%,0) %5%,%6%00\n") % input_index % s % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
-        else Source::code() << boost::format("sample_resource(%1%)_sampler(%2%) %3%,%4%00\n") % input_index % s % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
+        if( xoffset!=0 || yoffset!=0 ) Source::code() << detail::il_format("sample_resource(%1%)_sampler(%2%)_aoffimmi(%3%,%4%,0) %5%,%6%00\n") % input_index % s % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
+        else Source::code() << detail::il_format("sample_resource(%1%)_sampler(%2%) %3%,%4%00\n") % input_index % s % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
     }
 
     void iemitCode( int s, int_type ) const
@@ -103,13 +103,13 @@ public:
             int        idx;
             conv.base[0] = xoffset; conv.base[1] = yoffset; conv.base[2] = 0; conv.base[3] = 0;
             idx = Source::code().getLiteral( conv.hex );
-            Source::code() << boost::format("iadd r%1%,%2%000,l%3%.x000\n") % (index+1) % make_swizzle(_e.resultCode(),1,0,0,0) % idx;
-            Source::code() << boost::format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
+            Source::code() << detail::il_format("iadd r%1%,%2%000,l%3%.x000\n") % (index+1) % make_swizzle(_e.resultCode(),1,0,0,0) % idx;
+            Source::code() << detail::il_format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
             return;
         }
 
-        if( xoffset!=0 || yoffset!=0 ) Source::code << boost::format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%000\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
-        else Source::code << boost::format("load_resource(%1%) %2%,%3%000\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
+        if( xoffset!=0 || yoffset!=0 ) Source::code << detail::il_format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%000\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
+        else Source::code << detail::il_format("load_resource(%1%) %2%,%3%000\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
     }
 
     void iemitCode( int s, int2_type ) const
@@ -119,13 +119,13 @@ public:
             int        idx;
             conv.base[0] = xoffset; conv.base[1] = yoffset; conv.base[2] = 0; conv.base[3] = 0;
             idx = Source::code().getLiteral( conv.hex );
-            Source::code() << boost::format("iadd r%1%,%2%00,l%3%.xy00\n") % (index+1) % make_swizzle(_e.resultCode(),1,2,0,0) % idx;
-            Source::code() << boost::format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
+            Source::code() << detail::il_format("iadd r%1%,%2%00,l%3%.xy00\n") % (index+1) % make_swizzle(_e.resultCode(),1,2,0,0) % idx;
+            Source::code() << detail::il_format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
             return;
         }
 
-        if( xoffset!=0 || yoffset!=0 ) Source::code() << boost::format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%00\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
-        else Source::code() << boost::format("load_resource(%1%) %2%,%3%00\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
+        if( xoffset!=0 || yoffset!=0 ) Source::code() << detail::il_format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%00\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
+        else Source::code() << detail::il_format("load_resource(%1%) %2%,%3%00\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
     }
 
     void iemitCode( int s, uint_type ) const
@@ -135,13 +135,13 @@ public:
             int        idx;
             conv.base[0] = xoffset; conv.base[1] = yoffset; conv.base[2] = 0; conv.base[3] = 0;
             idx = Source::code().getLiteral( conv.hex );
-            Source::code() << boost::format("iadd r%1%,%2%000,l%3%.x000\n") % (index+1) % make_swizzle(_e.resultCode(),1,0,0,0) % idx;
-            Source::code() << boost::format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
+            Source::code() << detail::il_format("iadd r%1%,%2%000,l%3%.x000\n") % (index+1) % make_swizzle(_e.resultCode(),1,0,0,0) % idx;
+            Source::code() << detail::il_format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
             return;
         }
 
-        if( xoffset!=0 || yoffset!=0 ) Source::code() << boost::format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%000\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
-        else Source::code() << boost::format("load_resource(%1%) %2%,%3%000\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
+        if( xoffset!=0 || yoffset!=0 ) Source::code() << detail::il_format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%000\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
+        else Source::code() << detail::il_format("load_resource(%1%) %2%,%3%000\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,0,0,0);
     }
 
     void iemitCode( int s, uint2_type ) const
@@ -151,13 +151,13 @@ public:
             int        idx;
             conv.base[0] = xoffset; conv.base[1] = yoffset; conv.base[2] = 0; conv.base[3] = 0;
             idx = Source::code().getLiteral( conv.hex );
-            Source::code() << boost::format("iadd r%1%,%2%00,l%3%.xy00\n") % (index+1) % make_swizzle(_e.resultCode(),1,2,0,0) % idx;
-            Source::code() << boost::format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
+            Source::code() << detail::il_format("iadd r%1%,%2%00,l%3%.xy00\n") % (index+1) % make_swizzle(_e.resultCode(),1,2,0,0) % idx;
+            Source::code() << detail::il_format("load_resource(%1%) %2%,r%3%\n") % input_index % resultCode() % (index+1);
             return;
         }
 
-        if( xoffset!=0 || yoffset!=0 ) Source::code() << boost::format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%00\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
-        else Source::code() << boost::format("load_resource(%1%) %2%,%3%00\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
+        if( xoffset!=0 || yoffset!=0 ) Source::code() << detail::il_format("load_resource(%1%)_aoffimmi(%2%,%3%,0) %4%,%5%00\n") % input_index % xoffset % yoffset % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
+        else Source::code() << detail::il_format("load_resource(%1%) %2%,%3%00\n") % input_index % resultCode() % make_swizzle(_e.resultCode(),1,2,0,0);
     }
 
 public:
@@ -196,7 +196,7 @@ protected:
 protected:
     static std::string emit_dcl( int id, int size )
     {
-        return (boost::format("dcl_resource_id(%i)_type(1d,unnorm)_fmtx(unknown)_fmty(unknown)_fmtz(unknown)_fmtw(unknown)") % id).str();
+        return (detail::il_format("dcl_resource_id(%i)_type(1d,unnorm)_fmtx(unknown)_fmty(unknown)_fmtz(unknown)_fmtw(unknown)") % id).str();
     }
 
 public:
@@ -204,7 +204,7 @@ public:
     {
         input_index = idx;
         input_sampler = s;
-        Source::code().registerDCL( (boost::format("input:%i") % idx).str(),
+        Source::code().registerDCL( (detail::il_format("input:%i") % idx).str(),
                                     boost::bind(&input1d<T>::emit_dcl,idx,(int)value_type::type_size) );
     }
 
@@ -260,7 +260,7 @@ protected:
 protected:
     static std::string emit_dcl( int id, int size )
     {
-        return (boost::format("dcl_resource_id(%i)_type(2d,unnorm)_fmtx(unknown)_fmty(unknown)_fmtz(unknown)_fmtw(unknown)") % id).str();
+        return (detail::il_format("dcl_resource_id(%i)_type(2d,unnorm)_fmtx(unknown)_fmty(unknown)_fmtz(unknown)_fmtw(unknown)") % id).str();
     }
 
 public:
@@ -268,7 +268,7 @@ public:
     {
         input_index = idx;
         input_sampler = s;
-        Source::code().registerDCL( (boost::format("input:%i") % idx).str(),
+        Source::code().registerDCL( (detail::il_format("input:%i") % idx).str(),
                                     boost::bind(&input2d<T>::emit_dcl,idx,(int)value_type::type_size) );
     }
 
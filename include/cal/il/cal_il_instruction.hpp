@@ -0,0 +1,430 @@
+/*
+ * C++ to IL compiler/generator instruction representation
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_INSTRUCTION_H
+#define __CAL_IL_INSTRUCTION_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdlib>
+#include <cctype>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// single IL operand split into register name, swizzle ( or write mask ) and modifiers
+// for example "r12.x_neg(x)" gives name "r12", swizzle "x", modifier "_neg(x)"
+//
+
+struct instruction_operand
+{
+    std::string name;
+    std::string swizzle;
+    std::string modifier;
+
+    std::string str() const
+    {
+        if( swizzle.empty() ) return name + modifier;
+        return name + "." + swizzle + modifier;
+    }
+};
+
+//
+// one line of IL code
+// when text is not empty the line is emitted verbatim ( comments, declarations, non canonical formatting )
+// passes which modify opcode or operands must clear text
+//
+
+struct instruction
+{
+    std::string                         opcode;
+    std::vector<instruction_operand>    operand;
+    std::string                         text;
+
+    std::string str() const
+    {
+        std::string r;
+
+        if( !text.empty() || opcode.empty() ) return text;
+
+        r = opcode;
+        for(unsigned i=0;i<operand.size();i++) {
+            r += (i==0) ? " " : ",";
+            r += operand[i].str();
+        }
+
+        return r;
+    }
+};
+
+typedef std::vector<instruction>    instruction_list;
+
+enum instruction_flow_type
+{
+    FLOW_NONE = 0,
+    FLOW_WHILELOOP,
+    FLOW_ENDLOOP,
+    FLOW_BREAK,
+    FLOW_BREAKC,
+    FLOW_CONTINUE,
+    FLOW_CONTINUEC,
+    FLOW_IF,
+    FLOW_ELSE,
+    FLOW_ENDIF,
+    FLOW_CALL,
+    FLOW_FUNC,
+    FLOW_RET,
+    FLOW_ENDFUNC,
+    FLOW_ENDMAIN,
+    FLOW_END
+};
+
+inline bool is_swizzle_letter( char c )
+{
+    return c=='x' || c=='y' || c=='z' || c=='w';
+}
+
+inline instruction_operand parse_operand( const std::string& src )
+{
+    instruction_operand     r;
+    std::string::size_type  p,s;
+    int                     depth;
+
+    depth = 0;
+    for(p=0;p<src.length();p++) {
+        char c = src[p];
+        if( c=='[' || c=='(' ) depth++;
+        else if( c==']' || c==')' ) depth--;
+        else if( depth==0 && (c=='.' || c=='_') && p>0 ) break;
+    }
+
+    r.name = src.substr(0,p);
+    if( p>=src.length() ) return r;
+
+    if( src[p]=='.' ) {
+        for(s=p+1;s<src.length() && s<p+5;s++) {
+            char c = src[s];
+            if( c=='_' && s+1<src.length() && src[s+1]>='a' && src[s+1]<='z' && !is_swizzle_letter(src[s+1]) ) break;
+            if( !is_swizzle_letter(c) && c!='0' && c!='1' && c!='_' ) break;
+        }
+        r.swizzle = src.substr(p+1,s-p-1);
+        p = s;
+    }
+
+    r.modifier = src.substr(p);
+    return r;
+}
+
+inline instruction parse_instruction( const std::string& line )
+{
+    instruction             r;
+    std::string::size_type  p,s;
+    int                     depth;
+
+    if( line.empty() || line[0]==';' ) {
+        r.text = line;
+        return r;
+    }
+
+    p = line.find(' ');
+    r.opcode = line.substr(0,p);
+
+    if( p!=std::string::npos ) {
+        while( p<line.length() && line[p]==' ' ) p++;
+
+        depth = 0;
+        for(s=p;s<=line.length();s++) {
+            if( s==line.length() || (line[s]==',' && depth==0) ) {
+                r.operand.push_back( parse_operand(line.substr(p,s-p)) );
+                p = s+1;
+                continue;
+            }
+
+            char c = line[s];
+            if( c=='[' || c=='(' ) depth++;
+            else if( c==']' || c==')' ) depth--;
+        }
+    }
+
+    if( r.str()!=line ) r.text = line;
+    return r;
+}
+
+inline void parse_code( const std::string& src, instruction_list& code )
+{
+    std::string::size_type  p,e;
+
+    for(p=0;p<src.length();p=e+1) {
+        e = src.find('\n',p);
+        if( e==std::string::npos ) e = src.length();
+        code.push_back( parse_instruction(src.substr(p,e-p)) );
+    }
+}
+
+inline void emit_code( const instruction_list& code, std::string& out )
+{
+    for(unsigned i=0;i<code.size();i++) {
+        out += code[i].str();
+        out += "\n";
+    }
+}
+
+//
+// generated text kept in append-only buffer ( capacity is reused between kernels )
+// instructions are parsed only when optimizer asks for them, complete lines only
+//
+
+struct instruction_stream
+{
+    instruction_list        code;       // instructions of text[0,parsed)
+    std::string             text;
+    std::string::size_type  parsed;
+
+    instruction_stream() : parsed(0) {}
+
+    void append( const char* s, std::string::size_type n )
+    {
+        text.append(s,n);
+    }
+
+    void append( const std::string& s )
+    {
+        text.append(s);
+    }
+
+    instruction_list& instructions()
+    {
+        std::string::size_type  e;
+
+        while( (e=text.find('\n',parsed))!=std::string::npos ) {
+            code.push_back( parse_instruction(text.substr(parsed,e-parsed)) );
+            parsed = e+1;
+        }
+
+        return code;
+    }
+
+    void clear()
+    {
+        code.clear();
+        text.clear();
+        parsed = 0;
+    }
+
+    bool empty() const
+    {
+        return code.empty() && parsed==text.length();
+    }
+
+    void emit( std::ostream& _out ) const
+    {
+        for(unsigned i=0;i<code.size();i++) {
+            _out << code[i].str() << "\n";
+        }
+        _out.write(text.data()+parsed,text.length()-parsed);
+    }
+};
+
+//
+// opcode without control modifiers ( "ifc_relop(eq)" gives "ifc_relop" )
+//
+
+inline std::string base_opcode( const std::string& opcode )
+{
+    return opcode.substr(0,opcode.find('('));
+}
+
+inline instruction_flow_type flow_type( const instruction& inst )
+{
+    std::string op = base_opcode(inst.opcode);
+
+    if( op.empty() ) return FLOW_NONE;
+    if( op=="whileloop" ) return FLOW_WHILELOOP;
+    if( op=="endloop" ) return FLOW_ENDLOOP;
+    if( op=="break" ) return FLOW_BREAK;
+    if( op=="breakc_relop" || op=="break_logicalz" || op=="break_logicalnz" ) return FLOW_BREAKC;
+    if( op=="continue" ) return FLOW_CONTINUE;
+    if( op=="continuec_relop" || op=="continue_logicalz" || op=="continue_logicalnz" ) return FLOW_CONTINUEC;
+    if( op=="ifnz" || op=="ifc_relop" || op=="if_logicalz" || op=="if_logicalnz" ) return FLOW_IF;
+    if( op=="else" ) return FLOW_ELSE;
+    if( op=="endif" ) return FLOW_ENDIF;
+    if( op=="call" ) return FLOW_CALL;
+    if( op=="func" ) return FLOW_FUNC;
+    if( op=="ret" || op=="ret_dyn" ) return FLOW_RET;
+    if( op=="endfunc" ) return FLOW_ENDFUNC;
+    if( op=="endmain" ) return FLOW_ENDMAIN;
+    if( op=="end" ) return FLOW_END;
+    return FLOW_NONE;
+}
+
+inline bool is_declaration( const instruction& inst )
+{
+    return inst.opcode.compare(0,4,"dcl_")==0 || inst.opcode.compare(0,3,"il_")==0;
+}
+
+//
+// true when first operand is written by the instruction
+// stores, atomics without return value, fences and flow control only read their operands
+//
+
+inline bool has_destination( const instruction& inst )
+{
+    std::string op = base_opcode(inst.opcode);
+
+    if( inst.opcode.empty() || inst.operand.empty() ) return false;
+    if( flow_type(inst)!=FLOW_NONE || is_declaration(inst) ) return false;
+    if( op.compare(0,5,"fence")==0 ) return false;
+    if( op.find("_store")!=std::string::npos || op.find("_write")!=std::string::npos ) return false;
+    if( op.compare(0,4,"uav_")==0 || op.compare(0,4,"lds_")==0 ) {
+        return op.find("_load")!=std::string::npos || op.find("_read")!=std::string::npos;
+    }
+
+    return true;
+}
+
+//
+// temporary registers
+//
+
+inline int temp_register( const std::string& name )
+{
+    if( name.length()<2 || name[0]!='r' ) return -1;
+    for(std::string::size_type i=1;i<name.length();i++) {
+        if( name[i]<'0' || name[i]>'9' ) return -1;
+    }
+    return std::atoi(name.c_str()+1);
+}
+
+//
+// calls f(position,length,register) for each temporary register in operand name ( including index expressions )
+//
+
+template<class F>
+void for_each_temp( const std::string& name, F f )
+{
+    std::string::size_type  p,e;
+
+    for(p=0;p<name.length();p++) {
+        if( name[p]!='r' ) continue;
+        if( p>0 && (std::isalnum(name[p-1]) || name[p-1]=='_') ) continue;
+
+        for(e=p+1;e<name.length() && name[e]>='0' && name[e]<='9';e++);
+        if( e==p+1 ) continue;
+        if( e<name.length() && (std::isalpha(name[e]) || name[e]=='_') ) continue;
+
+        f(p,e-p,std::atoi(name.c_str()+p+1));
+        p = e-1;
+    }
+}
+
+//
+// operands refering to memory or indexed registers ( g[], x#[], mem, resources )
+// constant buffers are read only and are not treated as memory
+//
+
+inline bool is_memory_operand( const instruction_operand& op )
+{
+    if( op.name.compare(0,2,"cb")==0 ) return false;
+    if( op.name=="mem" ) return true;
+    return op.name.find('[')!=std::string::npos;
+}
+
+//
+// instruction which result depends only on its operands ( no memory access, no side effects )
+//
+
+inline bool is_pure( const instruction& inst )
+{
+    std::string op = base_opcode(inst.opcode);
+
+    if( !has_destination(inst) ) return false;
+    if( op.compare(0,4,"uav_")==0 || op.compare(0,4,"lds_")==0 || op.compare(0,4,"gds_")==0 ) return false;
+    if( op.compare(0,6,"sample")==0 || op.compare(0,4,"load")==0 || op.compare(0,5,"fetch")==0 ) return false;
+
+    for(unsigned i=0;i<inst.operand.size();i++) {
+        if( is_memory_operand(inst.operand[i]) ) return false;
+    }
+
+    return true;
+}
+
+//
+// component masks ( bit 0 - x, bit 1 - y, bit 2 - z, bit 3 - w )
+//
+
+inline int component_mask( const std::string& swizzle )
+{
+    int mask = 0;
+
+    if( swizzle.empty() ) return 0xF;
+    for(std::string::size_type i=0;i<swizzle.length();i++) {
+        char c = swizzle[i];
+        if( c=='x' ) mask |= 1;
+        else if( c=='y' ) mask |= 2;
+        else if( c=='z' ) mask |= 4;
+        else if( c=='w' ) mask |= 8;
+    }
+
+    return mask;
+}
+
+//
+// register component read for output component c of source operand
+// returns 0-3 for x-w, -1 for constant 0 and -2 for constant 1
+//
+
+inline int swizzle_component( const std::string& swizzle, int c )
+{
+    char s;
+
+    if( swizzle.empty() ) return c;
+    s = swizzle[ (int)swizzle.length()>c ? c : swizzle.length()-1 ];
+
+    switch( s ) {
+    case 'x': return 0;
+    case 'y': return 1;
+    case 'z': return 2;
+    case 'w': return 3;
+    case '1': return -2;
+    }
+
+    return -1;
+}
+
+inline int read_mask( const instruction_operand& op )
+{
+    return component_mask(op.swizzle);
+}
+
+inline int write_mask( const instruction_operand& op )
+{
+    return component_mask(op.swizzle);
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
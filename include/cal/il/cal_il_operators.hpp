@@ -23,9 +23,82 @@
 #ifndef __CAL_IL_OPERATORS_H
 #define __CAL_IL_OPERATORS_H
 
+#include <boost/type_traits.hpp>
+
 namespace cal {
 namespace il {
 
+namespace detail {
+
+//
+// host evaluation of literal operands
+// float operations are done in component precision, integer operations wrap around like on GPU
+//
+
+template<class T, bool integral=boost::is_integral<T>::value>
+struct literal_arithmetic
+{
+    static T neg( T a )          { return -a; }
+    static T add( T a, T b )     { return a+b; }
+    static T sub( T a, T b )     { return a-b; }
+    static T mul( T a, T b )     { return a*b; }
+    static T div( T a, T b )     { return a/b; }
+};
+
+template<class T>
+struct literal_arithmetic<T,true>
+{
+    typedef typename boost::make_unsigned<T>::type  U;
+
+    static T neg( T a )          { return (T)(U(0)-(U)a); }
+    static T add( T a, T b )     { return (T)((U)a+(U)b); }
+    static T sub( T a, T b )     { return (T)((U)a-(U)b); }
+    static T mul( T a, T b )     { return (T)((U)a*(U)b); }
+    static T bitnot( T a )       { return (T)(~(U)a); }
+    static T bitand_( T a, T b ) { return (T)((U)a&(U)b); }
+    static T bitor_( T a, T b )  { return (T)((U)a|(U)b); }
+    static T bitxor_( T a, T b ) { return (T)((U)a^(U)b); }
+    // only 5 lowest bits of shift count are used ( ishr for signed, ushr for unsigned types )
+    static T shl( T a, T b )     { return (T)((U)a<<((U)b&31)); }
+    static T shr( T a, T b )     { return a>>((U)b&31); }
+};
+
+template<class T>
+struct literal_fold
+{
+    typedef typename detail::base_cal_type<T>::value::component_type    component_type;
+    typedef typename cal::il::value<T>::array_type                      array_type;
+    typedef literal_arithmetic<component_type>                          arithmetic;
+    typedef component_type (*unary_function)( component_type );
+    typedef component_type (*binary_function)( component_type, component_type );
+
+    static cal::il::value<T> apply( const cal::il::value<T>& v0, unary_function f )
+    {
+        array_type r;
+        for(unsigned i=0;i<r.size();i++) r[i] = f(v0.getData()[i]);
+        return cal::il::value<T>(r);
+    }
+
+    static cal::il::value<T> apply( const cal::il::value<T>& v0, const cal::il::value<T>& v1, binary_function f )
+    {
+        array_type r;
+        for(unsigned i=0;i<r.size();i++) r[i] = f(v0.getData()[i],v1.getData()[i]);
+        return cal::il::value<T>(r);
+    }
+
+    static cal::il::value<T> apply( const cal::il::value<T>& v0, const component_type& v1, binary_function f )
+    {
+        return apply(v0,cal::il::value<T>(v1),f);
+    }
+
+    static cal::il::value<T> apply( const component_type& v0, const cal::il::value<T>& v1, binary_function f )
+    {
+        return apply(cal::il::value<T>(v0),v1,f);
+    }
+};
+
+} // detail
+
 template<class E1>
 detail::unary<E1,detail::cal_unary_neg<typename E1::value_type> > operator-( const detail::expression<E1>& e1 )
 {
@@ -410,6 +483,140 @@ mad( const detail::expression<E1>& e1, const typename E1::value_type::component_
     return expression_type(e1(),detail::value<E1>(v1),detail::value<E1>(v2));
 }
 
+//
+// literal operands are folded on host ( a new literal is declared instead of ALU instruction )
+//
+
+template<class T>
+value<T> operator-( const value<T>& v0 )
+{
+    return detail::literal_fold<T>::apply(v0,detail::literal_fold<T>::arithmetic::neg);
+}
+
+template<class T>
+value<T> operator~( const value<T>& v0 )
+{
+    return detail::literal_fold<T>::apply(v0,detail::literal_fold<T>::arithmetic::bitnot);
+}
+
+template<class T>
+value<T> operator+( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::add);
+}
+template<class T>
+value<T> operator+( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::add);
+}
+template<class T>
+value<T> operator+( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::add);
+}
+
+template<class T>
+value<T> operator-( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::sub);
+}
+template<class T>
+value<T> operator-( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::sub);
+}
+template<class T>
+value<T> operator-( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::sub);
+}
+
+template<class T>
+value<T> operator|( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitor_);
+}
+template<class T>
+value<T> operator|( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitor_);
+}
+template<class T>
+value<T> operator|( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitor_);
+}
+
+template<class T>
+value<T> operator^( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitxor_);
+}
+template<class T>
+value<T> operator^( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitxor_);
+}
+template<class T>
+value<T> operator^( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitxor_);
+}
+
+template<class T>
+value<T> operator&( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitand_);
+}
+template<class T>
+value<T> operator&( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitand_);
+}
+template<class T>
+value<T> operator&( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::bitand_);
+}
+
+template<class T>
+value<T> operator<<( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::shl);
+}
+template<class T>
+value<T> operator<<( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::shl);
+}
+template<class T>
+value<T> operator<<( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::shl);
+}
+
+template<class T>
+value<T> operator>>( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::shr);
+}
+template<class T>
+value<T> operator>>( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::shr);
+}
+template<class T>
+value<T> operator>>( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::shr);
+}
+
+template<class T>
+value<T> mad( const value<T>& v0, const value<T>& v1, const value<T>& v2 )
+{
+    return detail::literal_fold<T>::apply(detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::mul),v2,detail::literal_fold<T>::arithmetic::add);
+}
+
 template<class E>
 detail::register_address<E> operator+( const detail::register_address<E>& r, int offset )
 {
@@ -23,6 +23,9 @@
 #ifndef __CAL_IL_OPERATORS_MULDIV_H
 #define __CAL_IL_OPERATORS_MULDIV_H
 
+#include <boost/type_traits.hpp>
+#include <boost/utility/enable_if.hpp>
+
 #if defined(__CAL_USE_IMPROVED_MULDIV)
   #include <cmath>
   #include <cal/il/math/cal_il_ldexp.hpp>
@@ -34,6 +37,87 @@ namespace il {
 namespace detail {
 
 #if defined(__CAL_USE_IMPROVED_MULDIV)
+//
+// division by constant as multiplication by its reciprocal ( Granlund, Montgomery - "Division by
+// Invariant Integers using Multiplication" ), magic numbers as in Hacker's Delight chapter 10
+//
+
+struct magic_signed
+{
+    boost::int32_t  multiplier;
+    int             shift;
+};
+
+struct magic_unsigned
+{
+    boost::uint32_t multiplier;     // lower 32 bits when add is set
+    int             shift;
+    bool            add;            // multiplier has 33 bits
+};
+
+inline bool is_power_of_2( boost::uint32_t v )
+{
+    return v!=0 && (v&(v-1))==0;
+}
+
+inline int log2_floor( boost::uint32_t v )
+{
+    int l=0;
+    while( v>>=1 ) l++;
+    return l;
+}
+
+// 2<=|d|, d not power of 2
+inline magic_signed get_magic( boost::int32_t d )
+{
+    const boost::uint32_t   two31 = 0x80000000u;
+    boost::uint32_t         ad,anc,t,q1,r1,q2,r2,delta;
+    magic_signed            m;
+    int                     p=31;
+
+    ad  = d<0 ? 0u-(boost::uint32_t)d : (boost::uint32_t)d;
+    t   = two31 + ((boost::uint32_t)d>>31);
+    anc = t - 1 - t%ad;
+    q1  = two31/anc; r1 = two31 - q1*anc;
+    q2  = two31/ad;  r2 = two31 - q2*ad;
+
+    do {
+        p++;
+        q1 = 2*q1; r1 = 2*r1;
+        if( r1>=anc ) { q1++; r1 -= anc; }
+        q2 = 2*q2; r2 = 2*r2;
+        if( r2>=ad ) { q2++; r2 -= ad; }
+        delta = ad - r2;
+    } while( q1<delta || (q1==delta && r1==0) );
+
+    m.multiplier = (boost::int32_t)(q2+1);
+    if( d<0 ) m.multiplier = -m.multiplier;
+    m.shift = p-32;
+    return m;
+}
+
+// d>1, d not power of 2
+inline magic_unsigned get_magic( boost::uint32_t d )
+{
+    int                     l = log2_floor(d);
+    boost::uint64_t         p = boost::uint64_t(1)<<(32+l);
+    boost::uint64_t         m = p/d + 1;
+    magic_unsigned          r;
+
+    r.shift = l;
+    if( m*d-p<=(boost::uint64_t(1)<<l) ) {
+        r.multiplier = (boost::uint32_t)m;
+        r.add = false;
+    }
+    else {
+        // 2*p-1 avoids overflow for l==31, d does not divide 2*p
+        m = (p + (p-1))/d + 1;
+        r.multiplier = (boost::uint32_t)(m - (boost::uint64_t(1)<<32));
+        r.add = true;
+    }
+    return r;
+}
+
 template<class E1>
 variable<typename E1::value_type> fast_mul( const E1& a, const boost::int32_t& v1 )
 {
@@ -54,7 +138,7 @@ variable<typename E1::value_type> fast_mul( const boost::int32_t& v1, const E1&
 
     m = std::frexp((double)v1,&e);
     if( m==0.5  ) { if( e!=1 ) return a << (e-1); else return a; }
-    if( m==-0.5 ) { if( e!=1 ) return -(a << (e-1)); else -a; }
+    if( m==-0.5 ) { if( e!=1 ) return -(a << (e-1)); else return -a; }
     return value<E1>(v1)*a;
 }
 
@@ -120,13 +204,32 @@ variable<typename E1::value_type> fast_mul( const double& v1, const E1& a )
 template<class E1>
 variable<typename E1::value_type> fast_div( const E1& a, const boost::int32_t& v1 )
 {
-    double m;
-    int    e;
+    typedef typename E1::value_type value_type;
 
-    m = std::frexp((double)v1,&e);
-    if( m==0.5  ) { if( e!=1 ) return a >> (e-1); else return a; }
-    if( m==-0.5 ) { if( e!=1 ) return -(a >> (e-1)); else return -a; }
-    return a/value<E1>(v1);
+    boost::uint32_t         d = v1<0 ? 0u-(boost::uint32_t)v1 : (boost::uint32_t)v1;
+    variable<value_type>    x,q;
+
+    if( v1==0  ) return a/value<E1>(v1);
+    if( v1==1  ) return a;
+    if( v1==-1 ) return -a;
+
+    x = a;
+    if( is_power_of_2(d) ) {
+        // negative values are biased by d-1 to round toward zero
+        q = (x + ((x >> 31) & (boost::int32_t)(d-1))) >> log2_floor(d);
+        if( v1<0 ) q = -q;
+        return q;
+    }
+
+    magic_signed m = get_magic(v1);
+
+    q = mul_hi(x,value<E1>(m.multiplier));
+    if( v1>0 && m.multiplier<0 ) q = q + x;
+    if( v1<0 && m.multiplier>0 ) q = q - x;
+    if( m.shift ) q = q >> m.shift;
+    q = q - (q >> 31);
+
+    return q;
 }
 
 template<class E1>
@@ -138,12 +241,26 @@ variable<typename E1::value_type> fast_div( const boost::int32_t& v1, const E1&
 template<class E1>
 variable<typename E1::value_type> fast_div( const E1& a, const boost::uint32_t& v1 )
 {
-    double m;
-    int    e;
+    typedef typename E1::value_type value_type;
 
-    m = std::frexp((double)v1,&e);
-    if( m==0.5  ) { if( e!=1 ) return a >> (e-1); else return a; }
-    return a/value<E1>(v1);
+    variable<value_type>    x,t,q;
+
+    if( v1==0 ) return a/value<E1>(v1);
+    if( v1==1 ) return a;
+    if( is_power_of_2(v1) ) return a >> log2_floor(v1);
+
+    magic_unsigned m = get_magic(v1);
+
+    x = a;
+    t = mul_hi(x,value<E1>(m.multiplier));
+    if( m.add ) {
+        // 33 bit multiplier, top bit is added without overflow
+        q = (((x - t) >> 1) + t) >> m.shift;
+    }
+    else if( m.shift ) q = t >> m.shift;
+    else q = t;
+
+    return q;
 }
 
 template<class E1>
@@ -185,12 +302,19 @@ variable<typename E1::value_type> fast_div( const double& v1, const E1& a )
 template<class E1>
 variable<typename E1::value_type> fast_mod( const E1& a, const boost::int32_t& v1 )
 {
-    double m;
-    int    e;
+    typedef typename E1::value_type value_type;
 
-    m = std::frexp((double)v1,&e);
-    if( m==0.5  ) return a & (v1-1);
-    return a%value<E1>(v1);
+    boost::uint32_t         d = v1<0 ? 0u-(boost::uint32_t)v1 : (boost::uint32_t)v1;
+    variable<value_type>    x;
+
+    // IL has no signed remainder, a-(a/0)*0 is a
+    if( v1==0 ) return a;
+    if( d==1  ) return value<E1>(0);
+
+    // remainder has sign of dividend
+    x = a;
+    if( is_power_of_2(d) ) return x - ((x + ((x >> 31) & (boost::int32_t)(d-1))) & (boost::int32_t)(0u-d));
+    return x - fast_div(x,v1)*value<E1>(v1);
 }
 
 template<class E1>
@@ -202,12 +326,15 @@ variable<typename E1::value_type> fast_mod( const boost::int32_t& v1, const E1&
 template<class E1>
 variable<typename E1::value_type> fast_mod( const E1& a, const boost::uint32_t& v1 )
 {
-    double m;
-    int    e;
+    typedef typename E1::value_type value_type;
 
-    m = std::frexp((double)v1,&e);
-    if( m==0.5  ) return a & (v1-1);
-    return a%value<E1>(v1);
+    variable<value_type>    x;
+
+    if( v1==0 ) return a%value<E1>(v1);
+    if( is_power_of_2(v1) ) return a & (v1-1);
+
+    x = a;
+    return x - fast_div(x,v1)*value<E1>(v1);
 }
 
 template<class E1>
@@ -264,6 +391,50 @@ detail::binary<E1,E2,detail::cal_binary_mod<typename E1::value_type,typename E2:
     return expression_type( e1(), e2() );
 }
 
+// upper 32 bits of integer product ( OpenCL mul_hi )
+template<class E1,class E2>
+detail::binary<E1,E2,detail::cal_binary_mul_high<typename E1::value_type,typename E2::value_type> > mul_hi( const detail::expression<E1>& e1, const detail::expression<E2>& e2 )
+{
+    typedef detail::binary<E1,E2,detail::cal_binary_mul_high<typename E1::value_type,typename E2::value_type> > expression_type;
+    return expression_type( e1(), e2() );
+}
+
+//
+// literal operands are folded on host ( integer division is left to GPU )
+//
+
+template<class T>
+value<T> operator*( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::mul);
+}
+template<class T>
+value<T> operator*( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::mul);
+}
+template<class T>
+value<T> operator*( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::mul);
+}
+
+template<class T>
+typename boost::enable_if<boost::is_floating_point<typename detail::literal_fold<T>::component_type>,value<T> >::type operator/( const value<T>& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::div);
+}
+template<class T>
+typename boost::enable_if<boost::is_floating_point<typename detail::literal_fold<T>::component_type>,value<T> >::type operator/( const value<T>& v0, const typename detail::literal_fold<T>::component_type& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::div);
+}
+template<class T>
+typename boost::enable_if<boost::is_floating_point<typename detail::literal_fold<T>::component_type>,value<T> >::type operator/( const typename detail::literal_fold<T>::component_type& v0, const value<T>& v1 )
+{
+    return detail::literal_fold<T>::apply(v0,v1,detail::literal_fold<T>::arithmetic::div);
+}
+
 //
 // mixed CAL IL and C types
 //
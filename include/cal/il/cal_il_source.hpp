@@ -32,6 +32,10 @@
 #include <boost/array.hpp>
 #include <boost/format.hpp>
 #include <boost/function.hpp>
+#include <cal/il/cal_il_format.hpp>
+#include <cal/il/cal_il_swizzle.hpp>
+#include <cal/il/opt/cal_il_optimize.hpp>
+#include <cal/il/opt/cal_il_cost.hpp>
 #ifdef __CAL_THREADSAFE
   #include <boost/thread/tss.hpp>
 #endif
@@ -57,17 +61,21 @@ public:
             arg_info( int _type, int _id ) : type(_type), id(_id) {}
         };
         
-        std::string                             source;
+        detail::instruction_stream              source;
         std::vector<arg_info>                   arg;
         std::vector<boost::function<void ()> >  change_var;
         std::vector<boost::function<void ()> >  undo_var;
         int                                     fid;
+        int                                     inline_policy;  // CAL_INLINE_*
+        bool                                    inlined;        // all calls replaced by body
+
+        func_info() : fid(0), inline_policy(CAL_INLINE_AUTO), inlined(false) {}
     
         template<class T>
         std::string pre_call( int idx, const T& v )
         {
             if( arg[idx].type==ARG_INOUT || arg[idx].type==ARG_IN ) {
-                return (boost::format("mov r%i,%s\n") % arg[idx].id % v.resultCode()).str();
+                return (detail::il_format("mov r%i,%s\n") % arg[idx].id % v.resultCode()).str();
             }
         
             return "";
@@ -77,15 +85,15 @@ public:
         std::string post_call( int idx, const T& v )
         {
             if( arg[idx].type==ARG_INOUT || arg[idx].type==ARG_OUT ) {
-                return (boost::format("mov %s,r%i\n") % v.resultCode() % arg[idx].id).str();
+                return (detail::il_format("mov %s,r%i\n") % v.resultCode() % arg[idx].id).str();
             }
         
             return "";
         }
         
-        void add_source( const std::string& _source )
+        void add_source( const char* _source, std::string::size_type length )
         {
-            if( !undo_var.empty() ) source += _source;
+            if( !undo_var.empty() ) source.append(_source,length);
         }
     
         void make_changes()
@@ -107,6 +115,11 @@ public:
     {
         int  emit_ieee;
         int  available;        
+        int  optimize;              // CAL_OPT_* passes run by Source::end
+        int  inline_size;           // il_func with at most this many instructions is inlined by CAL_OPT_INLINE
+        int  inline_calls;          // il_func with at most this many calls is inlined ( single call always )
+        int  schedule_registers;    // live vec4 registers allowed by CAL_OPT_SCHEDULE ( 0 - default 32 )
+        int  host;                  // kernel is generated for host interpreter ( Source::begin_host )
 
 #if defined(__CAL_HPP__) || defined(__CAL_H__)        
         CALtarget  target;
@@ -143,16 +156,27 @@ public:
 
 protected:
     typedef std::map<std::string,func_info>                 func_map;
+    typedef boost::array<boost::uint32_t,4>                 literal_data_type;
+
+    struct literal_info
+    {
+        literal_data_type   data;
+        int                 used;       // mask of lanes holding values
+    };
 
 protected:
     unsigned                                                next_instruction_index;
-    int                                                     next_literal_index;
     int                                                     next_func_index;
+    int                                                     next_indexed_temp_index;
     std::map<std::string,boost::function<std::string ()> >  dcl_data;
-    std::map<boost::array<boost::uint32_t,4>,int>           literal_data;
+    std::vector<literal_info>                               literal_pool;   // dcl_literal by index
+    std::map<literal_data_type,int>                         literal_data;   // literals used as whole
+    std::map<std::pair<literal_data_type,int>,std::string>  literal_code;   // packed values
     func_map                                                func_data;
     std::vector<typename func_map::iterator>                func_stack;
-    std::string                                             source;
+    detail::instruction_stream                              source;
+    optimize_info                                           optimize_data;
+    std::string                                             format_buffer;
 
 protected:
 #ifdef __CAL_THREADSAFE
@@ -171,9 +195,15 @@ protected:
             _out << idcl->second() << "\n";
         }
 
-        std::map<boost::array<boost::uint32_t,4>,int>::iterator    iliteral;
-        for(iliteral=literal_data.begin();iliteral!=literal_data.end();++iliteral) {
-            _out << boost::format("dcl_literal l%i, 0x%x, 0x%x, 0x%x, 0x%x\n") % iliteral->second % iliteral->first[0] % iliteral->first[1] % iliteral->first[2] % iliteral->first[3];
+        for(unsigned l=0;l<literal_pool.size();l++) {
+            format_buffer = "dcl_literal l";
+            detail::append_int(format_buffer,l);
+            for(int i=0;i<4;i++) {
+                format_buffer += ", 0x";
+                detail::append_hex(format_buffer,literal_pool[l].data[i]);
+            }
+            format_buffer += '\n';
+            _out.write(format_buffer.data(),format_buffer.length());
         }
     }
 
@@ -181,21 +211,133 @@ protected:
     {
         typename func_map::iterator  ifunc;
         
-        _out << source;
+        source.emit(_out);
         
         for(ifunc=func_data.begin();ifunc!=func_data.end();++ifunc) {
-            _out << boost::format("func %i\n") % ifunc->second.fid;
-            _out << ifunc->second.source;
+            if( ifunc->second.inlined ) continue;
+            _out << "func " << ifunc->second.fid << "\n";
+            ifunc->second.source.emit(_out);
             _out << "ret\nendfunc\n";
         }
         
         _out << "end\n";        
     }
     
+    static void flush( detail::instruction_stream& s )
+    {
+        if( !s.text.empty() && s.text[s.text.length()-1]!='\n' ) s.append("\n");
+    }
+
+    void iOptimize( int flags )
+    {
+        typename func_map::iterator                                 ifunc;
+        detail::instruction_list                                    code;
+        detail::optimize_target                                     target;
+        unsigned                                                    i;
+
+        flush(source);
+        code = source.instructions();
+        for(ifunc=func_data.begin();ifunc!=func_data.end();++ifunc) {
+            flush(ifunc->second.source);
+            const detail::instruction_list& body = ifunc->second.source.instructions();
+
+            format_buffer = "func ";
+            detail::append_int(format_buffer,ifunc->second.fid);
+            code.push_back( detail::parse_instruction(format_buffer) );
+            code.insert(code.end(),body.begin(),body.end());
+            code.push_back( detail::parse_instruction("ret") );
+            code.push_back( detail::parse_instruction("endfunc") );
+        }
+
+        for(ifunc=func_data.begin();ifunc!=func_data.end();++ifunc) target.inline_policy[ifunc->second.fid] = ifunc->second.inline_policy;
+        target.inline_size  = info().inline_size;
+        target.inline_calls = info().inline_calls;
+        if( info().schedule_registers>0 ) target.schedule_registers = info().schedule_registers;
+
+        for(i=0;i<literal_pool.size();i++) target.literal[i] = literal_pool[i].data;
+
+        // mad/dmad are not IEEE compliant, fma is used when requested and supported by target
+        target.fuse = detail::FUSE_INTEGER;
+        if( !info().emit_ieee ) {
+            target.fuse |= detail::FUSE_FLOAT;
+#if defined(__CAL_HPP__) || defined(__CAL_H__)
+#if defined(__CAL_USE_AUTOFMA)
+            if( info().available && info().target>=CAL_TARGET_CYPRESS ) target.fuse |= detail::FUSE_FMA;
+#endif
+            if( !info().available || info().doublePrecision ) target.fuse |= detail::FUSE_DOUBLE;
+#else
+            target.fuse |= detail::FUSE_DOUBLE;
+#endif
+        }
+
+        detail::optimize(code,flags,optimize_data,target);
+
+        // split code back into main and function bodies, functions without body were inlined
+        for(i=0;i<code.size() && detail::flow_type(code[i])!=detail::FLOW_FUNC;i++);
+        source.code.assign(code.begin(),code.begin()+i);
+
+        for(ifunc=func_data.begin();ifunc!=func_data.end();++ifunc) {
+            ifunc->second.source.code.clear();
+            ifunc->second.inlined = true;
+        }
+
+        while( i<code.size() ) {
+            int         fid = detail::call_target(code[i]);
+            unsigned    end = i+1;
+
+            assert( detail::flow_type(code[i])==detail::FLOW_FUNC );
+            while( end<code.size() && detail::flow_type(code[end])!=detail::FLOW_ENDFUNC ) end++;
+
+            for(ifunc=func_data.begin();ifunc!=func_data.end() && ifunc->second.fid!=fid;++ifunc);
+            assert( ifunc!=func_data.end() );
+
+            ifunc->second.source.code.assign(code.begin()+i+1,code.begin()+end-1);
+            ifunc->second.inlined = false;
+            i = end+1;
+        }
+    }
+
+    //
+    // places units of data into literal p, lanes with the same value are shared
+    // slot[u] receives position of unit u, added number of newly used slots
+    //
+
+    static bool fitLiteral( literal_info& p, const literal_data_type& data, int units, int width, int* slot, int& added )
+    {
+        int u,k,s,c,mask,slots=4/width;
+
+        added = 0;
+        for(u=0;u<units;u++) {
+            // same position first, whole literal matches without swizzle
+            for(k=0;k<slots;k++) {
+                s = (u+k)%slots;
+                mask = ((1<<width)-1)<<(s*width);
+                if( (p.used&mask)!=mask ) continue;
+
+                for(c=0;c<width && p.data[s*width+c]==data[u*width+c];c++);
+                if( c==width ) break;
+            }
+
+            if( k==slots ) {
+                for(s=0;s<slots && (p.used&(((1<<width)-1)<<(s*width)));s++);
+                if( s==slots ) return false;
+
+                for(c=0;c<width;c++) p.data[s*width+c] = data[u*width+c];
+                p.used |= ((1<<width)-1)<<(s*width);
+                added++;
+            }
+
+            slot[u] = s;
+        }
+
+        return true;
+    }
+
     void iEnd()
     {
         assert( next_func_index>=1 ); // calling without Source::begin
-        if( !func_data.empty() ) source += "endmain\n";
+        if( !func_data.empty() ) source.append("endmain\n");
+        if( info().optimize ) iOptimize(info().optimize);
         next_func_index=-1;        
     }
 
@@ -203,8 +345,9 @@ public:
     SourceGenerator()
     {
         next_instruction_index=0;
-        next_literal_index = 0; 
         next_func_index = -1;
+        next_indexed_temp_index=0;
+        std::memset( &optimize_data, 0, sizeof(optimize_data) );
     }
     ~SourceGenerator()
     {
@@ -213,21 +356,24 @@ public:
     void clear()
     {
         next_instruction_index=0;
-        next_literal_index=0;
         next_func_index=1;
+        next_indexed_temp_index=0;
 
         dcl_data.clear();
+        literal_pool.clear();
         literal_data.clear();
+        literal_code.clear();
         func_data.clear();
         func_stack.clear();
 
         source.clear();
+        std::memset( &optimize_data, 0, sizeof(optimize_data) );
 
-        boost::array<boost::uint32_t,4>    data;
+        literal_data_type   data;
         data.assign(0);
-        literal_data[data]=next_literal_index++;        
+        getLiteral(data);
         data.assign(0xFFFFFFFF);
-        literal_data[data]=next_literal_index++;        
+        getLiteral(data);
     }
 
     unsigned getNewID( unsigned count )
@@ -239,20 +385,90 @@ public:
         return v;
     }
 
+    //
+    // id of new indexed temporary array ( x# )
+    //
+
+    int getNewIndexedTemp()
+    {
+        assert( next_func_index>=1 ); // creating variables before call to Source::begin
+        return next_indexed_temp_index++;
+    }
+
     void registerDCL( const std::string& idx, const boost::function<std::string ()>& dcl )
     {
         dcl_data[idx] = dcl;
     }
 
-    int getLiteral( const boost::array<boost::uint32_t,4>& data )
+    //
+    // literal used as whole register ( all 4 lanes )
+    //
+
+    int getLiteral( const literal_data_type& data )
     {
-        std::map<boost::array<boost::uint32_t,4>,int>::iterator    idata;
+        std::map<literal_data_type,int>::iterator   idata;
+        literal_info                                l;
 
         idata = literal_data.find(data);
         if( idata!=literal_data.end() ) return idata->second;
 
-        literal_data[data] = next_literal_index;
-        return next_literal_index++;
+        l.data = data;
+        l.used = 0xF;
+        literal_pool.push_back(l);
+
+        literal_data[data] = literal_pool.size()-1;
+        return literal_pool.size()-1;
+    }
+
+    //
+    // literal value of size lanes made of units of width lanes ( 1 for 32-bit, 2 for double )
+    // units are packed into free lanes of existing literals or reuse lanes with the same value
+    // returns literal register with swizzle selecting the value ( "l3.zw", "l2.y" )
+    //
+
+    std::string getLiteral( const literal_data_type& data, int size, int width )
+    {
+        typename std::map<std::pair<literal_data_type,int>,std::string>::iterator   icode;
+        std::pair<literal_data_type,int>                                            key;
+        int                                                                         slot[4],best_slot[4],lane[4];
+        int                                                                         l,u,c,added,best=-1,best_added=5;
+
+        assert( size>0 && size<=4 && (width==1 || width==2) && size%width==0 );
+
+        key.first.assign(0);
+        for(c=0;c<size;c++) key.first[c] = data[c];
+        key.second = size*4+width;
+
+        icode = literal_code.find(key);
+        if( icode!=literal_code.end() ) return icode->second;
+
+        for(l=0;l<(int)literal_pool.size() && best_added>0;l++) {
+            literal_info p = literal_pool[l];
+
+            if( !fitLiteral(p,key.first,size/width,width,slot,added) || added>=best_added ) continue;
+
+            best = l;
+            best_added = added;
+            std::memcpy(best_slot,slot,sizeof(slot));
+        }
+
+        if( best<0 ) {
+            literal_info p;
+            p.data.assign(0);
+            p.used = 0;
+
+            literal_pool.push_back(p);
+            best = literal_pool.size()-1;
+        }
+
+        fitLiteral(literal_pool[best],key.first,size/width,width,best_slot,added);
+
+        for(u=0;u<size/width;u++) {
+            for(c=0;c<width;c++) lane[u*width+c] = best_slot[u]*width+c+1;
+        }
+        for(c=size;c<4;c++) lane[c] = 0;
+
+        return literal_code[key] = detail::make_swizzle(detail::make_register('l',best),lane[0],lane[1],lane[2],lane[3]);
     }
     
     bool isFuncAvailable( const std::string& name ) const
@@ -292,16 +508,60 @@ public:
         func_stack.pop_back();
     }
 
+    SourceGenerator<N>& append( const char* r, std::string::size_type length )
+    {
+        if( func_stack.empty() ) source.append(r,length);
+        else func_stack.back()->second.add_source(r,length);
+
+        return *this;
+    }
+
+    SourceGenerator<N>& operator<<( const std::string& r )
+    {
+        return append(r.data(),r.length());
+    }
+
+    SourceGenerator<N>& operator<<( const char* r )
+    {
+        return append(r,std::strlen(r));
+    }
+
+    SourceGenerator<N>& operator<<( const detail::il_format& r )
+    {
+        format_buffer.clear();
+        r.append_to(format_buffer);
+
+        return append(format_buffer.data(),format_buffer.length());
+    }
+
+    SourceGenerator<N>& operator<<( const boost::format& r )
+    {
+        return *this << r.str();
+    }
+
+    SourceGenerator<N>& operator<<( int r )
+    {
+        format_buffer.clear();
+        detail::append_int(format_buffer,r);
+
+        return append(format_buffer.data(),format_buffer.length());
+    }
+
+    SourceGenerator<N>& operator<<( unsigned r )
+    {
+        format_buffer.clear();
+        detail::append_uint(format_buffer,r);
+
+        return append(format_buffer.data(),format_buffer.length());
+    }
+
     template<class T>
     SourceGenerator<N>& operator<<( const T& r )
     {
         std::stringstream    str;
         str << r;
 
-        if( func_stack.empty() ) source += str.str();
-        else func_stack.back()->second.add_source(str.str());
-
-        return *this;
+        return *this << str.str();
     }
 
     static void begin()
@@ -310,6 +570,18 @@ public:
         std::memset( &info(), 0, sizeof(state_info) );
     }
 
+    //
+    // kernel is generated for host interpreter ( cal/cal_il_host.hpp ) instead of GPU
+    // kernel functions can test info().host, passes which shorten interpreted code are enabled
+    //
+
+    static void begin_host()
+    {
+        begin();
+        info().host     = 1;
+        info().optimize = CAL_OPT_INLINE|CAL_OPT_FOLD|CAL_OPT_CSE|CAL_OPT_COPYPROP|CAL_OPT_DCE|CAL_OPT_MAD|CAL_OPT_SLP|CAL_OPT_REGALLOC;
+    }
+
 #if defined(__CAL_H__)
     static void begin( CALuint ordinal )
     {
@@ -375,6 +647,34 @@ public:
         code().iemitCode(_out);
     }
 
+    static const optimize_info& stats()
+    {
+        return code().optimize_data;
+    }
+
+    //
+    // static cost of generated kernel ( call after end )
+    // device limits are used when Source was started with device
+    //
+
+    static kernel_cost cost()
+    {
+        std::stringstream   s;
+        int                 wavefront_size=64,simd_count=0;
+
+        code().iemitHeader(s);
+        code().iemitCode(s);
+
+#if defined(__CAL_HPP__) || defined(__CAL_H__)
+        if( info().available ) {
+            wavefront_size = info().wavefrontSize;
+            simd_count     = info().numberOfSIMD;
+        }
+#endif
+
+        return estimate_cost(s.str(),wavefront_size,simd_count);
+    }
+
     static SourceGenerator<N>& code() 
     {
 #ifdef __CAL_THREADSAFE
@@ -23,9 +23,10 @@
 #ifndef __CAL_IL_TYPES_H
 #define __CAL_IL_TYPES_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
+#include <boost/bind.hpp>
 
 namespace cal {
 namespace il {
@@ -63,7 +64,7 @@ protected:
     {
         e.emitCode();
         emitCode();
-        Source::code() << boost::format("mov %s,%s\n") % resultCode() % e.resultCode();
+        Source::code() << detail::il_format("mov %s,%s\n") % resultCode() % e.resultCode();
     }
 
 public:
@@ -84,7 +85,7 @@ public:
 
     std::string resultCode() const
     {
-        return (boost::format("%s[%s]") % _reg_name % _e.resultCode()).str();
+        return (detail::il_format("%s[%s]") % _reg_name % _e.resultCode()).str();
     }
 
     indexed_expression<T,E>& operator=( const indexed_expression<T,E>& v )
@@ -176,6 +177,9 @@ protected:
     data_type _data;
     using base_type::index;
 
+public:
+    typedef boost::array<component_type,value_type::component_count>   array_type;
+
 public:
     explicit value( const component_type& v0 ) : base_type()
     {
@@ -205,6 +209,11 @@ public:
         _data.base[2] = v2;
         _data.base[3] = v3;
     }
+    explicit value( const array_type& v ) : base_type()
+    {
+        _data.hex.assign(0);
+        _data.base = v;
+    }
     value( const value<T>& rhs ) : base_type(rhs), _data(rhs._data)
     {
     }
@@ -218,9 +227,10 @@ public:
 
     std::string resultCode() const
     {
-        int     idx = Source::code().getLiteral( _data.hex );
-        return detail::make_swizzle( (boost::format("l%i") % idx).str(), value_type::type_size );
+        return Source::code().getLiteral( _data.hex, value_type::type_size, sizeof(component_type)/sizeof(boost::uint32_t) );
     }
+
+    const array_type& getData() const { return _data.base; }
 };
 
 template<class T>
@@ -254,7 +264,7 @@ protected:
     void iEmitCode( const E& e ) const
     {
         e.emitCode();
-        Source::code() << boost::format("mov %s,%s\n") % resultCode() % e.resultCode();
+        Source::code() << detail::il_format("mov %s,%s\n") % resultCode() % e.resultCode();
     }
 
 public:
@@ -509,7 +519,7 @@ protected:
     void iEmitCode( const E& e ) const
     {
         e.emitCode();
-        Source::code() << boost::format("mov %s,%s\n") % detail::mask_output(resultCode()) % detail::match_input_to_output(resultCode(),e.resultCode());
+        Source::code() << detail::il_format("mov %s,%s\n") % detail::mask_output(resultCode()) % detail::match_input_to_output(resultCode(),e.resultCode());
     }
 
 public:
@@ -629,6 +639,102 @@ public:
     ~global() {}
 };
 
+//
+// per thread array of N registers ( dcl_indexed_temp_array ) indexed with constants or int1/uint1 expressions
+// array which does not fit into 128 GPRs is placed by CAL compiler in scratch memory, comment in IL warns about it
+//
+
+template<class T,int N>
+class local_array : public indexed_register<T>
+{
+protected:
+    static std::string emit_dcl( int id )
+    {
+        return (detail::il_format("dcl_indexed_temp_array x%i[%i]") % id % N).str();
+    }
+
+    static std::string make_name()
+    {
+        int id = Source::code().getNewIndexedTemp();
+
+        Source::code().registerDCL( (detail::il_format("x:%i") % id).str(),
+                                    boost::bind(&local_array<T,N>::emit_dcl,id) );
+        if( N>detail::COST_MAX_GPR ) {
+            Source::code() << detail::il_format("; warning: x%i[%i] exceeds %i registers and is placed in scratch memory\n") % id % N % detail::COST_MAX_GPR;
+        }
+
+        return (detail::il_format("x%i") % id).str();
+    }
+
+public:
+    typedef typename indexed_register<T>::value_type    value_type;
+    static const int                                    size=N;
+
+public:
+    using indexed_register<T>::operator[];
+    using indexed_register<T>::operator();
+
+    local_array() : indexed_register<T>(make_name())
+    {
+        BOOST_STATIC_ASSERT( N>0 );
+    }
+    ~local_array() {}
+
+    //
+    // index is copied into temporary register ( IL does not accept nested indexing or input registers as index )
+    //
+
+    template<class E>
+    detail::indexed_expression<value_type,detail::register_address<variable<typename E::value_type> > > operator[]( const detail::binary<E,detail::value<E>,detail::cal_binary_add<typename E::value_type,typename E::value_type> >& e ) const
+    {
+        typedef boost::is_same<typename E::value_type,int_type> assert_v1;
+        typedef boost::is_same<typename E::value_type,uint_type> assert_v2;
+        BOOST_STATIC_ASSERT( assert_v1::value || assert_v2::value );
+
+        variable<typename E::value_type> idx(e._e1);
+        return detail::indexed_expression<value_type,detail::register_address<variable<typename E::value_type> > >( this->_reg_name, detail::register_address<variable<typename E::value_type> >(idx, e._e2.getValue()) );
+    }
+
+    template<class E>
+    detail::indexed_expression<value_type,detail::register_address<variable<typename E::value_type> > > operator()( const detail::binary<E,detail::value<E>,detail::cal_binary_add<typename E::value_type,typename E::value_type> >& e ) const
+    {
+        return (*this)[e];
+    }
+
+    template<class E>
+    detail::indexed_expression<value_type,variable<typename E::value_type> > operator[]( const detail::expression<E>& e ) const
+    {
+        typedef boost::is_same<typename E::value_type,int_type> assert_v1;
+        typedef boost::is_same<typename E::value_type,uint_type> assert_v2;
+        BOOST_STATIC_ASSERT( assert_v1::value || assert_v2::value );
+
+        variable<typename E::value_type> idx(e);
+        return detail::indexed_expression<value_type,variable<typename E::value_type> >(this->_reg_name,idx);
+    }
+
+    template<class E>
+    detail::indexed_expression<value_type,variable<typename E::value_type> > operator()( const detail::expression<E>& e ) const
+    {
+        return (*this)[e];
+    }
+
+    template<class E>
+    detail::indexed_expression<value_type,variable<E> > operator[]( const variable<E>& e ) const
+    {
+        typedef boost::is_same<E,int_type> assert_v1;
+        typedef boost::is_same<E,uint_type> assert_v2;
+        BOOST_STATIC_ASSERT( assert_v1::value || assert_v2::value );
+
+        return detail::indexed_expression<value_type,variable<E> >(this->_reg_name,e);
+    }
+
+    template<class E>
+    detail::indexed_expression<value_type,variable<E> > operator()( const variable<E>& e ) const
+    {
+        return (*this)[e];
+    }
+};
+
 typedef variable<int_type>      int1;
 typedef variable<int2_type>     int2;
 typedef variable<int4_type>     int4;
@@ -23,7 +23,7 @@
 #ifndef __CAL_IL_UAV_H
 #define __CAL_IL_UAV_H
 
-#include <boost/format.hpp>
+#include <cal/il/cal_il_format.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits.hpp>
 #include <boost/bind.hpp>
@@ -69,7 +69,7 @@ public:
     {
         e1.emitCode();
         _e.emitCode();
-        Source::code() << boost::format(src) % uav_index % _e.resultCode() % e1.resultCode();
+        Source::code() << detail::il_format(src) % uav_index % _e.resultCode() % e1.resultCode();
     }
 
     template<class E1,class E2>
@@ -78,7 +78,7 @@ public:
         e1.emitCode();
         e2.emitCode();
         _e.emitCode();
-        Source::code() << boost::format(src) % uav_index % _e.resultCode() % e1.resultCode() % e2.resultCode();
+        Source::code() << detail::il_format(src) % uav_index % _e.resultCode() % e1.resultCode() % e2.resultCode();
     }
 
     template<class E1,class E2,class E3>
@@ -88,7 +88,7 @@ public:
         e2.emitCode();
         e3.emitCode();
         _e.emitCode();
-        Source::code() << boost::format(src) % uav_index % _e.resultCode() % e1.resultCode() % e2.resultCode() % e3.resultCode();
+        Source::code() << detail::il_format(src) % uav_index % _e.resultCode() % e1.resultCode() % e2.resultCode() % e3.resultCode();
     }
 };
 
@@ -130,16 +130,16 @@ protected:
 
         switch( T::type_size ) {
         case 1:
-            Source::code() << boost::format("%4%(%1%) mem.x,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
+            Source::code() << detail::il_format("%4%(%1%) mem.x,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
             break;
         case 2:
-            Source::code() << boost::format("%4%(%1%) mem.xy,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
+            Source::code() << detail::il_format("%4%(%1%) mem.xy,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
             break;
         case 3:
-            Source::code() << boost::format("%4%(%1%) mem.xyz,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
+            Source::code() << detail::il_format("%4%(%1%) mem.xyz,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
             break;
         default:
-            Source::code() << boost::format("%4%(%1%) mem.xyzw,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
+            Source::code() << detail::il_format("%4%(%1%) mem.xyzw,%2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode() % uav_store;
         }
     }
 
@@ -156,7 +156,7 @@ public:
 
     void emitCode() const
     {
-        std::string rout = (boost::format("r%i") % index).str();
+        std::string rout = detail::make_register('r',index);
         std::string caching;
         
         if( uav_caching==UAV_CACHED   ) caching = "_cached";
@@ -166,19 +166,19 @@ public:
 
         switch( T::type_size ) {
         case 1:
-            Source::code() << boost::format("%6%(%1%)%7% r%4%.x___,%3%\n"
+            Source::code() << detail::il_format("%6%(%1%)%7% r%4%.x___,%3%\n"
                                            "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".x") % uav_load % caching;
             break;
         case 2:
-            Source::code() << boost::format("%6%(%1%)%7% r%4%.xy__,%3%\n"
+            Source::code() << detail::il_format("%6%(%1%)%7% r%4%.xy__,%3%\n"
                                            "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".xy") % uav_load % caching;
             break;
         case 3:
-            Source::code() << boost::format("%6%(%1%)%7% r%4%.xyz_,%3%\n"
+            Source::code() << detail::il_format("%6%(%1%)%7% r%4%.xyz_,%3%\n"
                                            "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".xyz") % uav_load % caching;
             break;
         default:
-            Source::code() << boost::format("%6%(%1%)%7% r%4%.xyzw,%3%\n"
+            Source::code() << detail::il_format("%6%(%1%)%7% r%4%.xyzw,%3%\n"
                                            "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".xyzw") % uav_load % caching;
             break;
         }
@@ -250,16 +250,16 @@ protected:
 
         switch( T::type_size ) {
         case 1:
-            Source::code() << boost::format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
+            Source::code() << detail::il_format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
             break;
         case 2:
-            Source::code() << boost::format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
+            Source::code() << detail::il_format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
             break;
         case 3:
-            Source::code() << boost::format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
+            Source::code() << detail::il_format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
             break;
         default:
-            Source::code() << boost::format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
+            Source::code() << detail::il_format("uav_store_id(%1%) %2%,%3%\n") %  uav_index % _e.resultCode() % e.resultCode();
         }
     }
 
@@ -276,7 +276,7 @@ public:
 
     void emitCode() const
     {
-        std::string rout = (boost::format("r%i") % index).str();
+        std::string rout = detail::make_register('r',index);
         std::string caching;
         
         if( uav_caching==UAV_CACHED   ) caching = "_cached";
@@ -286,19 +286,19 @@ public:
 
         switch( T::type_size ) {
         case 1:
-            Source::code() << boost::format("uav_load_id(%1%)%6% r%4%,%3%\n"
+            Source::code() << detail::il_format("uav_load_id(%1%)%6% r%4%,%3%\n"
                                             "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".x") % caching;
             break;
         case 2:
-            Source::code() << boost::format("uav_load_id(%1%)%6% r%4%,%3%\n"
+            Source::code() << detail::il_format("uav_load_id(%1%)%6% r%4%,%3%\n"
                                             "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".xy") % caching;
             break;
         case 3:
-            Source::code() << boost::format("uav_load_id(%1%)%6% r%4%,%3%\n"
+            Source::code() << detail::il_format("uav_load_id(%1%)%6% r%4%,%3%\n"
                                             "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".xyz") % caching;
             break;
         default:
-            Source::code() << boost::format("uav_load_id(%1%)%6% r%4%,%3%\n"
+            Source::code() << detail::il_format("uav_load_id(%1%)%6% r%4%,%3%\n"
                                             "mov %2%,%5%\n") % uav_index % detail::mask_output(resultCode()) % _e.resultCode() % index % detail::match_input_to_output(resultCode(),rout+".xyzw") % caching;
             break;
         }
@@ -351,7 +351,7 @@ protected:
 protected:
     static std::string emit_dcl( int id )
     {
-        return (boost::format("dcl_raw_uav_id(%i)") % id).str();
+        return (detail::il_format("dcl_raw_uav_id(%i)") % id).str();
     }
 
 public:
@@ -360,7 +360,7 @@ public:
         assert( idx>=0 );
         uav_index   = idx;
         uav_caching = caching;
-        Source::code().registerDCL( (boost::format("uav:%i") % idx).str(),
+        Source::code().registerDCL( (detail::il_format("uav:%i") % idx).str(),
                                     boost::bind(&uav_raw<T>::emit_dcl,idx) );
     }
 
@@ -410,7 +410,7 @@ protected:
 protected:
     static std::string emit_dcl( int id, int stride )
     {
-        return (boost::format("dcl_struct_uav_id(%i) %i") % id % stride).str();
+        return (detail::il_format("dcl_struct_uav_id(%i) %i") % id % stride).str();
     }
 
 public:
@@ -419,7 +419,7 @@ public:
         assert( idx>=0 && stride>0 && (stride%4)==0 );
         uav_index   = idx;
         uav_caching = caching;
-        Source::code().registerDCL( (boost::format("uav:%i") % idx).str(), 
+        Source::code().registerDCL( (detail::il_format("uav:%i") % idx).str(), 
                                     boost::bind(&uav_struct<T>::emit_dcl,idx,stride) );
     }
 
@@ -507,7 +507,7 @@ protected:
 
     static std::string emit_dcl( int id, const std::string& type, const std::string& format )
     {
-        return (boost::format("dcl_uav_id(%i)_type(%s)_fmtx(%s)") % id % type % format).str();
+        return (detail::il_format("dcl_uav_id(%i)_type(%s)_fmtx(%s)") % id % type % format).str();
     }
 
 public:
@@ -518,7 +518,7 @@ public:
         uav_caching = caching;
 
         std::string format = getFormatName(typename detail::base_cal_type<T>::value());
-        Source::code().registerDCL( (boost::format("uav:%i") % idx).str(), 
+        Source::code().registerDCL( (detail::il_format("uav:%i") % idx).str(), 
                                     boost::bind(&uav<T>::emit_dcl,idx,type,format) );
     }
 
@@ -527,7 +527,7 @@ public:
         assert( idx>=0 );
         uav_index   = idx;
         uav_caching = caching;
-        Source::code().registerDCL( (boost::format("uav:%i") % idx).str(),
+        Source::code().registerDCL( (detail::il_format("uav:%i") % idx).str(),
                                     boost::bind(&uav<T>::emit_dcl,idx,type,format) );
     }
 
@@ -0,0 +1,389 @@
+/*
+ * C++ to IL compiler/generator ALU operations of host interpreter
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_HOST_ALU_H
+#define __CAL_IL_HOST_ALU_H
+
+#include <cmath>
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+namespace detail {
+
+//
+// one component of one lane
+//
+
+union host_word
+{
+    boost::uint32_t u;
+    boost::int32_t  i;
+    float           f;
+};
+
+union host_double
+{
+    boost::uint64_t u;
+    double          d;
+};
+
+inline double make_double( host_word lo, host_word hi )
+{
+    host_double r;
+    r.u = ((boost::uint64_t)hi.u<<32) | lo.u;
+    return r.d;
+}
+
+inline void split_double( double d, host_word& lo, host_word& hi )
+{
+    host_double r;
+    r.d  = d;
+    lo.u = (boost::uint32_t)r.u;
+    hi.u = (boost::uint32_t)(r.u>>32);
+}
+
+inline boost::uint32_t bool_mask( bool c )
+{
+    return c ? 0xFFFFFFFFu : 0u;
+}
+
+//
+// float
+//
+
+struct alu_mov  { static void apply( host_word& d, host_word a ) { d = a; } };
+struct alu_abs  { static void apply( host_word& d, host_word a ) { d.u = a.u&0x7FFFFFFFu; } };
+struct alu_frc  { static void apply( host_word& d, host_word a ) { d.f = a.f-std::floor(a.f); } };
+struct alu_flr  { static void apply( host_word& d, host_word a ) { d.f = std::floor(a.f); } };
+struct alu_rnd  { static void apply( host_word& d, host_word a ) { float t = std::floor(a.f+0.5f); d.f = (t-a.f==0.5f && std::fmod(t,2.0f)!=0) ? t-1.0f : t; } };
+struct alu_sqrt { static void apply( host_word& d, host_word a ) { d.f = std::sqrt(a.f); } };
+struct alu_rsq  { static void apply( host_word& d, host_word a ) { d.f = 1.0f/std::sqrt(std::fabs(a.f)); } };
+struct alu_rcp  { static void apply( host_word& d, host_word a ) { d.f = 1.0f/a.f; } };
+struct alu_exn  { static void apply( host_word& d, host_word a ) { d.f = std::exp(a.f); } };
+struct alu_ln   { static void apply( host_word& d, host_word a ) { d.f = std::log(a.f); } };
+struct alu_exp  { static void apply( host_word& d, host_word a ) { d.f = std::pow(2.0f,a.f); } };
+struct alu_log  { static void apply( host_word& d, host_word a ) { d.f = std::log(a.f)/0.693147180559945f; } };
+struct alu_sin  { static void apply( host_word& d, host_word a ) { d.f = std::sin(a.f); } };
+struct alu_cos  { static void apply( host_word& d, host_word a ) { d.f = std::cos(a.f); } };
+
+struct alu_add  { static void apply( host_word& d, host_word a, host_word b ) { d.f = a.f+b.f; } };
+struct alu_sub  { static void apply( host_word& d, host_word a, host_word b ) { d.f = a.f-b.f; } };
+struct alu_mul  { static void apply( host_word& d, host_word a, host_word b ) { d.f = a.f*b.f; } };
+struct alu_div  { static void apply( host_word& d, host_word a, host_word b ) { d.f = a.f/b.f; } };
+struct alu_mod  { static void apply( host_word& d, host_word a, host_word b ) { d.f = std::fmod(a.f,b.f); } };
+struct alu_min  { static void apply( host_word& d, host_word a, host_word b ) { d.f = (b.f<a.f || a.f!=a.f) ? b.f : a.f; } };
+struct alu_max  { static void apply( host_word& d, host_word a, host_word b ) { d.f = (b.f>a.f || a.f!=a.f) ? b.f : a.f; } };
+struct alu_eq   { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.f==b.f); } };
+struct alu_ne   { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.f!=b.f); } };
+struct alu_lt   { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.f<b.f); } };
+struct alu_ge   { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.f>=b.f); } };
+
+struct alu_mad  { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d.f = a.f*b.f+c.f; } };
+struct alu_fma  { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d.f = (float)((double)a.f*b.f+c.f); } };
+struct alu_cmov { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d = a.u ? b : c; } };
+
+//
+// integer
+//
+
+struct alu_inegate { static void apply( host_word& d, host_word a ) { d.u = 0u-a.u; } };
+struct alu_inot    { static void apply( host_word& d, host_word a ) { d.u = ~a.u; } };
+
+struct alu_iadd    { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u+b.u; } };
+struct alu_imul    { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u*b.u; } };
+struct alu_imul_high { static void apply( host_word& d, host_word a, host_word b ) { d.u = (boost::uint32_t)(((boost::int64_t)a.i*b.i)>>32); } };
+struct alu_umul_high { static void apply( host_word& d, host_word a, host_word b ) { d.u = (boost::uint32_t)(((boost::uint64_t)a.u*b.u)>>32); } };
+struct alu_udiv    { static void apply( host_word& d, host_word a, host_word b ) { d.u = b.u ? a.u/b.u : 0xFFFFFFFFu; } };
+struct alu_umod    { static void apply( host_word& d, host_word a, host_word b ) { d.u = b.u ? a.u%b.u : 0xFFFFFFFFu; } };
+struct alu_iand    { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u&b.u; } };
+struct alu_ior     { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u|b.u; } };
+struct alu_ixor    { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u^b.u; } };
+struct alu_ishl    { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u<<(b.u&31); } };
+struct alu_ishr    { static void apply( host_word& d, host_word a, host_word b ) { d.i = a.i>>(b.u&31); } };
+struct alu_ushr    { static void apply( host_word& d, host_word a, host_word b ) { d.u = a.u>>(b.u&31); } };
+struct alu_ieq     { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.u==b.u); } };
+struct alu_ine     { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.u!=b.u); } };
+struct alu_ilt     { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.i<b.i); } };
+struct alu_ige     { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.i>=b.i); } };
+struct alu_ult     { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.u<b.u); } };
+struct alu_uge     { static void apply( host_word& d, host_word a, host_word b ) { d.u = bool_mask(a.u>=b.u); } };
+struct alu_imin    { static void apply( host_word& d, host_word a, host_word b ) { d = b.i<a.i ? b : a; } };
+struct alu_imax    { static void apply( host_word& d, host_word a, host_word b ) { d = b.i>a.i ? b : a; } };
+struct alu_umin    { static void apply( host_word& d, host_word a, host_word b ) { d = b.u<a.u ? b : a; } };
+struct alu_umax    { static void apply( host_word& d, host_word a, host_word b ) { d = b.u>a.u ? b : a; } };
+
+struct alu_imad    { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d.u = a.u*b.u+c.u; } };
+struct alu_bfi     { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d.u = (a.u&b.u) | (~a.u&c.u); } };
+
+// width a, offset b, value c
+struct alu_ubit_extract
+{
+    static void apply( host_word& d, host_word a, host_word b, host_word c )
+    {
+        boost::uint32_t w = a.u&31, o = b.u&31;
+
+        if( w==0 ) d.u = 0;
+        else if( w+o<32 ) d.u = (c.u<<(32-w-o))>>(32-w);
+        else d.u = c.u>>o;
+    }
+};
+
+struct alu_ibit_extract
+{
+    static void apply( host_word& d, host_word a, host_word b, host_word c )
+    {
+        boost::uint32_t w = a.u&31, o = b.u&31;
+
+        if( w==0 ) d.u = 0;
+        else if( w+o<32 ) d.i = (boost::int32_t)(c.u<<(32-w-o))>>(32-w);
+        else d.i = c.i>>o;
+    }
+};
+
+struct alu_bitalign  { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d.u = (boost::uint32_t)((((boost::uint64_t)a.u<<32)|b.u)>>(c.u&31)); } };
+struct alu_bytealign { static void apply( host_word& d, host_word a, host_word b, host_word c ) { d.u = (boost::uint32_t)((((boost::uint64_t)a.u<<32)|b.u)>>(8*(c.u&3))); } };
+
+//
+// conversion ( out of range values are clamped, NaN gives 0 )
+//
+
+struct alu_itof { static void apply( host_word& d, host_word a ) { d.f = (float)a.i; } };
+struct alu_utof { static void apply( host_word& d, host_word a ) { d.f = (float)a.u; } };
+
+struct alu_ftoi
+{
+    static void apply( host_word& d, host_word a )
+    {
+        if( a.f!=a.f ) d.i = 0;
+        else if( a.f>=2147483648.0f ) d.i = 0x7FFFFFFF;
+        else if( a.f<=-2147483648.0f ) d.u = 0x80000000u;
+        else d.i = (boost::int32_t)a.f;
+    }
+};
+
+struct alu_ftou
+{
+    static void apply( host_word& d, host_word a )
+    {
+        if( a.f!=a.f || a.f<=0.0f ) d.u = 0;
+        else if( a.f>=4294967296.0f ) d.u = 0xFFFFFFFFu;
+        else d.u = (boost::uint32_t)a.f;
+    }
+};
+
+//
+// double
+//
+
+struct alu_dadd  { static double apply( double a, double b ) { return a+b; } };
+struct alu_dmul  { static double apply( double a, double b ) { return a*b; } };
+struct alu_ddiv  { static double apply( double a, double b ) { return a/b; } };
+struct alu_dmin  { static double apply( double a, double b ) { return (b<a || a!=a) ? b : a; } };
+struct alu_dmax  { static double apply( double a, double b ) { return (b>a || a!=a) ? b : a; } };
+struct alu_dmad  { static double apply( double a, double b, double c ) { return a*b+c; } };
+struct alu_dfrac { static double apply( double a ) { return a-std::floor(a); } };
+struct alu_dsqrt { static double apply( double a ) { return std::sqrt(a); } };
+struct alu_drsq  { static double apply( double a ) { return 1.0/std::sqrt(a); } };
+struct alu_drcp  { static double apply( double a ) { return 1.0/a; } };
+struct alu_deq   { static bool apply( double a, double b ) { return a==b; } };
+struct alu_dne   { static bool apply( double a, double b ) { return a!=b; } };
+struct alu_dlt   { static bool apply( double a, double b ) { return a<b; } };
+struct alu_dge   { static bool apply( double a, double b ) { return a>=b; } };
+
+//
+// W lanes of one component computed at once with compiler vector extensions ( SSE/AVX registers )
+// CAL_IL_HOST_VECTOR_WIDTH sets W ( 4 for SSE, 8 for AVX ), other compilers compute lanes one by one
+//
+
+template<class F>
+struct alu_vector
+{
+    static const bool value = false;
+};
+
+#if defined(__GNUC__) && !defined(CAL_IL_HOST_NO_VECTOR)
+#ifndef CAL_IL_HOST_VECTOR_WIDTH
+  #if defined(__AVX__)
+    #define CAL_IL_HOST_VECTOR_WIDTH 8
+  #else
+    #define CAL_IL_HOST_VECTOR_WIDTH 4
+  #endif
+#endif
+
+static const int HOST_VECTOR_WIDTH = CAL_IL_HOST_VECTOR_WIDTH;
+
+typedef float           host_vector_float __attribute__((vector_size(4*CAL_IL_HOST_VECTOR_WIDTH)));
+typedef boost::uint32_t host_vector_uint  __attribute__((vector_size(4*CAL_IL_HOST_VECTOR_WIDTH)));
+typedef boost::int32_t  host_vector_int   __attribute__((vector_size(4*CAL_IL_HOST_VECTOR_WIDTH)));
+
+// casts between vector types keep bits, comparisons give 0 or -1 in every lane
+
+template<class T>
+inline T vector_select( host_vector_uint m, T a, T b )
+{
+    return (T)(((host_vector_uint)a&m) | ((host_vector_uint)b&~m));
+}
+
+#define CAL_IL_HOST_VECTOR1(F,T,EXPR) \
+template<> struct alu_vector<F> { static const bool value = true; typedef T type; \
+    static void apply( T& d, T a ) { d = (T)(EXPR); } };
+#define CAL_IL_HOST_VECTOR2(F,T,EXPR) \
+template<> struct alu_vector<F> { static const bool value = true; typedef T type; \
+    static void apply( T& d, T a, T b ) { d = (T)(EXPR); } };
+#define CAL_IL_HOST_VECTOR3(F,T,EXPR) \
+template<> struct alu_vector<F> { static const bool value = true; typedef T type; \
+    static void apply( T& d, T a, T b, T c ) { d = (T)(EXPR); } };
+
+CAL_IL_HOST_VECTOR1(alu_mov,     host_vector_uint,  a)
+CAL_IL_HOST_VECTOR1(alu_abs,     host_vector_uint,  a&0x7FFFFFFFu)
+CAL_IL_HOST_VECTOR2(alu_add,     host_vector_float, a+b)
+CAL_IL_HOST_VECTOR2(alu_sub,     host_vector_float, a-b)
+CAL_IL_HOST_VECTOR2(alu_mul,     host_vector_float, a*b)
+CAL_IL_HOST_VECTOR2(alu_div,     host_vector_float, a/b)
+CAL_IL_HOST_VECTOR2(alu_min,     host_vector_float, vector_select((host_vector_uint)((b<a)|(a!=a)),b,a))
+CAL_IL_HOST_VECTOR2(alu_max,     host_vector_float, vector_select((host_vector_uint)((b>a)|(a!=a)),b,a))
+CAL_IL_HOST_VECTOR2(alu_eq,      host_vector_float, a==b)
+CAL_IL_HOST_VECTOR2(alu_ne,      host_vector_float, a!=b)
+CAL_IL_HOST_VECTOR2(alu_lt,      host_vector_float, a<b)
+CAL_IL_HOST_VECTOR2(alu_ge,      host_vector_float, a>=b)
+CAL_IL_HOST_VECTOR3(alu_mad,     host_vector_float, a*b+c)
+CAL_IL_HOST_VECTOR3(alu_cmov,    host_vector_uint,  vector_select((host_vector_uint)(a!=0),b,c))
+
+CAL_IL_HOST_VECTOR1(alu_inegate, host_vector_uint,  -a)
+CAL_IL_HOST_VECTOR1(alu_inot,    host_vector_uint,  ~a)
+CAL_IL_HOST_VECTOR2(alu_iadd,    host_vector_uint,  a+b)
+CAL_IL_HOST_VECTOR2(alu_imul,    host_vector_uint,  a*b)
+CAL_IL_HOST_VECTOR2(alu_iand,    host_vector_uint,  a&b)
+CAL_IL_HOST_VECTOR2(alu_ior,     host_vector_uint,  a|b)
+CAL_IL_HOST_VECTOR2(alu_ixor,    host_vector_uint,  a^b)
+CAL_IL_HOST_VECTOR2(alu_ishl,    host_vector_uint,  a<<(b&31))
+CAL_IL_HOST_VECTOR2(alu_ishr,    host_vector_int,   a>>(b&31))
+CAL_IL_HOST_VECTOR2(alu_ushr,    host_vector_uint,  a>>(b&31))
+CAL_IL_HOST_VECTOR2(alu_ieq,     host_vector_uint,  a==b)
+CAL_IL_HOST_VECTOR2(alu_ine,     host_vector_uint,  a!=b)
+CAL_IL_HOST_VECTOR2(alu_ilt,     host_vector_int,   a<b)
+CAL_IL_HOST_VECTOR2(alu_ige,     host_vector_int,   a>=b)
+CAL_IL_HOST_VECTOR2(alu_ult,     host_vector_uint,  a<b)
+CAL_IL_HOST_VECTOR2(alu_uge,     host_vector_uint,  a>=b)
+CAL_IL_HOST_VECTOR2(alu_imin,    host_vector_int,   vector_select((host_vector_uint)(b<a),b,a))
+CAL_IL_HOST_VECTOR2(alu_imax,    host_vector_int,   vector_select((host_vector_uint)(b>a),b,a))
+CAL_IL_HOST_VECTOR2(alu_umin,    host_vector_uint,  vector_select((host_vector_uint)(b<a),b,a))
+CAL_IL_HOST_VECTOR2(alu_umax,    host_vector_uint,  vector_select((host_vector_uint)(b>a),b,a))
+CAL_IL_HOST_VECTOR3(alu_imad,    host_vector_uint,  a*b+c)
+CAL_IL_HOST_VECTOR3(alu_bfi,     host_vector_uint,  (a&b)|(~a&c))
+
+#undef CAL_IL_HOST_VECTOR1
+#undef CAL_IL_HOST_VECTOR2
+#undef CAL_IL_HOST_VECTOR3
+
+// returns number of lanes computed, lane arrays need no alignment
+template<class F, bool vector=alu_vector<F>::value>
+struct alu_block
+{
+    typedef alu_vector<F>       op;
+    typedef typename op::type   T;
+
+    static T load( const host_word* p )
+    {
+        T v;
+        std::memcpy(&v,p,sizeof(T));
+        return v;
+    }
+
+    static int run( host_word* d, const host_word* a, int n )
+    {
+        int i;
+        for(i=0;i+HOST_VECTOR_WIDTH<=n;i+=HOST_VECTOR_WIDTH) {
+            T r;
+            op::apply(r,load(a+i));
+            std::memcpy(d+i,&r,sizeof(T));
+        }
+        return i;
+    }
+
+    static int run( host_word* d, const host_word* a, const host_word* b, int n )
+    {
+        int i;
+        for(i=0;i+HOST_VECTOR_WIDTH<=n;i+=HOST_VECTOR_WIDTH) {
+            T r;
+            op::apply(r,load(a+i),load(b+i));
+            std::memcpy(d+i,&r,sizeof(T));
+        }
+        return i;
+    }
+
+    static int run( host_word* d, const host_word* a, const host_word* b, const host_word* c, int n )
+    {
+        int i;
+        for(i=0;i+HOST_VECTOR_WIDTH<=n;i+=HOST_VECTOR_WIDTH) {
+            T r;
+            op::apply(r,load(a+i),load(b+i),load(c+i));
+            std::memcpy(d+i,&r,sizeof(T));
+        }
+        return i;
+    }
+};
+#else
+template<class F, bool vector=false>
+struct alu_block;
+#endif
+
+template<class F>
+struct alu_block<F,false>
+{
+    static int run( host_word*, const host_word*, int ) { return 0; }
+    static int run( host_word*, const host_word*, const host_word*, int ) { return 0; }
+    static int run( host_word*, const host_word*, const host_word*, const host_word*, int ) { return 0; }
+};
+
+//
+// lane loops, sources are already swizzled
+// destination can be one of sources only when it is the same lane array
+//
+
+template<class F>
+inline void alu_lanes( host_word* d, const host_word* a, int n )
+{
+    for(int i=alu_block<F>::run(d,a,n);i<n;i++) F::apply(d[i],a[i]);
+}
+
+template<class F>
+inline void alu_lanes( host_word* d, const host_word* a, const host_word* b, int n )
+{
+    for(int i=alu_block<F>::run(d,a,b,n);i<n;i++) F::apply(d[i],a[i],b[i]);
+}
+
+template<class F>
+inline void alu_lanes( host_word* d, const host_word* a, const host_word* b, const host_word* c, int n )
+{
+    for(int i=alu_block<F>::run(d,a,b,c,n);i<n;i++) F::apply(d[i],a[i],b[i],c[i]);
+}
+
+} // detail
+} // host
+} // il
+} // cal
+
+#endif
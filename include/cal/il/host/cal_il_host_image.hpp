@@ -0,0 +1,116 @@
+/*
+ * C++ to IL compiler/generator host memory used by IL interpreter
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_HOST_IMAGE_H
+#define __CAL_IL_HOST_IMAGE_H
+
+#include <vector>
+#include <cassert>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+
+//
+// range of work-items ( compute shader ) or pixels ( pixel shader )
+//
+
+struct ndrange
+{
+    int width;
+    int height;
+    int depth;
+
+    ndrange() : width(1), height(1), depth(1) {}
+    ndrange( int w ) : width(w), height(1), depth(1) {}
+    ndrange( int w, int h ) : width(w), height(h), depth(1) {}
+    ndrange( int w, int h, int d ) : width(w), height(h), depth(d) {}
+
+    int size() const { return width*height*depth; }
+};
+
+//
+// 1D or 2D array of 32-bit components in host memory
+// it stands for any CAL resource: input, output, global buffer, UAV and constant buffer
+// element has 1, 2 or 4 components, missing components are read as ( 0, 0, 1.0f )
+// copies share memory like CAL++ Image1D and Image2D
+//
+
+class image
+{
+protected:
+    struct image_data
+    {
+        int                             width;
+        int                             height;
+        int                             components;
+        std::vector<boost::uint32_t>    data;
+        boost::mutex                    lock;   // serializes atomics
+    };
+
+    boost::shared_ptr<image_data>   _data;
+
+    void create( int width, int height, int components )
+    {
+        assert( width>0 && height>0 && (components==1 || components==2 || components==4) );
+
+        _data.reset(new image_data());
+        _data->width      = width;
+        _data->height     = height;
+        _data->components = components;
+        _data->data.resize((std::size_t)width*height*components,0);
+    }
+
+public:
+    image() {}
+    image( int width, int components ) { create(width,1,components); }
+    image( int width, int height, int components ) { create(width,height,components); }
+
+    bool valid() const { return _data.get()!=NULL; }
+
+    int width() const { return _data->width; }
+    int height() const { return _data->height; }
+    int components() const { return _data->components; }
+
+    // number of elements
+    int size() const { return _data->width*_data->height; }
+
+    boost::uint32_t* data() { return &_data->data[0]; }
+    const boost::uint32_t* data() const { return &_data->data[0]; }
+
+    template<class T>
+    T* ptr() { return reinterpret_cast<T*>(data()); }
+
+    template<class T>
+    const T* ptr() const { return reinterpret_cast<const T*>(data()); }
+
+    boost::mutex& lock() const { return _data->lock; }
+};
+
+} // host
+} // il
+} // cal
+
+#endif
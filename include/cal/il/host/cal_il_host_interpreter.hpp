@@ -0,0 +1,1218 @@
+/*
+ * C++ to IL compiler/generator host interpreter of IL kernels
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_HOST_INTERPRETER_H
+#define __CAL_IL_HOST_INTERPRETER_H
+
+#include <map>
+#include <vector>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cal/il/host/cal_il_host_image.hpp>
+#include <cal/il/host/cal_il_host_program.hpp>
+#include <cal/il/host/cal_il_host_alu.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+namespace detail {
+
+//
+// memory bound to kernel names "i#", "o#", "cb#", "uav#" and "g[]"
+//
+
+struct host_bindings
+{
+    std::map<int,image>     input;
+    std::map<int,image>     output;
+    std::map<int,image>     constant;
+    std::map<int,image>     uav;
+    image                   global;
+};
+
+//
+// one work-group ( compute shader ) or one tile of pixels ( pixel shader )
+//
+
+struct host_group
+{
+    int     id[3];          // group id, tile column and row for pixel shader
+    int     count[3];       // number of groups
+    int     domain[2];      // pixel shader domain
+};
+
+// lanes of pixel shader tile ( tile covers PIXEL_TILE x 1 pixels )
+static const int PIXEL_TILE = 64;
+
+enum host_frame_type
+{
+    FRAME_IF, FRAME_LOOP, FRAME_CALL
+};
+
+//
+// saved masks of if ( a - lanes before if, b - lanes of then branch ),
+// loop ( a - lanes entering loop, b, c - broken and continued lanes of outer loop )
+// and call ( a - calling lanes, b, c, d - broken, continued and returned lanes of caller )
+//
+
+struct host_frame
+{
+    int                             type;
+    int                             pc;
+    std::vector<boost::uint32_t>    a,b,c,d;
+};
+
+//
+// executes work-groups of decoded program, every work-item is one lane of struct-of-arrays register file
+// register component c of slot s occupies reg[(4*s+c)*lanes .. (4*s+c+1)*lanes)
+// lanes are masked with 0 ( inactive ) or 0xFFFFFFFF ( active ) words
+// executor is used by one thread, group runs to completion in lock-step so fences need no action
+//
+
+class host_executor
+{
+protected:
+    typedef boost::uint32_t                 mask_type;
+    typedef std::vector<mask_type>          mask_vector;
+
+    const host_program&                     program;
+    const host_bindings&                    memory;
+    int                                     lanes;
+    int                                     local[3];
+
+    std::vector<host_word>                  reg;
+    std::vector<host_word>                  scratch;    // gathered or modified sources, 4 components of 5 operands
+    std::vector<host_word>                  result;     // results written under mask
+    std::vector<host_word>                  constant;   // zero and one lanes
+    std::vector<int>                        index;
+    std::map<int,std::vector<boost::uint32_t> > lds;
+
+    mask_vector                             exec,broken,continued,returned,domain,cond;
+    std::vector<host_frame>                 frame;
+    int                                     depth;
+    int                                     pc;
+    host_group                              group;
+
+    host_word* slot_ptr( int slot, int c )
+    {
+        return &reg[(4*slot+c)*lanes];
+    }
+
+    //
+    // lane masks
+    //
+
+    bool any( const mask_vector& m ) const
+    {
+        mask_type r=0;
+        for(int l=0;l<lanes;l++) r |= m[l];
+        return r!=0;
+    }
+
+    bool all_active() const
+    {
+        mask_type r=0xFFFFFFFFu;
+        for(int l=0;l<lanes;l++) r &= exec[l];
+        return r!=0;
+    }
+
+    host_frame& push( int type )
+    {
+        if( depth==(int)frame.size() ) frame.push_back(host_frame());
+
+        host_frame& f = frame[depth++];
+        f.type = type;
+        f.pc   = pc;
+        return f;
+    }
+
+    //
+    // memory
+    //
+
+    const image& find_image( const std::map<int,image>& m, int id, const char* name ) const
+    {
+        std::map<int,image>::const_iterator i = m.find(id);
+
+        if( i==m.end() || !i->second.valid() ) {
+            std::ostringstream s;
+            s << name << id;
+            host_error("unbound memory",s.str());
+        }
+        return i->second;
+    }
+
+    // component c of element, missing components are ( 0, 0, 1.0f )
+    static boost::uint32_t read_element( const image& img, int element, int c )
+    {
+        if( c<img.components() ) return img.data()[element*img.components()+c];
+        return c==3 ? 0x3F800000u : 0u;
+    }
+
+    //
+    // sources
+    //
+
+    void index_lanes( const host_operand& op )
+    {
+        const host_word* r = slot_ptr(op.index_slot,op.index_component);
+        for(int l=0;l<lanes;l++) index[l] = op.index_offset + r[l].i;
+    }
+
+    void fetch( const host_instruction& inst, int k, const host_word* (&s)[4] )
+    {
+        const host_operand& op = inst.operand[k];
+        host_word*          tmp = &scratch[4*k*lanes];
+        int                 c,l;
+
+        if( op.kind==OPERAND_REGISTER ) {
+            for(c=0;c<4;c++) {
+                int w = op.swizzle[c];
+                s[c] = w<4 ? slot_ptr(op.slot,w) : &constant[(w==SWIZZLE_ONE ? lanes : 0)];
+            }
+            if( !op.abs && !op.neg ) return;
+
+            for(c=0;c<4;c++) {
+                std::copy(s[c],s[c]+lanes,tmp+c*lanes);
+                s[c] = tmp+c*lanes;
+            }
+        }
+        else {
+            const image*    img = NULL;
+            int             size = op.size;
+
+            if( op.kind==OPERAND_GLOBAL ) img = &memory.global;
+            if( op.kind==OPERAND_CONSTANT ) img = &find_image(memory.constant,op.size,"cb");
+            if( img ) size = img->size();
+
+            if( op.index_slot>=0 ) index_lanes(op);
+            else std::fill(index.begin(),index.end(),op.index_offset);
+
+            for(c=0;c<4;c++) {
+                host_word*  t = tmp+c*lanes;
+                int         w = op.swizzle[c];
+
+                s[c] = t;
+                if( w>=4 ) {
+                    const host_word* k = &constant[(w==SWIZZLE_ONE ? lanes : 0)];
+                    std::copy(k,k+lanes,t);
+                    continue;
+                }
+
+                for(l=0;l<lanes;l++) {
+                    int i = index[l];
+
+                    if( i<0 || i>=size ) t[l].u = 0;
+                    else if( img ) t[l].u = read_element(*img,i,w);
+                    else t[l] = slot_ptr(op.slot+i,w)[l];
+                }
+            }
+        }
+
+        for(c=0;c<4;c++) {
+            host_word*      t = tmp+c*lanes;
+            boost::uint32_t clear = op.abs ? 0x7FFFFFFFu : 0xFFFFFFFFu;
+            boost::uint32_t flip  = (op.neg>>c)&1 ? 0x80000000u : 0u;
+
+            for(l=0;l<lanes;l++) t[l].u = (t[l].u&clear)^flip;
+        }
+    }
+
+    //
+    // destination
+    //
+
+    // result pointers, register is written directly when no lane is masked and no source reads it
+    void target( const host_instruction& inst, host_word* (&d)[4], bool& direct )
+    {
+        const host_operand& op = inst.operand[0];
+
+        direct = op.kind==OPERAND_REGISTER && !inst.alias && !inst.saturate && all_active();
+        for(int c=0;c<4;c++) d[c] = direct ? slot_ptr(op.slot,c) : &result[c*lanes];
+    }
+
+    void store( const host_instruction& inst )
+    {
+        const host_operand& op = inst.operand[0];
+        int                 c,l;
+
+        if( inst.saturate ) {
+            for(c=0;c<4;c++) {
+                host_word* r = &result[c*lanes];
+                for(l=0;l<lanes;l++) r[l].f = r[l].f>0.0f ? (r[l].f<1.0f ? r[l].f : 1.0f) : 0.0f;
+            }
+        }
+
+        if( op.kind==OPERAND_REGISTER ) {
+            for(c=0;c<4;c++) {
+                if( !(op.mask&(1<<c)) ) continue;
+
+                host_word*          d = slot_ptr(op.slot,c);
+                const host_word*    r = &result[c*lanes];
+                for(l=0;l<lanes;l++) d[l].u = (r[l].u&exec[l]) | (d[l].u&~exec[l]);
+            }
+            return;
+        }
+
+        if( op.kind==OPERAND_INDEXED ) {
+            index_lanes(op);
+            for(c=0;c<4;c++) {
+                if( !(op.mask&(1<<c)) ) continue;
+                for(l=0;l<lanes;l++) {
+                    if( exec[l] && index[l]>=0 && index[l]<op.size ) slot_ptr(op.slot+index[l],c)[l] = result[c*lanes+l];
+                }
+            }
+            return;
+        }
+
+        if( op.kind==OPERAND_GLOBAL ) {
+            image g = memory.global;
+
+            if( op.index_slot>=0 ) index_lanes(op);
+            else std::fill(index.begin(),index.end(),op.index_offset);
+
+            for(c=0;c<4 && c<g.components();c++) {
+                if( !(op.mask&(1<<c)) ) continue;
+                for(l=0;l<lanes;l++) {
+                    if( exec[l] && index[l]>=0 && index[l]<g.size() ) g.data()[index[l]*g.components()+c] = result[c*lanes+l].u;
+                }
+            }
+            return;
+        }
+
+        host_error("invalid destination","");
+    }
+
+    //
+    // ALU
+    //
+
+    template<class F>
+    void unary( const host_instruction& inst )
+    {
+        const host_word*    a[4];
+        host_word*          d[4];
+        bool                direct;
+
+        fetch(inst,1,a);
+        target(inst,d,direct);
+        for(int c=0;c<4;c++) {
+            if( inst.operand[0].mask&(1<<c) ) alu_lanes<F>(d[c],a[c],lanes);
+        }
+        if( !direct ) store(inst);
+    }
+
+    template<class F>
+    void binary( const host_instruction& inst )
+    {
+        const host_word*    a[4];
+        const host_word*    b[4];
+        host_word*          d[4];
+        bool                direct;
+
+        fetch(inst,1,a);
+        fetch(inst,2,b);
+        target(inst,d,direct);
+        for(int c=0;c<4;c++) {
+            if( inst.operand[0].mask&(1<<c) ) alu_lanes<F>(d[c],a[c],b[c],lanes);
+        }
+        if( !direct ) store(inst);
+    }
+
+    template<class F>
+    void ternary( const host_instruction& inst )
+    {
+        const host_word*    a[4];
+        const host_word*    b[4];
+        const host_word*    e[4];
+        host_word*          d[4];
+        bool                direct;
+
+        fetch(inst,1,a);
+        fetch(inst,2,b);
+        fetch(inst,3,e);
+        target(inst,d,direct);
+        for(int c=0;c<4;c++) {
+            if( inst.operand[0].mask&(1<<c) ) alu_lanes<F>(d[c],a[c],b[c],e[c],lanes);
+        }
+        if( !direct ) store(inst);
+    }
+
+    void dot( const host_instruction& inst, int n )
+    {
+        const host_word*    a[4];
+        const host_word*    b[4];
+        int                 c,l;
+
+        fetch(inst,1,a);
+        fetch(inst,2,b);
+        for(l=0;l<lanes;l++) {
+            float s = 0.0f;
+            for(c=0;c<n;c++) s += a[c][l].f*b[c][l].f;
+            for(c=0;c<4;c++) result[c*lanes+l].f = s;
+        }
+        store(inst);
+    }
+
+    //
+    // double occupies x and y of source, result is written to ( x, y, x, y ) under mask
+    //
+
+    void store_double( int l, double v )
+    {
+        split_double(v,result[l],result[lanes+l]);
+        result[2*lanes+l] = result[l];
+        result[3*lanes+l] = result[lanes+l];
+    }
+
+    void replicate( int l, boost::uint32_t v )
+    {
+        for(int c=0;c<4;c++) result[c*lanes+l].u = v;
+    }
+
+    template<class F>
+    void double_unary( const host_instruction& inst )
+    {
+        const host_word* a[4];
+
+        fetch(inst,1,a);
+        for(int l=0;l<lanes;l++) store_double(l,F::apply(make_double(a[0][l],a[1][l])));
+        store(inst);
+    }
+
+    template<class F>
+    void double_binary( const host_instruction& inst )
+    {
+        const host_word* a[4];
+        const host_word* b[4];
+
+        fetch(inst,1,a);
+        fetch(inst,2,b);
+        for(int l=0;l<lanes;l++) store_double(l,F::apply(make_double(a[0][l],a[1][l]),make_double(b[0][l],b[1][l])));
+        store(inst);
+    }
+
+    template<class F>
+    void double_compare( const host_instruction& inst )
+    {
+        const host_word* a[4];
+        const host_word* b[4];
+
+        fetch(inst,1,a);
+        fetch(inst,2,b);
+        for(int l=0;l<lanes;l++) replicate(l,bool_mask(F::apply(make_double(a[0][l],a[1][l]),make_double(b[0][l],b[1][l]))));
+        store(inst);
+    }
+
+    void double_special( const host_instruction& inst )
+    {
+        const host_word*    a[4];
+        const host_word*    b[4];
+        const host_word*    e[4];
+        int                 l,exponent;
+
+        fetch(inst,1,a);
+        switch( inst.opcode ) {
+        case OP_F2D:
+            for(l=0;l<lanes;l++) store_double(l,(double)a[0][l].f);
+            break;
+        case OP_D2F:
+            for(l=0;l<lanes;l++) {
+                host_word w;
+                w.f = (float)make_double(a[0][l],a[1][l]);
+                replicate(l,w.u);
+            }
+            break;
+        case OP_DMAD:
+            fetch(inst,2,b);
+            fetch(inst,3,e);
+            for(l=0;l<lanes;l++) store_double(l,alu_dmad::apply(make_double(a[0][l],a[1][l]),make_double(b[0][l],b[1][l]),make_double(e[0][l],e[1][l])));
+            break;
+        case OP_DFREXP:
+            for(l=0;l<lanes;l++) {
+                double m = std::frexp(make_double(a[0][l],a[1][l]),&exponent);
+                split_double(m,result[2*lanes+l],result[3*lanes+l]);
+                result[l].i = result[lanes+l].i = exponent;
+            }
+            break;
+        case OP_DLDEXP:
+            fetch(inst,2,b);
+            for(l=0;l<lanes;l++) store_double(l,std::ldexp(make_double(a[0][l],a[1][l]),b[0][l].i));
+            break;
+        }
+        store(inst);
+    }
+
+    //
+    // flow control
+    //
+
+    // lanes of current function which left the loop, skipped rest of iteration or returned
+    mask_type cut( int l ) const
+    {
+        return broken[l] | continued[l] | returned[l];
+    }
+
+    void condition( const host_instruction& inst, bool zero )
+    {
+        const host_word* a[4];
+
+        fetch(inst,0,a);
+        for(int l=0;l<lanes;l++) cond[l] = bool_mask((a[0][l].u!=0)!=zero);
+    }
+
+    void compare( const host_instruction& inst )
+    {
+        const host_word*    a[4];
+        const host_word*    b[4];
+        int                 l;
+
+        fetch(inst,0,a);
+        fetch(inst,1,b);
+        for(l=0;l<lanes;l++) {
+            float x = a[0][l].f, y = b[0][l].f;
+            bool  r = false;
+
+            switch( inst.func ) {
+            case RELOP_EQ: r = x==y; break;
+            case RELOP_NE: r = x!=y; break;
+            case RELOP_LT: r = x<y; break;
+            case RELOP_LE: r = x<=y; break;
+            case RELOP_GT: r = x>y; break;
+            case RELOP_GE: r = x>=y; break;
+            }
+            cond[l] = bool_mask(r);
+        }
+    }
+
+    void branch_if( const host_instruction& inst )
+    {
+        host_frame& f = push(FRAME_IF);
+
+        f.a = exec;
+        for(int l=0;l<lanes;l++) exec[l] &= cond[l];
+        f.b = exec;
+
+        pc = any(exec) ? pc+1 : inst.target;
+    }
+
+    // lanes in cond leave loop ( or skip rest of iteration )
+    void leave( mask_vector& m )
+    {
+        for(int l=0;l<lanes;l++) {
+            mask_type c = cond[l]&exec[l];
+            m[l] |= c;
+            exec[l] &= ~c;
+        }
+
+        if( any(exec) ) pc++;
+        else skip();
+    }
+
+    // no lane is active, control goes to the end of innermost construct
+    void skip()
+    {
+        if( depth==0 ) {
+            pc = -1;
+            return;
+        }
+
+        host_frame& f = frame[depth-1];
+
+        switch( f.type ) {
+        case FRAME_IF:
+        case FRAME_LOOP:
+            pc = program.code[f.pc].target;
+            break;
+        case FRAME_CALL:
+            exec      = f.a;
+            broken    = f.b;
+            continued = f.c;
+            returned  = f.d;
+            pc        = f.pc+1;
+            depth--;
+            break;
+        }
+    }
+
+    bool flow( const host_instruction& inst )
+    {
+        int l;
+
+        switch( inst.opcode ) {
+        case OP_IF_LOGICALNZ:
+        case OP_IF_LOGICALZ:
+            condition(inst,inst.opcode==OP_IF_LOGICALZ);
+            branch_if(inst);
+            return true;
+        case OP_IFC:
+            compare(inst);
+            branch_if(inst);
+            return true;
+        case OP_ELSE: {
+            host_frame& f = frame[depth-1];
+
+            for(l=0;l<lanes;l++) exec[l] = f.a[l] & ~f.b[l] & ~cut(l);
+            f.pc = pc;
+            pc   = any(exec) ? pc+1 : inst.target;
+            return true;
+        }
+        case OP_ENDIF: {
+            host_frame& f = frame[depth-1];
+
+            for(l=0;l<lanes;l++) exec[l] = f.a[l] & ~cut(l);
+            depth--;
+            if( any(exec) ) pc++;
+            else skip();
+            return true;
+        }
+        case OP_WHILELOOP: {
+            if( !any(exec) ) {
+                pc = inst.target+1;
+                return true;
+            }
+
+            host_frame& f = push(FRAME_LOOP);
+            f.a = exec;
+            f.b = broken;
+            f.c = continued;
+            std::fill(broken.begin(),broken.end(),0);
+            std::fill(continued.begin(),continued.end(),0);
+            pc++;
+            return true;
+        }
+        case OP_ENDLOOP: {
+            host_frame& f = frame[depth-1];
+
+            std::fill(continued.begin(),continued.end(),0);
+            for(l=0;l<lanes;l++) exec[l] = f.a[l] & ~broken[l] & ~returned[l];
+            if( any(exec) ) {
+                pc = f.pc+1;
+                return true;
+            }
+
+            for(l=0;l<lanes;l++) exec[l] = f.a[l] & ~returned[l];
+            broken    = f.b;
+            continued = f.c;
+            depth--;
+            if( any(exec) ) pc++;
+            else skip();
+            return true;
+        }
+        case OP_BREAK:
+        case OP_CONTINUE:
+            std::fill(cond.begin(),cond.end(),0xFFFFFFFFu);
+            leave(inst.opcode==OP_BREAK ? broken : continued);
+            return true;
+        case OP_BREAKC:
+        case OP_CONTINUEC:
+            compare(inst);
+            leave(inst.opcode==OP_BREAKC ? broken : continued);
+            return true;
+        case OP_BREAK_LOGICALZ:
+        case OP_BREAK_LOGICALNZ:
+            condition(inst,inst.opcode==OP_BREAK_LOGICALZ);
+            leave(broken);
+            return true;
+        case OP_CONTINUE_LOGICALZ:
+        case OP_CONTINUE_LOGICALNZ:
+            condition(inst,inst.opcode==OP_CONTINUE_LOGICALZ);
+            leave(continued);
+            return true;
+        case OP_CALL: {
+            if( !any(exec) ) {
+                pc++;
+                return true;
+            }
+
+            host_frame& f = push(FRAME_CALL);
+            f.a = exec;
+            f.b = broken;
+            f.c = continued;
+            f.d = returned;
+            std::fill(broken.begin(),broken.end(),0);
+            std::fill(continued.begin(),continued.end(),0);
+            std::fill(returned.begin(),returned.end(),0);
+            pc = inst.target;
+            return true;
+        }
+        case OP_RET:
+        case OP_ENDFUNC:
+            for(l=0;l<lanes;l++) {
+                returned[l] |= exec[l];
+                exec[l] = 0;
+            }
+            skip();
+            return true;
+        case OP_FUNC:
+            pc++;
+            return true;
+        case OP_ENDMAIN:
+        case OP_END:
+            pc = -1;
+            return true;
+        }
+
+        return false;
+    }
+
+    //
+    // resources
+    //
+
+    void sample( const host_instruction& inst )
+    {
+        const host_resource&    r = program.resource.find(inst.resource)->second;
+        const image&            img = find_image(memory.input,inst.resource,"i");
+        const host_word*        a[4];
+        int                     l,c;
+
+        fetch(inst,1,a);
+        for(l=0;l<lanes;l++) {
+            float   u = a[0][l].f, v = r.dimension==2 ? a[1][l].f : 0.0f;
+            int     x,y;
+
+            if( r.normalized ) {
+                u *= img.width();
+                v *= img.height();
+            }
+            x = std::min(std::max((int)std::floor(u)+inst.offset[0],0),img.width()-1);
+            y = std::min(std::max((int)std::floor(v)+inst.offset[1],0),img.height()-1);
+
+            for(c=0;c<4;c++) result[c*lanes+l].u = read_element(img,y*img.width()+x,c);
+        }
+        store(inst);
+    }
+
+    void load( const host_instruction& inst )
+    {
+        const host_resource&    r = program.resource.find(inst.resource)->second;
+        const image&            img = find_image(memory.input,inst.resource,"i");
+        const host_word*        a[4];
+        int                     l,c;
+
+        fetch(inst,1,a);
+        for(l=0;l<lanes;l++) {
+            int x = a[0][l].i, y = r.dimension==2 ? a[1][l].i : 0;
+            bool inside = x>=0 && x<img.width() && y>=0 && y<img.height();
+
+            for(c=0;c<4;c++) result[c*lanes+l].u = inside ? read_element(img,y*img.width()+x,c) : 0u;
+        }
+        store(inst);
+    }
+
+    //
+    // UAV and LDS addresses are word offsets in memory
+    //
+
+    int uav_address( const host_uav& u, const image& img, const host_word* const* a, int l ) const
+    {
+        switch( u.type ) {
+        case UAV_TYPED:  return a[0][l].i*img.components();
+        case UAV_RAW:    return (int)(a[0][l].u>>2);
+        }
+        return (int)((a[0][l].u*u.stride+a[1][l].u)>>2);
+    }
+
+    int lds_address( const host_lds& s, const host_word* const* a, int l ) const
+    {
+        if( s.stride==0 ) return (int)(a[0][l].u>>2);
+        return (int)((a[0][l].u*s.stride+a[1][l].u)>>2);
+    }
+
+    static bool inside( int address, int n, int size )
+    {
+        return address>=0 && address+n<=size;
+    }
+
+    void uav_load( const host_instruction& inst )
+    {
+        const host_uav&     u = program.uav.find(inst.resource)->second;
+        image               img = find_image(memory.uav,inst.resource,"uav");
+        int                 size = (int)(img.size()*img.components());
+        const host_word*    a[4];
+        int                 l,c;
+
+        fetch(inst,1,a);
+        for(l=0;l<lanes;l++) {
+            int p = uav_address(u,img,a,l);
+
+            for(c=0;c<4;c++) {
+                boost::uint32_t v = 0;
+
+                if( u.type==UAV_TYPED ) {
+                    if( inside(p,img.components(),size) ) v = read_element(img,p/img.components(),c);
+                }
+                else if( inside(p+c,1,size) ) v = img.data()[p+c];
+
+                result[c*lanes+l].u = v;
+            }
+        }
+        store(inst);
+    }
+
+    void uav_store( const host_instruction& inst )
+    {
+        const host_uav&     u = program.uav.find(inst.resource)->second;
+        image               img = find_image(memory.uav,inst.resource,"uav");
+        int                 size = (int)(img.size()*img.components());
+        const host_word*    a[4];
+        const host_word*    v[4];
+        int                 l,c,mask;
+
+        // typed store has no mem operand
+        if( u.type==UAV_TYPED ) {
+            fetch(inst,0,a);
+            fetch(inst,1,v);
+            mask = (1<<img.components())-1;
+        }
+        else {
+            fetch(inst,1,a);
+            fetch(inst,2,v);
+            mask = inst.operand[0].mask;
+        }
+
+        for(l=0;l<lanes;l++) {
+            if( !exec[l] ) continue;
+
+            int p = uav_address(u,img,a,l);
+            for(c=0;c<4;c++) {
+                if( (mask&(1<<c)) && inside(p+c,1,size) ) img.data()[p+c] = v[c][l].u;
+            }
+        }
+    }
+
+    static boost::uint32_t atomic( int func, boost::uint32_t old, boost::uint32_t value, boost::uint32_t compare )
+    {
+        switch( func ) {
+        case ATOMIC_ADD:  return old+value;
+        case ATOMIC_SUB:  return old-value;
+        case ATOMIC_RSUB: return value-old;
+        case ATOMIC_MIN:  return (boost::int32_t)value<(boost::int32_t)old ? value : old;
+        case ATOMIC_MAX:  return (boost::int32_t)value>(boost::int32_t)old ? value : old;
+        case ATOMIC_UMIN: return value<old ? value : old;
+        case ATOMIC_UMAX: return value>old ? value : old;
+        case ATOMIC_AND:  return old&value;
+        case ATOMIC_OR:   return old|value;
+        case ATOMIC_XOR:  return old^value;
+        case ATOMIC_XCHG: return value;
+        case ATOMIC_CMP:  return old==compare ? value : old;
+        }
+        return old;
+    }
+
+    //
+    // lanes are applied in order, returned value is replicated
+    // UAV compare and exchange takes ( value, compare ), LDS takes ( compare, value )
+    //
+
+    void atomic_lanes( const host_instruction& inst, boost::uint32_t* data, int size, bool uav, const host_uav* u, const host_lds* s, const image* img )
+    {
+        const host_word*    a[4];
+        const host_word*    v[4];
+        const host_word*    w[4];
+        int                 k = inst.returns ? 1 : 0;
+        int                 l;
+
+        fetch(inst,k,a);
+        fetch(inst,k+1,v);
+        if( inst.func==ATOMIC_CMP ) fetch(inst,k+2,w);
+
+        for(l=0;l<lanes;l++) {
+            if( !exec[l] ) continue;
+
+            int             p = uav ? uav_address(*u,*img,a,l) : lds_address(*s,a,l);
+            boost::uint32_t value = v[0][l].u, compare = 0, old = 0;
+
+            if( inst.func==ATOMIC_CMP ) {
+                value   = uav ? v[0][l].u : w[0][l].u;
+                compare = uav ? w[0][l].u : v[0][l].u;
+            }
+            if( inside(p,1,size) ) {
+                old = data[p];
+                data[p] = atomic(inst.func,old,value,compare);
+            }
+            if( k ) replicate(l,old);
+        }
+
+        if( k ) store(inst);
+    }
+
+    void uav_atomic( const host_instruction& inst )
+    {
+        const host_uav& u = program.uav.find(inst.resource)->second;
+        image           img = find_image(memory.uav,inst.resource,"uav");
+
+        boost::lock_guard<boost::mutex> lock(img.lock());
+        atomic_lanes(inst,img.data(),(int)(img.size()*img.components()),true,&u,NULL,&img);
+    }
+
+    void lds_atomic( const host_instruction& inst )
+    {
+        std::vector<boost::uint32_t>& data = lds[inst.resource];
+
+        atomic_lanes(inst,data.empty() ? NULL : &data[0],(int)data.size(),false,NULL,&program.lds.find(inst.resource)->second,NULL);
+    }
+
+    // lds_load_id and lds_store_id address single word, vec forms address ( src0, src1 )
+    void lds_access( const host_instruction& inst )
+    {
+        const host_lds&                 s = program.lds.find(inst.resource)->second;
+        std::vector<boost::uint32_t>&   data = lds[inst.resource];
+        int                             size = (int)data.size();
+        const host_word*                a[4];
+        const host_word*                b[4];
+        const host_word*                v[4];
+        int                             l,c,p;
+
+        switch( inst.opcode ) {
+        case OP_LDS_LOAD:
+            fetch(inst,1,a);
+            for(l=0;l<lanes;l++) {
+                p = lds_address(s,a,l);
+                replicate(l,inside(p,1,size) ? data[p] : 0u);
+            }
+            store(inst);
+            break;
+        case OP_LDS_STORE:
+            fetch(inst,0,a);
+            fetch(inst,1,v);
+            for(l=0;l<lanes;l++) {
+                p = lds_address(s,a,l);
+                if( exec[l] && inside(p,1,size) ) data[p] = v[0][l].u;
+            }
+            break;
+        case OP_LDS_LOAD_VEC:
+        case OP_LDS_STORE_VEC:
+            fetch(inst,1,a);
+            fetch(inst,2,b);
+            if( inst.opcode==OP_LDS_STORE_VEC ) fetch(inst,3,v);
+            for(l=0;l<lanes;l++) {
+                p = s.stride==0 ? (int)(a[0][l].u>>2) : (int)((a[0][l].u*s.stride+b[0][l].u)>>2);
+
+                for(c=0;c<4;c++) {
+                    bool ok = inside(p+c,1,size);
+
+                    if( inst.opcode==OP_LDS_LOAD_VEC ) result[c*lanes+l].u = ok ? data[p+c] : 0u;
+                    else if( exec[l] && ok && (inst.operand[0].mask&(1<<c)) ) data[p+c] = v[c][l].u;
+                }
+            }
+            if( inst.opcode==OP_LDS_LOAD_VEC ) store(inst);
+            break;
+        }
+    }
+
+    //
+    // per group state
+    //
+
+    void set_special( int slot, int c, int l, boost::uint32_t v )
+    {
+        slot_ptr(slot,c)[l].u = v;
+    }
+
+    void begin_group( const host_group& g )
+    {
+        unsigned    k;
+        int         l,c;
+
+        group = g;
+        depth = 0;
+        std::fill(broken.begin(),broken.end(),0);
+        std::fill(continued.begin(),continued.end(),0);
+        std::fill(returned.begin(),returned.end(),0);
+
+        for(l=0;l<lanes;l++) {
+            if( program.type==HOST_PIXEL_SHADER ) domain[l] = bool_mask(g.id[0]*PIXEL_TILE+l<g.domain[0]);
+            else domain[l] = 0xFFFFFFFFu;
+        }
+        exec = domain;
+
+        for(std::map<int,std::vector<boost::uint32_t> >::iterator i=lds.begin();i!=lds.end();i++) std::fill(i->second.begin(),i->second.end(),0);
+
+        for(k=0;k<program.special.size();k++) {
+            const host_slot_init& s = program.special[k];
+
+            for(l=0;l<lanes;l++) {
+                int tid[3], gid[3], abs[3], flat_group, v[4] = { 0, 0, 0, 0 };
+
+                tid[0] = l%local[0];
+                tid[1] = (l/local[0])%local[1];
+                tid[2] = l/(local[0]*local[1]);
+                for(c=0;c<3;c++) {
+                    gid[c] = g.id[c];
+                    abs[c] = gid[c]*local[c]+tid[c];
+                }
+                flat_group = gid[0] + gid[1]*g.count[0] + gid[2]*g.count[0]*g.count[1];
+
+                switch( s.source ) {
+                case SPECIAL_ABS_TID:           v[0] = abs[0]; v[1] = abs[1]; v[2] = abs[2]; break;
+                case SPECIAL_ABS_TID_FLAT:      v[0] = v[1] = v[2] = v[3] = abs[0] + abs[1]*g.count[0]*local[0] + abs[2]*g.count[0]*local[0]*g.count[1]*local[1]; break;
+                case SPECIAL_TID_IN_GRP:        v[0] = tid[0]; v[1] = tid[1]; v[2] = tid[2]; break;
+                case SPECIAL_TID_IN_GRP_FLAT:   v[0] = v[1] = v[2] = v[3] = l; break;
+                case SPECIAL_THREAD_GRP_ID:     v[0] = gid[0]; v[1] = gid[1]; v[2] = gid[2]; break;
+                case SPECIAL_THREAD_GRP_ID_FLAT: v[0] = v[1] = v[2] = v[3] = flat_group; break;
+                case SPECIAL_WIN_COORD: {
+                    host_word x,y,one;
+                    x.f   = (float)(g.id[0]*PIXEL_TILE+l)+0.5f;
+                    y.f   = (float)g.id[1]+0.5f;
+                    one.f = 1.0f;
+                    v[0] = x.i; v[1] = y.i; v[3] = one.i;
+                    break;
+                }
+                }
+
+                for(c=0;c<4;c++) set_special(s.slot,c,l,(boost::uint32_t)v[c]);
+            }
+        }
+    }
+
+    // pixel shader outputs are written to pixels of tile
+    void end_group()
+    {
+        unsigned k;
+        int      l,c;
+
+        if( program.type!=HOST_PIXEL_SHADER ) return;
+
+        for(k=0;k<program.output.size();k++) {
+            image   img = find_image(memory.output,program.output[k].second,"o");
+            int     y = group.id[1];
+
+            if( y>=img.height() ) continue;
+            for(l=0;l<lanes;l++) {
+                int x = group.id[0]*PIXEL_TILE+l;
+
+                if( !domain[l] || x>=img.width() ) continue;
+                for(c=0;c<img.components();c++) img.data()[(y*img.width()+x)*img.components()+c] = slot_ptr(program.output[k].first,c)[l].u;
+            }
+        }
+    }
+
+    void execute( const host_instruction& inst )
+    {
+        switch( inst.opcode ) {
+        case OP_MOV:            unary<alu_mov>(inst); break;
+        case OP_ADD:            binary<alu_add>(inst); break;
+        case OP_SUB:            binary<alu_sub>(inst); break;
+        case OP_MUL:            binary<alu_mul>(inst); break;
+        case OP_MAD:            ternary<alu_mad>(inst); break;
+        case OP_FMA:            ternary<alu_fma>(inst); break;
+        case OP_DIV:            binary<alu_div>(inst); break;
+        case OP_MOD:            binary<alu_mod>(inst); break;
+        case OP_MIN:            binary<alu_min>(inst); break;
+        case OP_MAX:            binary<alu_max>(inst); break;
+        case OP_ABS:            unary<alu_abs>(inst); break;
+        case OP_FRC:            unary<alu_frc>(inst); break;
+        case OP_FLR:            unary<alu_flr>(inst); break;
+        case OP_RND:            unary<alu_rnd>(inst); break;
+        case OP_SQRT:           unary<alu_sqrt>(inst); break;
+        case OP_RSQ:            unary<alu_rsq>(inst); break;
+        case OP_RCP:            unary<alu_rcp>(inst); break;
+        case OP_EXN:            unary<alu_exn>(inst); break;
+        case OP_LN:             unary<alu_ln>(inst); break;
+        case OP_EXP:            unary<alu_exp>(inst); break;
+        case OP_LOG:            unary<alu_log>(inst); break;
+        case OP_SIN:            unary<alu_sin>(inst); break;
+        case OP_COS:            unary<alu_cos>(inst); break;
+        case OP_EQ:             binary<alu_eq>(inst); break;
+        case OP_NE:             binary<alu_ne>(inst); break;
+        case OP_LT:             binary<alu_lt>(inst); break;
+        case OP_GE:             binary<alu_ge>(inst); break;
+        case OP_CMOV_LOGICAL:   ternary<alu_cmov>(inst); break;
+        case OP_DP2:            dot(inst,2); break;
+        case OP_DP3:            dot(inst,3); break;
+        case OP_DP4:            dot(inst,4); break;
+
+        case OP_IADD:           binary<alu_iadd>(inst); break;
+        case OP_INEGATE:        unary<alu_inegate>(inst); break;
+        case OP_IMUL:
+        case OP_UMUL:           binary<alu_imul>(inst); break;
+        case OP_IMUL_HIGH:      binary<alu_imul_high>(inst); break;
+        case OP_UMUL_HIGH:      binary<alu_umul_high>(inst); break;
+        case OP_IMAD:
+        case OP_UMAD:           ternary<alu_imad>(inst); break;
+        case OP_UDIV:           binary<alu_udiv>(inst); break;
+        case OP_UMOD:           binary<alu_umod>(inst); break;
+        case OP_IAND:           binary<alu_iand>(inst); break;
+        case OP_IOR:            binary<alu_ior>(inst); break;
+        case OP_IXOR:           binary<alu_ixor>(inst); break;
+        case OP_INOT:           unary<alu_inot>(inst); break;
+        case OP_ISHL:           binary<alu_ishl>(inst); break;
+        case OP_ISHR:           binary<alu_ishr>(inst); break;
+        case OP_USHR:           binary<alu_ushr>(inst); break;
+        case OP_IEQ:            binary<alu_ieq>(inst); break;
+        case OP_INE:            binary<alu_ine>(inst); break;
+        case OP_ILT:            binary<alu_ilt>(inst); break;
+        case OP_IGE:            binary<alu_ige>(inst); break;
+        case OP_ULT:            binary<alu_ult>(inst); break;
+        case OP_UGE:            binary<alu_uge>(inst); break;
+        case OP_IMIN:           binary<alu_imin>(inst); break;
+        case OP_IMAX:           binary<alu_imax>(inst); break;
+        case OP_UMIN:           binary<alu_umin>(inst); break;
+        case OP_UMAX:           binary<alu_umax>(inst); break;
+        case OP_IBIT_EXTRACT:   ternary<alu_ibit_extract>(inst); break;
+        case OP_UBIT_EXTRACT:   ternary<alu_ubit_extract>(inst); break;
+        case OP_BFI:            ternary<alu_bfi>(inst); break;
+        case OP_BITALIGN:       ternary<alu_bitalign>(inst); break;
+        case OP_BYTEALIGN:      ternary<alu_bytealign>(inst); break;
+
+        case OP_ITOF:           unary<alu_itof>(inst); break;
+        case OP_UTOF:           unary<alu_utof>(inst); break;
+        case OP_FTOI:           unary<alu_ftoi>(inst); break;
+        case OP_FTOU:           unary<alu_ftou>(inst); break;
+
+        case OP_DADD:           double_binary<alu_dadd>(inst); break;
+        case OP_DMUL:           double_binary<alu_dmul>(inst); break;
+        case OP_DDIV:           double_binary<alu_ddiv>(inst); break;
+        case OP_DMIN:           double_binary<alu_dmin>(inst); break;
+        case OP_DMAX:           double_binary<alu_dmax>(inst); break;
+        case OP_DEQ:            double_compare<alu_deq>(inst); break;
+        case OP_DNE:            double_compare<alu_dne>(inst); break;
+        case OP_DLT:            double_compare<alu_dlt>(inst); break;
+        case OP_DGE:            double_compare<alu_dge>(inst); break;
+        case OP_DFRAC:          double_unary<alu_dfrac>(inst); break;
+        case OP_DSQRT:          double_unary<alu_dsqrt>(inst); break;
+        case OP_DRSQ:           double_unary<alu_drsq>(inst); break;
+        case OP_DRCP:           double_unary<alu_drcp>(inst); break;
+        case OP_F2D:
+        case OP_D2F:
+        case OP_DMAD:
+        case OP_DFREXP:
+        case OP_DLDEXP:         double_special(inst); break;
+
+        case OP_SAMPLE:         sample(inst); break;
+        case OP_LOAD:           load(inst); break;
+        case OP_UAV_LOAD:
+        case OP_UAV_RAW_LOAD:
+        case OP_UAV_STRUCT_LOAD: uav_load(inst); break;
+        case OP_UAV_STORE:
+        case OP_UAV_RAW_STORE:
+        case OP_UAV_STRUCT_STORE: uav_store(inst); break;
+        case OP_UAV_ATOMIC:     uav_atomic(inst); break;
+        case OP_LDS_LOAD:
+        case OP_LDS_STORE:
+        case OP_LDS_LOAD_VEC:
+        case OP_LDS_STORE_VEC:  lds_access(inst); break;
+        case OP_LDS_ATOMIC:     lds_atomic(inst); break;
+        case OP_FENCE:          break;
+        }
+    }
+
+public:
+    //
+    // constant buffers and literals are read once, memory must stay bound while executor runs
+    //
+
+    host_executor( const host_program& p, const host_bindings& m ) : program(p), memory(m), depth(0), pc(0)
+    {
+        unsigned    k;
+        int         c,l;
+
+        if( program.type==HOST_PIXEL_SHADER ) {
+            local[0] = PIXEL_TILE;
+            local[1] = local[2] = 1;
+        }
+        else {
+            for(c=0;c<3;c++) local[c] = program.group[c];
+        }
+        lanes = local[0]*local[1]*local[2];
+
+        reg.resize((std::size_t)program.slot_count*4*lanes);
+        scratch.resize(5*4*lanes);
+        result.resize(4*lanes);
+        constant.resize(2*lanes);
+        index.resize(lanes);
+        exec.resize(lanes);
+        broken.resize(lanes);
+        continued.resize(lanes);
+        returned.resize(lanes);
+        domain.resize(lanes);
+        cond.resize(lanes);
+
+        for(l=0;l<lanes;l++) {
+            constant[l].u = 0;
+            constant[lanes+l].f = 1.0f;
+        }
+
+        for(k=0;k<program.literal.size();k++) {
+            for(c=0;c<4;c++) {
+                host_word* d = slot_ptr(program.literal[k].slot,c);
+                for(l=0;l<lanes;l++) d[l].u = program.literal[k].value[c];
+            }
+        }
+
+        if( program.uses_global && !memory.global.valid() ) host_error("unbound memory","g[]");
+
+        for(k=0;k<program.constant.size();k++) {
+            const host_slot_init&   s = program.constant[k];
+            const image&            img = find_image(memory.constant,s.source,"cb");
+
+            for(c=0;c<4;c++) {
+                boost::uint32_t v = s.element<img.size() ? read_element(img,s.element,c) : 0u;
+                host_word*      d = slot_ptr(s.slot,c);
+
+                for(l=0;l<lanes;l++) d[l].u = v;
+            }
+        }
+
+        for(std::map<int,host_lds>::const_iterator i=program.lds.begin();i!=program.lds.end();i++) {
+            lds[i->first].resize((i->second.size+3)/4);
+        }
+    }
+
+    int lane_count() const
+    {
+        return lanes;
+    }
+
+    void run( const host_group& g )
+    {
+        begin_group(g);
+
+        pc = any(exec) ? 0 : -1;
+        while( pc>=0 ) {
+            const host_instruction& inst = program.code[pc];
+
+            if( inst.opcode>=OP_WHILELOOP && inst.opcode<=OP_END ) {
+                flow(inst);
+                continue;
+            }
+
+            execute(inst);
+            pc++;
+        }
+
+        end_group();
+    }
+};
+
+} // detail
+} // host
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,853 @@
+/*
+ * C++ to IL compiler/generator IL decoder for host interpreter
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_HOST_PROGRAM_H
+#define __CAL_IL_HOST_PROGRAM_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+
+enum host_shader_type
+{
+    HOST_COMPUTE_SHADER,
+    HOST_PIXEL_SHADER
+};
+
+namespace detail {
+
+using cal::il::detail::instruction;
+using cal::il::detail::instruction_operand;
+using cal::il::detail::instruction_list;
+
+enum host_opcode
+{
+    // float
+    OP_MOV, OP_ADD, OP_SUB, OP_MUL, OP_MAD, OP_FMA, OP_DIV, OP_MOD, OP_MIN, OP_MAX, OP_ABS,
+    OP_FRC, OP_FLR, OP_RND, OP_SQRT, OP_RSQ, OP_RCP, OP_EXN, OP_LN, OP_EXP, OP_LOG, OP_SIN, OP_COS,
+    OP_EQ, OP_NE, OP_LT, OP_GE, OP_CMOV_LOGICAL, OP_DP2, OP_DP3, OP_DP4,
+    // integer
+    OP_IADD, OP_INEGATE, OP_IMUL, OP_IMUL_HIGH, OP_UMUL, OP_UMUL_HIGH, OP_IMAD, OP_UMAD, OP_UDIV, OP_UMOD,
+    OP_IAND, OP_IOR, OP_IXOR, OP_INOT, OP_ISHL, OP_ISHR, OP_USHR, OP_IEQ, OP_INE, OP_ILT, OP_IGE, OP_ULT, OP_UGE,
+    OP_IMIN, OP_IMAX, OP_UMIN, OP_UMAX, OP_IBIT_EXTRACT, OP_UBIT_EXTRACT, OP_BFI, OP_BITALIGN, OP_BYTEALIGN,
+    // conversion
+    OP_ITOF, OP_UTOF, OP_FTOI, OP_FTOU, OP_F2D, OP_D2F,
+    // double
+    OP_DADD, OP_DMUL, OP_DMAD, OP_DDIV, OP_DMIN, OP_DMAX, OP_DEQ, OP_DNE, OP_DLT, OP_DGE,
+    OP_DFRAC, OP_DFREXP, OP_DLDEXP, OP_DSQRT, OP_DRSQ, OP_DRCP,
+    // flow control
+    OP_WHILELOOP, OP_ENDLOOP, OP_BREAK, OP_BREAKC, OP_BREAK_LOGICALZ, OP_BREAK_LOGICALNZ,
+    OP_CONTINUE, OP_CONTINUEC, OP_CONTINUE_LOGICALZ, OP_CONTINUE_LOGICALNZ,
+    OP_IF_LOGICALNZ, OP_IF_LOGICALZ, OP_IFC, OP_ELSE, OP_ENDIF,
+    OP_CALL, OP_FUNC, OP_RET, OP_ENDFUNC, OP_ENDMAIN, OP_END,
+    // memory
+    OP_SAMPLE, OP_LOAD,
+    OP_UAV_LOAD, OP_UAV_STORE, OP_UAV_RAW_LOAD, OP_UAV_RAW_STORE, OP_UAV_STRUCT_LOAD, OP_UAV_STRUCT_STORE, OP_UAV_ATOMIC,
+    OP_LDS_LOAD, OP_LDS_STORE, OP_LDS_LOAD_VEC, OP_LDS_STORE_VEC, OP_LDS_ATOMIC,
+    OP_FENCE
+};
+
+enum host_relop
+{
+    RELOP_EQ, RELOP_NE, RELOP_LT, RELOP_LE, RELOP_GT, RELOP_GE
+};
+
+enum host_atomic
+{
+    ATOMIC_ADD, ATOMIC_SUB, ATOMIC_RSUB, ATOMIC_MIN, ATOMIC_MAX, ATOMIC_UMIN, ATOMIC_UMAX,
+    ATOMIC_AND, ATOMIC_OR, ATOMIC_XOR, ATOMIC_XCHG, ATOMIC_CMP
+};
+
+enum host_operand_kind
+{
+    OPERAND_REGISTER,       // temporary, literal, constant buffer with literal index, input or output register
+    OPERAND_INDEXED,        // x#[index]
+    OPERAND_GLOBAL,         // g[index]
+    OPERAND_CONSTANT,       // cb#[index] with register in index
+    OPERAND_MEMORY          // mem ( write mask of stores )
+};
+
+enum host_special_register
+{
+    SPECIAL_ABS_TID, SPECIAL_ABS_TID_FLAT, SPECIAL_TID_IN_GRP, SPECIAL_TID_IN_GRP_FLAT,
+    SPECIAL_THREAD_GRP_ID, SPECIAL_THREAD_GRP_ID_FLAT, SPECIAL_WIN_COORD
+};
+
+enum host_uav_type
+{
+    UAV_TYPED, UAV_RAW, UAV_STRUCT
+};
+
+// swizzle of constant components
+static const int SWIZZLE_ZERO = 4;
+static const int SWIZZLE_ONE  = 5;
+
+struct host_operand
+{
+    int     kind;
+    int     slot;               // register slot ( first element of indexed temp array )
+    int     size;               // elements of indexed temp array, constant buffer number
+    int     swizzle[4];         // 0-3 for x-w, SWIZZLE_ZERO or SWIZZLE_ONE
+    int     mask;               // write mask of destination
+    int     neg;                // components negated after swizzle
+    bool    abs;
+    int     index_offset;       // index = index_offset + register ( when index_slot>=0 )
+    int     index_slot;
+    int     index_component;
+};
+
+struct host_instruction
+{
+    int             opcode;
+    int             func;       // relop or atomic operation
+    int             resource;   // resource, UAV or LDS id
+    int             offset[2];  // aoffimmi
+    bool            returns;    // atomic returns previous value
+    bool            saturate;
+    bool            alias;      // sources read destination register
+    int             target;     // matching flow control instruction or function body
+    int             line;       // index in parsed code
+    int             count;      // number of operands
+    host_operand    operand[5];
+};
+
+struct host_slot_init
+{
+    int                             slot;
+    int                             source;     // constant buffer or special register
+    int                             element;    // element of constant buffer
+    boost::array<boost::uint32_t,4> value;      // literal
+};
+
+struct host_resource
+{
+    int     dimension;          // 1 or 2
+    bool    normalized;         // sample coordinates in [0,1]
+};
+
+struct host_uav
+{
+    int     type;               // host_uav_type
+    int     stride;             // structure size in bytes
+};
+
+struct host_lds
+{
+    int     size;               // bytes
+    int     stride;             // structure size in bytes ( 0 for raw LDS )
+};
+
+//
+// decoded kernel, registers are numbered with dense slots
+//
+
+struct host_program
+{
+    host_shader_type                    type;
+    int                                 group[3];       // dcl_num_thread_per_group
+    int                                 slot_count;
+    std::vector<host_instruction>       code;
+
+    std::vector<host_slot_init>         literal;
+    std::vector<host_slot_init>         constant;       // cb#[n]
+    std::vector<host_slot_init>         special;        // vAbsTid, vWinCoord0, ...
+    std::vector<std::pair<int,int> >    output;         // slot and o# number
+    std::vector<std::pair<int,int> >    indexed;        // first slot and size of indexed temp arrays
+
+    std::map<int,host_resource>         resource;
+    std::map<int,host_uav>              uav;
+    std::map<int,host_lds>              lds;
+    std::map<int,int>                   function;       // func number and its first instruction
+
+    bool                                uses_global;
+    int                                 max_constant;   // highest cb number ( -1 without constant buffers )
+
+    host_program() : type(HOST_COMPUTE_SHADER), slot_count(0), uses_global(false), max_constant(-1)
+    {
+        group[0] = 64;
+        group[1] = group[2] = 1;
+    }
+};
+
+inline void host_error( const std::string& msg, const std::string& line )
+{
+    throw std::runtime_error("IL interpreter: " + msg + " \"" + line + "\"");
+}
+
+inline std::string trim( const std::string& s )
+{
+    std::string::size_type b = s.find_first_not_of(" \t\r");
+    std::string::size_type e = s.find_last_not_of(" \t\r");
+
+    if( b==std::string::npos ) return std::string();
+    return s.substr(b,e-b+1);
+}
+
+//
+// text inside parentheses after name ( "sample_resource(1)_sampler(0)" and "_sampler" give "0" )
+// empty name gives first argument
+//
+
+inline bool opcode_argument( const std::string& opcode, const char* name, std::string& arg )
+{
+    std::string::size_type p,e;
+
+    if( *name ) {
+        p = opcode.find(std::string(name)+"(");
+        if( p==std::string::npos ) return false;
+        p += std::strlen(name);
+    }
+    else {
+        p = opcode.find('(');
+        if( p==std::string::npos ) return false;
+    }
+
+    e = opcode.find(')',p);
+    if( e==std::string::npos ) return false;
+
+    arg = opcode.substr(p+1,e-p-1);
+    return true;
+}
+
+inline int opcode_number( const std::string& opcode )
+{
+    std::string arg;
+
+    if( !opcode_argument(opcode,"",arg) ) return 0;
+    return std::atoi(arg.c_str());
+}
+
+struct host_opcode_name
+{
+    const char* name;
+    int         opcode;
+    int         func;
+};
+
+//
+// returns false for unknown opcode
+//
+
+inline bool find_opcode( const std::string& op, int& opcode, int& func )
+{
+    static const host_opcode_name table[] = {
+        { "mov", OP_MOV, 0 }, { "add", OP_ADD, 0 }, { "sub", OP_SUB, 0 }, { "mul", OP_MUL, 0 }, { "mad", OP_MAD, 0 },
+        { "fma", OP_FMA, 0 }, { "div", OP_DIV, 0 }, { "mod", OP_MOD, 0 }, { "min", OP_MIN, 0 }, { "max", OP_MAX, 0 },
+        { "abs", OP_ABS, 0 }, { "frc", OP_FRC, 0 }, { "flr", OP_FLR, 0 }, { "rnd", OP_RND, 0 }, { "sqrt", OP_SQRT, 0 },
+        { "rsq", OP_RSQ, 0 }, { "rcp", OP_RCP, 0 }, { "exn", OP_EXN, 0 }, { "ln", OP_LN, 0 }, { "exp", OP_EXP, 0 },
+        { "log", OP_LOG, 0 }, { "sin", OP_SIN, 0 }, { "cos", OP_COS, 0 }, { "eq", OP_EQ, 0 }, { "ne", OP_NE, 0 },
+        { "lt", OP_LT, 0 }, { "ge", OP_GE, 0 }, { "cmov_logical", OP_CMOV_LOGICAL, 0 }, { "dp2", OP_DP2, 0 },
+        { "dp3", OP_DP3, 0 }, { "dp4", OP_DP4, 0 },
+
+        { "iadd", OP_IADD, 0 }, { "inegate", OP_INEGATE, 0 }, { "imul", OP_IMUL, 0 }, { "imul_high", OP_IMUL_HIGH, 0 },
+        { "umul", OP_UMUL, 0 }, { "umul_high", OP_UMUL_HIGH, 0 }, { "imad", OP_IMAD, 0 }, { "umad", OP_UMAD, 0 },
+        { "udiv", OP_UDIV, 0 }, { "umod", OP_UMOD, 0 }, { "iand", OP_IAND, 0 }, { "and", OP_IAND, 0 },
+        { "ior", OP_IOR, 0 }, { "or", OP_IOR, 0 }, { "ixor", OP_IXOR, 0 }, { "inot", OP_INOT, 0 },
+        { "ishl", OP_ISHL, 0 }, { "ishr", OP_ISHR, 0 }, { "ushr", OP_USHR, 0 }, { "ieq", OP_IEQ, 0 },
+        { "ine", OP_INE, 0 }, { "ilt", OP_ILT, 0 }, { "ige", OP_IGE, 0 }, { "ult", OP_ULT, 0 }, { "uge", OP_UGE, 0 },
+        { "imin", OP_IMIN, 0 }, { "imax", OP_IMAX, 0 }, { "umin", OP_UMIN, 0 }, { "umax", OP_UMAX, 0 },
+        { "ibit_extract", OP_IBIT_EXTRACT, 0 }, { "ubit_extract", OP_UBIT_EXTRACT, 0 }, { "bfi", OP_BFI, 0 },
+        { "bitalign", OP_BITALIGN, 0 }, { "bytealign", OP_BYTEALIGN, 0 },
+
+        { "itof", OP_ITOF, 0 }, { "utof", OP_UTOF, 0 }, { "ftoi", OP_FTOI, 0 }, { "ftou", OP_FTOU, 0 },
+        { "f2d", OP_F2D, 0 }, { "d2f", OP_D2F, 0 },
+
+        { "dadd", OP_DADD, 0 }, { "dmul", OP_DMUL, 0 }, { "dmad", OP_DMAD, 0 }, { "ddiv", OP_DDIV, 0 },
+        { "dmin", OP_DMIN, 0 }, { "dmax", OP_DMAX, 0 }, { "deq", OP_DEQ, 0 }, { "dne", OP_DNE, 0 },
+        { "dlt", OP_DLT, 0 }, { "dge", OP_DGE, 0 }, { "dfrac", OP_DFRAC, 0 }, { "dfrexp", OP_DFREXP, 0 },
+        { "dldexp", OP_DLDEXP, 0 }, { "dsqrt", OP_DSQRT, 0 }, { "drsq", OP_DRSQ, 0 }, { "drcp", OP_DRCP, 0 },
+
+        { "whileloop", OP_WHILELOOP, 0 }, { "endloop", OP_ENDLOOP, 0 }, { "break", OP_BREAK, 0 },
+        { "breakc_relop", OP_BREAKC, 0 }, { "break_logicalz", OP_BREAK_LOGICALZ, 0 },
+        { "break_logicalnz", OP_BREAK_LOGICALNZ, 0 }, { "continue", OP_CONTINUE, 0 },
+        { "continuec_relop", OP_CONTINUEC, 0 }, { "continue_logicalz", OP_CONTINUE_LOGICALZ, 0 },
+        { "continue_logicalnz", OP_CONTINUE_LOGICALNZ, 0 }, { "ifnz", OP_IF_LOGICALNZ, 0 },
+        { "if_logicalnz", OP_IF_LOGICALNZ, 0 }, { "if_logicalz", OP_IF_LOGICALZ, 0 }, { "ifc_relop", OP_IFC, 0 },
+        { "else", OP_ELSE, 0 }, { "endif", OP_ENDIF, 0 }, { "call", OP_CALL, 0 }, { "func", OP_FUNC, 0 },
+        { "ret", OP_RET, 0 }, { "ret_dyn", OP_RET, 0 }, { "endfunc", OP_ENDFUNC, 0 }, { "endmain", OP_ENDMAIN, 0 },
+        { "end", OP_END, 0 },
+
+        { "sample_resource", OP_SAMPLE, 0 }, { "load_resource", OP_LOAD, 0 },
+        { "uav_load_id", OP_UAV_LOAD, 0 }, { "uav_store_id", OP_UAV_STORE, 0 },
+        { "uav_raw_load_id", OP_UAV_RAW_LOAD, 0 }, { "uav_raw_store_id", OP_UAV_RAW_STORE, 0 },
+        { "uav_struct_load_id", OP_UAV_STRUCT_LOAD, 0 }, { "uav_struct_store_id", OP_UAV_STRUCT_STORE, 0 },
+        { "lds_load_id", OP_LDS_LOAD, 0 }, { "lds_store_id", OP_LDS_STORE, 0 },
+        { "lds_load_vec_id", OP_LDS_LOAD_VEC, 0 }, { "lds_store_vec_id", OP_LDS_STORE_VEC, 0 },
+        { NULL, 0, 0 }
+    };
+
+    static const host_opcode_name atomic[] = {
+        { "add", 0, ATOMIC_ADD }, { "sub", 0, ATOMIC_SUB }, { "rsub", 0, ATOMIC_RSUB }, { "min", 0, ATOMIC_MIN },
+        { "max", 0, ATOMIC_MAX }, { "umin", 0, ATOMIC_UMIN }, { "umax", 0, ATOMIC_UMAX }, { "and", 0, ATOMIC_AND },
+        { "or", 0, ATOMIC_OR }, { "xor", 0, ATOMIC_XOR }, { "xchg", 0, ATOMIC_XCHG }, { "cmp", 0, ATOMIC_CMP },
+        { "cmp_xchg", 0, ATOMIC_CMP }, { NULL, 0, 0 }
+    };
+
+    const host_opcode_name* t;
+
+    for(t=table;t->name;t++) {
+        if( op==t->name ) {
+            opcode = t->opcode;
+            func   = t->func;
+            return true;
+        }
+    }
+
+    // uav_add_id, uav_read_add_id, lds_add_id, lds_read_add_resource, ...
+    if( op.compare(0,4,"uav_")==0 || op.compare(0,4,"lds_")==0 ) {
+        std::string::size_type  e = op.rfind('_');
+        std::string             name = op.substr(4,e==std::string::npos ? std::string::npos : e-4);
+        std::string             suffix = e==std::string::npos ? "" : op.substr(e);
+
+        if( suffix!="_id" && suffix!="_resource" ) return false;
+        if( name.compare(0,5,"read_")==0 ) name = name.substr(5);
+
+        for(t=atomic;t->name;t++) {
+            if( name==t->name ) {
+                opcode = op[0]=='u' ? OP_UAV_ATOMIC : OP_LDS_ATOMIC;
+                func   = t->func;
+                return true;
+            }
+        }
+    }
+
+    if( op.compare(0,5,"fence")==0 ) {
+        opcode = OP_FENCE;
+        func   = 0;
+        return true;
+    }
+
+    return false;
+}
+
+//
+// assigns dense slots to registers
+//
+
+class host_decoder
+{
+protected:
+    host_program&               program;
+    std::map<std::string,int>   slot;
+    std::map<int,int>           indexed_size;
+    std::string                 line;
+
+    void error( const std::string& msg ) const
+    {
+        host_error(msg,line);
+    }
+
+    int new_slots( int n )
+    {
+        int s = program.slot_count;
+        program.slot_count += n;
+        return s;
+    }
+
+    int special_register( const std::string& name )
+    {
+        if( name=="vAbsTid" ) return SPECIAL_ABS_TID;
+        if( name=="vAbsTidFlat" ) return SPECIAL_ABS_TID_FLAT;
+        if( name=="vTidInGrp" ) return SPECIAL_TID_IN_GRP;
+        if( name=="vTidInGrpFlat" ) return SPECIAL_TID_IN_GRP_FLAT;
+        if( name=="vThreadGrpId" ) return SPECIAL_THREAD_GRP_ID;
+        if( name=="vThreadGrpIdFlat" ) return SPECIAL_THREAD_GRP_ID_FLAT;
+        if( name=="vWinCoord0" ) return SPECIAL_WIN_COORD;
+        return -1;
+    }
+
+    //
+    // slot of plain register ( "r5", "l2", "cb0[3]", "vAbsTid", "o0" )
+    //
+
+    int register_slot( const std::string& name )
+    {
+        std::map<std::string,int>::iterator i = slot.find(name);
+        host_slot_init                      init;
+        int                                 s,k;
+
+        if( i!=slot.end() ) return i->second;
+        if( name.empty() ) error("missing register");
+
+        init.source  = 0;
+        init.element = 0;
+        init.value.assign(0);
+
+        if( name[0]=='r' && temp_register(name)>=0 ) {
+            s = new_slots(1);
+        }
+        else if( name[0]=='o' && name.length()>1 && std::isdigit(name[1]) ) {
+            s = new_slots(1);
+            program.output.push_back( std::make_pair(s,std::atoi(name.c_str()+1)) );
+        }
+        else if( name.compare(0,2,"cb")==0 ) {
+            std::string::size_type p = name.find('[');
+
+            if( p==std::string::npos ) error("invalid constant buffer");
+            s = new_slots(1);
+            init.slot    = s;
+            init.source  = std::atoi(name.c_str()+2);
+            init.element = std::atoi(name.c_str()+p+1);
+            program.constant.push_back(init);
+            program.max_constant = std::max(program.max_constant,init.source);
+        }
+        else if( (k=special_register(name))>=0 ) {
+            s = new_slots(1);
+            init.slot   = s;
+            init.source = k;
+            program.special.push_back(init);
+        }
+        else {
+            error("unknown register " + name);
+        }
+
+        slot[name] = s;
+        return s;
+    }
+
+    static int temp_register( const std::string& name )
+    {
+        return cal::il::detail::temp_register(name);
+    }
+
+    //
+    // "r5.x+2", "vAbsTidFlat.x", "12"
+    //
+
+    void parse_index( const std::string& expr, host_operand& op )
+    {
+        std::string::size_type  p=0,e;
+
+        op.index_offset    = 0;
+        op.index_slot      = -1;
+        op.index_component = 0;
+
+        while( p<=expr.length() ) {
+            e = expr.find('+',p);
+            if( e==std::string::npos ) e = expr.length();
+
+            std::string term = trim(expr.substr(p,e-p));
+
+            if( term.empty() ) error("invalid index");
+            if( std::isdigit(term[0]) ) op.index_offset += std::atoi(term.c_str());
+            else {
+                std::string::size_type d = term.find('.');
+
+                if( op.index_slot>=0 ) error("index with two registers");
+                op.index_slot = register_slot(term.substr(0,d));
+                if( d!=std::string::npos && d+1<term.length() ) {
+                    op.index_component = cal::il::detail::swizzle_component(term.substr(d+1),0);
+                    if( op.index_component<0 ) error("invalid index component");
+                }
+            }
+
+            p = e+1;
+        }
+    }
+
+    void parse_modifier( const std::string& mod, host_operand& op )
+    {
+        std::string::size_type p=0;
+
+        op.neg = 0;
+        op.abs = false;
+
+        while( p<mod.length() ) {
+            if( mod.compare(p,5,"_neg(")==0 ) {
+                std::string::size_type e = mod.find(')',p);
+
+                if( e==std::string::npos ) error("invalid modifier");
+                op.neg |= cal::il::detail::component_mask(mod.substr(p+5,e-p-5));
+                p = e+1;
+            }
+            else if( mod.compare(p,4,"_abs")==0 ) {
+                op.abs = true;
+                p += 4;
+            }
+            else error("unsupported modifier " + mod.substr(p));
+        }
+    }
+
+    host_operand parse_operand( const instruction_operand& src )
+    {
+        host_operand            op;
+        std::string             name = trim(src.name);
+        std::string::size_type  p = name.find('[');
+        int                     c;
+
+        op.kind            = OPERAND_REGISTER;
+        op.slot            = -1;
+        op.size            = 0;
+        op.mask            = cal::il::detail::component_mask(src.swizzle);
+        op.index_offset    = 0;
+        op.index_slot      = -1;
+        op.index_component = 0;
+
+        for(c=0;c<4;c++) {
+            int s = cal::il::detail::swizzle_component(src.swizzle,c);
+            op.swizzle[c] = s>=0 ? s : (s==-2 ? SWIZZLE_ONE : SWIZZLE_ZERO);
+        }
+        parse_modifier(src.modifier,op);
+
+        if( name=="mem" ) {
+            op.kind = OPERAND_MEMORY;
+        }
+        else if( p!=std::string::npos ) {
+            std::string base  = name.substr(0,p);
+            std::string index = name.substr(p+1,name.rfind(']')-p-1);
+
+            if( base=="g" ) {
+                op.kind = OPERAND_GLOBAL;
+                program.uses_global = true;
+                parse_index(index,op);
+            }
+            else if( base[0]=='x' ) {
+                std::map<int,int>::iterator i = indexed_size.find(std::atoi(base.c_str()+1));
+
+                if( i==indexed_size.end() ) error("undeclared indexed temp array");
+                op.kind = OPERAND_INDEXED;
+                op.slot = register_slot(base);
+                op.size = i->second;
+                parse_index(index,op);
+                if( op.index_slot<0 ) {
+                    if( op.index_offset>=op.size ) error("index out of range");
+                    op.kind = OPERAND_REGISTER;
+                    op.slot += op.index_offset;
+                }
+            }
+            else if( base.compare(0,2,"cb")==0 ) {
+                parse_index(index,op);
+                if( op.index_slot<0 ) op.slot = register_slot(name);
+                else {
+                    op.kind = OPERAND_CONSTANT;
+                    op.size = std::atoi(base.c_str()+2);
+                    program.max_constant = std::max(program.max_constant,op.size);
+                }
+            }
+            else error("unknown register " + name);
+        }
+        else {
+            if( name[0]=='l' && slot.find(name)==slot.end() ) error("undeclared literal " + name);
+            op.slot = register_slot(name);
+        }
+
+        return op;
+    }
+
+    //
+    // destination is read by one of sources ( result must not be written before sources are read )
+    //
+
+    static bool reads_destination( const host_instruction& inst )
+    {
+        const host_operand& d = inst.operand[0];
+
+        if( d.kind!=OPERAND_REGISTER ) return true;
+        for(int k=1;k<inst.count;k++) {
+            const host_operand& s = inst.operand[k];
+
+            if( s.kind==OPERAND_INDEXED ) return true;
+            if( s.kind==OPERAND_REGISTER && s.slot==d.slot ) return true;
+            if( s.index_slot==d.slot ) return true;
+        }
+
+        return false;
+    }
+
+    void declaration( const instruction& inst )
+    {
+        std::string op = cal::il::detail::base_opcode(inst.opcode);
+
+        if( op.compare(0,3,"il_")==0 ) {
+            program.type = op.compare(0,5,"il_ps")==0 ? HOST_PIXEL_SHADER : HOST_COMPUTE_SHADER;
+        }
+        else if( op=="dcl_num_thread_per_group" ) {
+            for(unsigned k=0;k<3;k++) program.group[k] = k<inst.operand.size() ? std::max(std::atoi(trim(inst.operand[k].name).c_str()),1) : 1;
+        }
+        else if( op=="dcl_literal" ) {
+            host_slot_init init;
+
+            if( inst.operand.size()!=5 ) error("invalid literal");
+            init.slot    = register_slot_new(trim(inst.operand[0].name));
+            init.source  = 0;
+            init.element = 0;
+            for(int c=0;c<4;c++) init.value[c] = (boost::uint32_t)std::strtoul(trim(inst.operand[c+1].str()).c_str(),NULL,0);
+            program.literal.push_back(init);
+        }
+        else if( op=="dcl_indexed_temp_array" ) {
+            std::string             name = trim(inst.operand.empty() ? std::string() : inst.operand[0].name);
+            std::string::size_type  p = name.find('[');
+            int                     size;
+
+            if( p==std::string::npos || name[0]!='x' ) error("invalid indexed temp array");
+            size = std::atoi(name.c_str()+p+1);
+            indexed_size[std::atoi(name.c_str()+1)] = size;
+            slot[name.substr(0,p)] = new_slots(size);
+            program.indexed.push_back( std::make_pair(slot[name.substr(0,p)],size) );
+        }
+        else if( op=="dcl_resource_id" ) {
+            host_resource   r;
+            std::string     type;
+
+            opcode_argument(inst.opcode,"_type",type);
+            r.dimension  = type.compare(0,2,"1d")==0 || type.compare(0,6,"buffer")==0 ? 1 : 2;
+            r.normalized = type.find("unnorm")==std::string::npos;
+            program.resource[opcode_number(inst.opcode)] = r;
+        }
+        else if( op=="dcl_uav_id" || op=="dcl_raw_uav_id" || op=="dcl_struct_uav_id" ) {
+            host_uav u;
+
+            u.type   = op=="dcl_uav_id" ? UAV_TYPED : (op=="dcl_raw_uav_id" ? UAV_RAW : UAV_STRUCT);
+            u.stride = u.type==UAV_STRUCT && !inst.operand.empty() ? std::atoi(trim(inst.operand[0].name).c_str()) : 4;
+            program.uav[opcode_number(inst.opcode)] = u;
+        }
+        else if( op=="dcl_lds_id" || op=="dcl_struct_lds_id" ) {
+            host_lds l;
+
+            if( op=="dcl_lds_id" ) {
+                l.stride = 0;
+                l.size   = inst.operand.empty() ? 0 : std::atoi(trim(inst.operand[0].name).c_str());
+            }
+            else {
+                if( inst.operand.size()<2 ) error("invalid LDS declaration");
+                l.stride = std::atoi(trim(inst.operand[0].name).c_str());
+                l.size   = l.stride*std::atoi(trim(inst.operand[1].name).c_str());
+            }
+            program.lds[opcode_number(inst.opcode)] = l;
+        }
+        // dcl_cb, dcl_output_generic, dcl_input_position_interp, ... need no action
+    }
+
+    int register_slot_new( const std::string& name )
+    {
+        int s = new_slots(1);
+        slot[name] = s;
+        return s;
+    }
+
+    void decode( const instruction& inst, int index )
+    {
+        host_instruction    h;
+        std::string         op = cal::il::detail::base_opcode(inst.opcode);
+        std::string         arg;
+
+        std::memset(&h,0,sizeof(h));
+        h.line   = index;
+        h.target = -1;
+
+        if( op.length()>4 && op.compare(op.length()-4,4,"_sat")==0 ) {
+            h.saturate = true;
+            op = op.substr(0,op.length()-4);
+        }
+        if( op.length()>5 && op.compare(op.length()-5,5,"_ieee")==0 ) op = op.substr(0,op.length()-5);
+        if( op.length()>7 && op.compare(op.length()-7,7,"_zeroop")==0 ) op = op.substr(0,op.length()-7);
+
+        if( !find_opcode(op,h.opcode,h.func) ) error("unsupported instruction");
+
+        if( h.opcode==OP_UAV_ATOMIC || h.opcode==OP_LDS_ATOMIC ) h.returns = op.find("_read_")!=std::string::npos;
+
+        if( h.opcode==OP_IFC || h.opcode==OP_BREAKC || h.opcode==OP_CONTINUEC ) {
+            static const char* relop[] = { "eq", "ne", "lt", "le", "gt", "ge", NULL };
+
+            opcode_argument(inst.opcode,"",arg);
+            for(h.func=0;relop[h.func] && arg!=relop[h.func];h.func++);
+            if( !relop[h.func] ) error("unknown relop");
+        }
+
+        if( h.opcode==OP_SAMPLE || h.opcode==OP_LOAD || (h.opcode>=OP_UAV_LOAD && h.opcode<=OP_LDS_ATOMIC) ) {
+            h.resource = opcode_number(inst.opcode);
+            if( opcode_argument(inst.opcode,"_aoffimmi",arg) ) {
+                h.offset[0] = (int)std::atof(arg.c_str());
+                if( arg.find(',')!=std::string::npos ) h.offset[1] = (int)std::atof(arg.c_str()+arg.find(',')+1);
+            }
+        }
+
+        if( h.opcode==OP_CALL || h.opcode==OP_FUNC ) {
+            if( inst.operand.empty() ) error("missing function number");
+            h.resource = std::atoi(trim(inst.operand[0].name).c_str());
+            if( h.opcode==OP_FUNC ) program.function[h.resource] = (int)program.code.size();
+        }
+        else {
+            if( inst.operand.size()>5 ) error("too many operands");
+            h.count = (int)inst.operand.size();
+            for(int k=0;k<h.count;k++) h.operand[k] = parse_operand(inst.operand[k]);
+        }
+
+        if( h.opcode==OP_SAMPLE || h.opcode==OP_LOAD ) {
+            if( program.resource.find(h.resource)==program.resource.end() ) error("undeclared resource");
+        }
+        if( h.opcode>=OP_UAV_LOAD && h.opcode<=OP_UAV_ATOMIC ) {
+            if( program.uav.find(h.resource)==program.uav.end() ) error("undeclared UAV");
+        }
+        if( h.opcode>=OP_LDS_LOAD && h.opcode<=OP_LDS_ATOMIC ) {
+            if( program.lds.find(h.resource)==program.lds.end() ) error("undeclared LDS");
+        }
+
+        if( h.count>0 ) h.alias = reads_destination(h);
+
+        program.code.push_back(h);
+    }
+
+    //
+    // matching if/else/endif, whileloop/endloop, break/continue and their loop, call and function body
+    //
+
+    void link()
+    {
+        std::vector<int>                stack;
+        std::vector<std::vector<int> >  exits;
+        int                             i;
+
+        for(i=0;i<(int)program.code.size();i++) {
+            host_instruction& h = program.code[i];
+
+            switch( h.opcode ) {
+            case OP_IF_LOGICALNZ:
+            case OP_IF_LOGICALZ:
+            case OP_IFC:
+            case OP_WHILELOOP:
+                stack.push_back(i);
+                if( h.opcode==OP_WHILELOOP ) exits.push_back(std::vector<int>());
+                break;
+            case OP_ELSE:
+                if( stack.empty() || program.code[stack.back()].opcode==OP_WHILELOOP ) host_error("unbalanced else","");
+                program.code[stack.back()].target = i;
+                stack.back() = i;
+                break;
+            case OP_ENDIF:
+                if( stack.empty() || program.code[stack.back()].opcode==OP_WHILELOOP ) host_error("unbalanced endif","");
+                program.code[stack.back()].target = i;
+                stack.pop_back();
+                break;
+            case OP_ENDLOOP:
+                if( stack.empty() || program.code[stack.back()].opcode!=OP_WHILELOOP ) host_error("unbalanced endloop","");
+                program.code[stack.back()].target = i;
+                h.target = stack.back();
+                for(unsigned k=0;k<exits.back().size();k++) program.code[exits.back()[k]].target = i;
+                exits.pop_back();
+                stack.pop_back();
+                break;
+            case OP_BREAK:
+            case OP_BREAKC:
+            case OP_BREAK_LOGICALZ:
+            case OP_BREAK_LOGICALNZ:
+            case OP_CONTINUE:
+            case OP_CONTINUEC:
+            case OP_CONTINUE_LOGICALZ:
+            case OP_CONTINUE_LOGICALNZ:
+                if( exits.empty() ) host_error("break or continue outside of loop","");
+                exits.back().push_back(i);
+                break;
+            case OP_FUNC:
+            case OP_ENDFUNC:
+            case OP_ENDMAIN:
+            case OP_END:
+                if( !stack.empty() ) host_error("unbalanced flow control","");
+                break;
+            }
+        }
+
+        if( !stack.empty() ) host_error("unbalanced flow control","");
+
+        for(i=0;i<(int)program.code.size();i++) {
+            host_instruction&           h = program.code[i];
+            std::map<int,int>::iterator f;
+
+            if( h.opcode!=OP_CALL ) continue;
+            f = program.function.find(h.resource);
+            if( f==program.function.end() ) host_error("call of undefined function","");
+            h.target = f->second+1;
+        }
+    }
+
+public:
+    host_decoder( host_program& p ) : program(p) {}
+
+    void compile( const std::string& source )
+    {
+        instruction_list        code;
+        std::string::size_type  p,e;
+        unsigned                i;
+
+        // lines are trimmed, generated code can be indented
+        for(p=0;p<source.length();p=e+1) {
+            e = source.find('\n',p);
+            if( e==std::string::npos ) e = source.length();
+            code.push_back( cal::il::detail::parse_instruction(trim(source.substr(p,e-p))) );
+        }
+
+        // declarations can follow instructions only in theory, they are read first
+        for(i=0;i<code.size();i++) {
+            if( code[i].opcode.empty() || !cal::il::detail::is_declaration(code[i]) ) continue;
+            line = code[i].str();
+            declaration(code[i]);
+        }
+
+        for(i=0;i<code.size();i++) {
+            if( code[i].opcode.empty() || cal::il::detail::is_declaration(code[i]) ) continue;
+            line = code[i].str();
+            decode(code[i],(int)i);
+        }
+
+        if( program.code.empty() || program.code.back().opcode!=OP_END ) {
+            host_instruction h;
+
+            std::memset(&h,0,sizeof(h));
+            h.opcode = OP_END;
+            h.target = -1;
+            program.code.push_back(h);
+        }
+
+        link();
+    }
+};
+
+} // detail
+
+//
+// decodes complete IL kernel ( header and code )
+// std::runtime_error is thrown for instructions outside of supported subset
+//
+
+inline void compile( const std::string& source, detail::host_program& program )
+{
+    program = detail::host_program();
+    detail::host_decoder(program).compile(source);
+}
+
+} // host
+} // il
+} // cal
+
+#endif
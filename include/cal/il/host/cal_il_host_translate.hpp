@@ -0,0 +1,900 @@
+/*
+ * C++ to IL compiler/generator translation of IL kernels to C++
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_HOST_TRANSLATE_H
+#define __CAL_IL_HOST_TRANSLATE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <ostream>
+#include <boost/cstdint.hpp>
+#include <boost/format.hpp>
+#include <cal/il/host/cal_il_host_program.hpp>
+
+namespace cal {
+namespace il {
+namespace host {
+namespace detail {
+
+//
+// interface of translated kernel, layout is repeated in generated code ( see native_prelude )
+// version is changed with any change of layout or of generated code semantics
+//
+
+static const int NATIVE_ABI_VERSION = 1;
+static const int NATIVE_INPUTS      = 128;
+static const int NATIVE_OUTPUTS     = 8;
+static const int NATIVE_CONSTANTS   = 16;
+static const int NATIVE_UAVS        = 16;
+
+struct native_image
+{
+    boost::uint32_t*    data;
+    int                 width;
+    int                 height;
+    int                 components;
+};
+
+struct native_args
+{
+    int             count[3];       // number of groups
+    int             domain[2];      // pixel shader domain
+    native_image    global;
+    native_image    input[NATIVE_INPUTS];
+    native_image    output[NATIVE_OUTPUTS];
+    native_image    constant[NATIVE_CONSTANTS];
+    native_image    uav[NATIVE_UAVS];
+};
+
+// entry points of shared object
+typedef int  (*native_abi_function)();
+typedef void (*native_run_function)( const native_args* args, int first, int count );
+
+//
+// types and helpers of generated code, semantics follow cal_il_host_alu.hpp and host_executor
+//
+
+inline std::string native_prelude()
+{
+    std::ostringstream s;
+
+    s << "#include <cmath>\n"
+         "#include <cstring>\n"
+         "\n"
+         "namespace {\n"
+         "\n"
+         "typedef unsigned int       u32;\n"
+         "typedef int                i32;\n"
+         "typedef unsigned long long u64;\n"
+         "typedef long long          i64;\n"
+         "\n"
+         "union W { u32 u; i32 i; float f; };\n"
+         "struct V { W c[4]; };\n"
+         "\n"
+         "struct native_image { u32* data; int width; int height; int components; };\n"
+         "struct native_args\n"
+         "{\n"
+         "    int             count[3];\n"
+         "    int             domain[2];\n"
+         "    native_image    global;\n"
+         "    native_image    input[" << NATIVE_INPUTS << "];\n"
+         "    native_image    output[" << NATIVE_OUTPUTS << "];\n"
+         "    native_image    constant[" << NATIVE_CONSTANTS << "];\n"
+         "    native_image    uav[" << NATIVE_UAVS << "];\n"
+         "};\n"
+         "\n"
+         "inline W wu( u32 v ) { W r; r.u = v; return r; }\n"
+         "inline W wi( i32 v ) { W r; r.i = v; return r; }\n"
+         "inline W wf( float v ) { W r; r.f = v; return r; }\n"
+         "inline u32 bm( bool c ) { return c ? 0xFFFFFFFFu : 0u; }\n"
+         "inline W wneg( W a ) { a.u ^= 0x80000000u; return a; }\n"
+         "inline W wabs( W a ) { a.u &= 0x7FFFFFFFu; return a; }\n"
+         "inline W wsat( W a ) { return wf(a.f>0.0f ? (a.f<1.0f ? a.f : 1.0f) : 0.0f); }\n"
+         "\n"
+         "inline W op_mov( W a ) { return a; }\n"
+         "inline W op_abs( W a ) { return wu(a.u&0x7FFFFFFFu); }\n"
+         "inline W op_frc( W a ) { return wf(a.f-std::floor(a.f)); }\n"
+         "inline W op_flr( W a ) { return wf(std::floor(a.f)); }\n"
+         "inline W op_rnd( W a ) { float t = std::floor(a.f+0.5f); return wf((t-a.f==0.5f && std::fmod(t,2.0f)!=0) ? t-1.0f : t); }\n"
+         "inline W op_sqrt( W a ) { return wf(std::sqrt(a.f)); }\n"
+         "inline W op_rsq( W a ) { return wf(1.0f/std::sqrt(std::fabs(a.f))); }\n"
+         "inline W op_rcp( W a ) { return wf(1.0f/a.f); }\n"
+         "inline W op_exn( W a ) { return wf(std::exp(a.f)); }\n"
+         "inline W op_ln( W a ) { return wf(std::log(a.f)); }\n"
+         "inline W op_exp( W a ) { return wf(std::pow(2.0f,a.f)); }\n"
+         "inline W op_log( W a ) { return wf(std::log(a.f)/0.693147180559945f); }\n"
+         "inline W op_sin( W a ) { return wf(std::sin(a.f)); }\n"
+         "inline W op_cos( W a ) { return wf(std::cos(a.f)); }\n"
+         "inline W op_add( W a, W b ) { return wf(a.f+b.f); }\n"
+         "inline W op_sub( W a, W b ) { return wf(a.f-b.f); }\n"
+         "inline W op_mul( W a, W b ) { return wf(a.f*b.f); }\n"
+         "inline W op_div( W a, W b ) { return wf(a.f/b.f); }\n"
+         "inline W op_mod( W a, W b ) { return wf(std::fmod(a.f,b.f)); }\n"
+         "inline W op_min( W a, W b ) { return (b.f<a.f || a.f!=a.f) ? b : a; }\n"
+         "inline W op_max( W a, W b ) { return (b.f>a.f || a.f!=a.f) ? b : a; }\n"
+         "inline W op_eq( W a, W b ) { return wu(bm(a.f==b.f)); }\n"
+         "inline W op_ne( W a, W b ) { return wu(bm(a.f!=b.f)); }\n"
+         "inline W op_lt( W a, W b ) { return wu(bm(a.f<b.f)); }\n"
+         "inline W op_ge( W a, W b ) { return wu(bm(a.f>=b.f)); }\n"
+         "inline W op_mad( W a, W b, W c ) { return wf(a.f*b.f+c.f); }\n"
+         "inline W op_fma( W a, W b, W c ) { return wf((float)((double)a.f*b.f+c.f)); }\n"
+         "inline W op_cmov( W a, W b, W c ) { return a.u ? b : c; }\n"
+         "\n"
+         "inline W op_inegate( W a ) { return wu(0u-a.u); }\n"
+         "inline W op_inot( W a ) { return wu(~a.u); }\n"
+         "inline W op_iadd( W a, W b ) { return wu(a.u+b.u); }\n"
+         "inline W op_imul( W a, W b ) { return wu(a.u*b.u); }\n"
+         "inline W op_imul_high( W a, W b ) { return wu((u32)(((i64)a.i*b.i)>>32)); }\n"
+         "inline W op_umul_high( W a, W b ) { return wu((u32)(((u64)a.u*b.u)>>32)); }\n"
+         "inline W op_udiv( W a, W b ) { return wu(b.u ? a.u/b.u : 0xFFFFFFFFu); }\n"
+         "inline W op_umod( W a, W b ) { return wu(b.u ? a.u%b.u : 0xFFFFFFFFu); }\n"
+         "inline W op_iand( W a, W b ) { return wu(a.u&b.u); }\n"
+         "inline W op_ior( W a, W b ) { return wu(a.u|b.u); }\n"
+         "inline W op_ixor( W a, W b ) { return wu(a.u^b.u); }\n"
+         "inline W op_ishl( W a, W b ) { return wu(a.u<<(b.u&31)); }\n"
+         "inline W op_ishr( W a, W b ) { return wi(a.i>>(b.u&31)); }\n"
+         "inline W op_ushr( W a, W b ) { return wu(a.u>>(b.u&31)); }\n"
+         "inline W op_ieq( W a, W b ) { return wu(bm(a.u==b.u)); }\n"
+         "inline W op_ine( W a, W b ) { return wu(bm(a.u!=b.u)); }\n"
+         "inline W op_ilt( W a, W b ) { return wu(bm(a.i<b.i)); }\n"
+         "inline W op_ige( W a, W b ) { return wu(bm(a.i>=b.i)); }\n"
+         "inline W op_ult( W a, W b ) { return wu(bm(a.u<b.u)); }\n"
+         "inline W op_uge( W a, W b ) { return wu(bm(a.u>=b.u)); }\n"
+         "inline W op_imin( W a, W b ) { return b.i<a.i ? b : a; }\n"
+         "inline W op_imax( W a, W b ) { return b.i>a.i ? b : a; }\n"
+         "inline W op_umin( W a, W b ) { return b.u<a.u ? b : a; }\n"
+         "inline W op_umax( W a, W b ) { return b.u>a.u ? b : a; }\n"
+         "inline W op_imad( W a, W b, W c ) { return wu(a.u*b.u+c.u); }\n"
+         "inline W op_bfi( W a, W b, W c ) { return wu((a.u&b.u) | (~a.u&c.u)); }\n"
+         "inline W op_ubit_extract( W a, W b, W c )\n"
+         "{\n"
+         "    u32 w = a.u&31, o = b.u&31;\n"
+         "    if( w==0 ) return wu(0u);\n"
+         "    if( w+o<32 ) return wu((c.u<<(32-w-o))>>(32-w));\n"
+         "    return wu(c.u>>o);\n"
+         "}\n"
+         "inline W op_ibit_extract( W a, W b, W c )\n"
+         "{\n"
+         "    u32 w = a.u&31, o = b.u&31;\n"
+         "    if( w==0 ) return wu(0u);\n"
+         "    if( w+o<32 ) return wi((i32)(c.u<<(32-w-o))>>(32-w));\n"
+         "    return wi(c.i>>o);\n"
+         "}\n"
+         "inline W op_bitalign( W a, W b, W c ) { return wu((u32)((((u64)a.u<<32)|b.u)>>(c.u&31))); }\n"
+         "inline W op_bytealign( W a, W b, W c ) { return wu((u32)((((u64)a.u<<32)|b.u)>>(8*(c.u&3)))); }\n"
+         "\n"
+         "inline W op_itof( W a ) { return wf((float)a.i); }\n"
+         "inline W op_utof( W a ) { return wf((float)a.u); }\n"
+         "inline W op_ftoi( W a )\n"
+         "{\n"
+         "    if( a.f!=a.f ) return wi(0);\n"
+         "    if( a.f>=2147483648.0f ) return wi(0x7FFFFFFF);\n"
+         "    if( a.f<=-2147483648.0f ) return wu(0x80000000u);\n"
+         "    return wi((i32)a.f);\n"
+         "}\n"
+         "inline W op_ftou( W a )\n"
+         "{\n"
+         "    if( a.f!=a.f || a.f<=0.0f ) return wu(0u);\n"
+         "    if( a.f>=4294967296.0f ) return wu(0xFFFFFFFFu);\n"
+         "    return wu((u32)a.f);\n"
+         "}\n"
+         "\n"
+         "inline double md( W lo, W hi ) { u64 u = ((u64)hi.u<<32) | lo.u; double d; std::memcpy(&d,&u,8); return d; }\n"
+         "inline void sd( double d, W* t ) { u64 u; std::memcpy(&u,&d,8); t[0].u = (u32)u; t[1].u = (u32)(u>>32); t[2] = t[0]; t[3] = t[1]; }\n"
+         "inline void rep( u32 v, W* t ) { t[0].u = t[1].u = t[2].u = t[3].u = v; }\n"
+         "inline double op_dadd( double a, double b ) { return a+b; }\n"
+         "inline double op_dmul( double a, double b ) { return a*b; }\n"
+         "inline double op_ddiv( double a, double b ) { return a/b; }\n"
+         "inline double op_dmin( double a, double b ) { return (b<a || a!=a) ? b : a; }\n"
+         "inline double op_dmax( double a, double b ) { return (b>a || a!=a) ? b : a; }\n"
+         "inline double op_dfrac( double a ) { return a-std::floor(a); }\n"
+         "inline double op_dsqrt( double a ) { return std::sqrt(a); }\n"
+         "inline double op_drsq( double a ) { return 1.0/std::sqrt(a); }\n"
+         "inline double op_drcp( double a ) { return 1.0/a; }\n"
+         "inline bool op_deq( double a, double b ) { return a==b; }\n"
+         "inline bool op_dne( double a, double b ) { return a!=b; }\n"
+         "inline bool op_dlt( double a, double b ) { return a<b; }\n"
+         "inline bool op_dge( double a, double b ) { return a>=b; }\n"
+         "\n"
+         "inline bool inside( int p, int n, int size ) { return p>=0 && p+n<=size; }\n"
+         "inline int clamp( int v, int a, int b ) { return v<a ? a : (v>b ? b : v); }\n"
+         "inline u32 element( const native_image& m, int e, int c ) { if( c<m.components ) return m.data[e*m.components+c]; return c==3 ? 0x3F800000u : 0u; }\n"
+         "inline W rdm( const native_image& m, int i, int c ) { return wu((i<0 || i>=m.width*m.height) ? 0u : element(m,i,c)); }\n"
+         "inline void wrm( const native_image& m, int i, int c, W v ) { if( c<m.components && i>=0 && i<m.width*m.height ) m.data[i*m.components+c] = v.u; }\n"
+         "inline W rdx( const V* x, int n, int i, int c ) { return (i<0 || i>=n) ? wu(0u) : x[i].c[c]; }\n"
+         "inline void wrx( V* x, int n, int i, int c, W v ) { if( i>=0 && i<n ) x[i].c[c] = v; }\n"
+         "\n"
+         "inline void sample( const native_image& m, int dimension, bool normalized, int ox, int oy, W a0, W a1, W* t )\n"
+         "{\n"
+         "    float u = a0.f, v = dimension==2 ? a1.f : 0.0f;\n"
+         "    if( normalized ) { u *= m.width; v *= m.height; }\n"
+         "    int x = clamp((int)std::floor(u)+ox,0,m.width-1), y = clamp((int)std::floor(v)+oy,0,m.height-1);\n"
+         "    for(int c=0;c<4;c++) t[c].u = element(m,y*m.width+x,c);\n"
+         "}\n"
+         "inline void load( const native_image& m, int dimension, W a0, W a1, W* t )\n"
+         "{\n"
+         "    int x = a0.i, y = dimension==2 ? a1.i : 0;\n"
+         "    bool in = x>=0 && x<m.width && y>=0 && y<m.height;\n"
+         "    for(int c=0;c<4;c++) t[c].u = in ? element(m,y*m.width+x,c) : 0u;\n"
+         "}\n"
+         "\n"
+         "inline u32 atomic_value( int func, u32 old, u32 value, u32 compare )\n"
+         "{\n"
+         "    switch( func ) {\n"
+         "    case " << ATOMIC_ADD << ": return old+value;\n"
+         "    case " << ATOMIC_SUB << ": return old-value;\n"
+         "    case " << ATOMIC_RSUB << ": return value-old;\n"
+         "    case " << ATOMIC_MIN << ": return (i32)value<(i32)old ? value : old;\n"
+         "    case " << ATOMIC_MAX << ": return (i32)value>(i32)old ? value : old;\n"
+         "    case " << ATOMIC_UMIN << ": return value<old ? value : old;\n"
+         "    case " << ATOMIC_UMAX << ": return value>old ? value : old;\n"
+         "    case " << ATOMIC_AND << ": return old&value;\n"
+         "    case " << ATOMIC_OR << ": return old|value;\n"
+         "    case " << ATOMIC_XOR << ": return old^value;\n"
+         "    case " << ATOMIC_XCHG << ": return value;\n"
+         "    case " << ATOMIC_CMP << ": return old==compare ? value : old;\n"
+         "    }\n"
+         "    return old;\n"
+         "}\n"
+         "\n"
+         "inline int uav_address( const native_image& m, int type, int stride, W a0, W a1 )\n"
+         "{\n"
+         "    if( type==" << UAV_TYPED << " ) return a0.i*m.components;\n"
+         "    if( type==" << UAV_RAW << " ) return (int)(a0.u>>2);\n"
+         "    return (int)((a0.u*stride+a1.u)>>2);\n"
+         "}\n"
+         "inline void uav_load( const native_image& m, int type, int stride, W a0, W a1, W* t )\n"
+         "{\n"
+         "    int size = m.width*m.height*m.components, p = uav_address(m,type,stride,a0,a1);\n"
+         "    for(int c=0;c<4;c++) {\n"
+         "        if( type==" << UAV_TYPED << " ) t[c].u = inside(p,m.components,size) ? element(m,p/m.components,c) : 0u;\n"
+         "        else t[c].u = inside(p+c,1,size) ? m.data[p+c] : 0u;\n"
+         "    }\n"
+         "}\n"
+         "inline void uav_store( const native_image& m, int type, int stride, W a0, W a1, const W* v, int mask )\n"
+         "{\n"
+         "    int size = m.width*m.height*m.components, p = uav_address(m,type,stride,a0,a1);\n"
+         "    if( type==" << UAV_TYPED << " ) mask = (1<<m.components)-1;\n"
+         "    for(int c=0;c<4;c++) if( (mask&(1<<c)) && inside(p+c,1,size) ) m.data[p+c] = v[c].u;\n"
+         "}\n"
+         "inline u32 uav_atomic( const native_image& m, int type, int stride, int func, W a0, W a1, u32 value, u32 compare )\n"
+         "{\n"
+         "    int size = m.width*m.height*m.components, p = uav_address(m,type,stride,a0,a1);\n"
+         "    if( !inside(p,1,size) ) return 0u;\n"
+         "    u32* d = m.data+p;\n"
+         "    u32 old = *d;\n"
+         "    for(;;) {\n"
+         "        u32 prev = __sync_val_compare_and_swap(d,old,atomic_value(func,old,value,compare));\n"
+         "        if( prev==old ) return old;\n"
+         "        old = prev;\n"
+         "    }\n"
+         "}\n"
+         "\n"
+         "inline int lds_address( int stride, W a0, W a1 ) { return stride==0 ? (int)(a0.u>>2) : (int)((a0.u*stride+a1.u)>>2); }\n"
+         "inline u32 lds_read( const u32* d, int size, int p ) { return inside(p,1,size) ? d[p] : 0u; }\n"
+         "inline void lds_write( u32* d, int size, int p, u32 v ) { if( inside(p,1,size) ) d[p] = v; }\n"
+         "inline u32 lds_atomic( u32* d, int size, int p, int func, u32 value, u32 compare )\n"
+         "{\n"
+         "    if( !inside(p,1,size) ) return 0u;\n"
+         "    u32 old = d[p];\n"
+         "    d[p] = atomic_value(func,old,value,compare);\n"
+         "    return old;\n"
+         "}\n"
+         "\n"
+         "} // namespace\n"
+         "\n";
+
+    return s.str();
+}
+
+//
+// writes decoded program as C++ function running range of work-groups ( pixel tiles for pixel shader )
+// every IL register is a local variable of 4 components, flow control is structured C++,
+// functions are expanded at call sites ( IL functions share registers of caller and are not recursive )
+// work-items of group run one after another, so fence used as barrier of LDS kernel cannot be translated
+//
+
+class host_translator
+{
+protected:
+    const host_program&         program;
+    std::ostream&               out;
+    std::ostream*               sink;       // body is written before declarations of used registers
+    std::vector<std::string>    name;       // C++ expression of register slot
+    mutable std::vector<bool>   used;
+    std::vector<int>            lds_words;
+    int                         indent;
+    int                         label;
+    int                         local[3];
+
+    void error( const std::string& msg ) const
+    {
+        host_error(msg,"");
+    }
+
+    void line( const std::string& text )
+    {
+        for(int i=0;i<indent;i++) *sink << "    ";
+        *sink << text << "\n";
+    }
+
+    static std::string number( int v )
+    {
+        std::ostringstream s;
+        s << v;
+        return s.str();
+    }
+
+    //
+    // operands
+    //
+
+    std::string slot_name( int slot ) const
+    {
+        if( slot<0 || slot>=(int)name.size() ) error("invalid register");
+        used[slot] = true;
+        return name[slot];
+    }
+
+    std::string array_name( int slot ) const
+    {
+        std::string n = slot_name(slot);
+        return n.substr(0,n.find('['));
+    }
+
+    std::string index( const host_operand& op ) const
+    {
+        if( op.index_slot<0 ) return number(op.index_offset);
+        return "(" + number(op.index_offset) + "+" + slot_name(op.index_slot) + ".c[" + number(op.index_component) + "].i)";
+    }
+
+    std::string image_name( const char* kind, int id, int limit ) const
+    {
+        if( id<0 || id>=limit ) error(std::string("resource id out of range for ") + kind);
+        return std::string("a.") + kind + "[" + number(id) + "]";
+    }
+
+    // component c of source operand k as W expression
+    std::string word( const host_instruction& inst, int k, int c ) const
+    {
+        const host_operand& op = inst.operand[k];
+        int                 w = op.swizzle[c];
+        std::string         r;
+
+        if( w==SWIZZLE_ZERO ) r = "wu(0u)";
+        else if( w==SWIZZLE_ONE ) r = "wu(0x3F800000u)";
+        else {
+            switch( op.kind ) {
+            case OPERAND_REGISTER:
+                r = slot_name(op.slot) + ".c[" + number(w) + "]";
+                break;
+            case OPERAND_INDEXED:
+                r = "rdx(" + array_name(op.slot) + "," + number(op.size) + "," + index(op) + "," + number(w) + ")";
+                break;
+            case OPERAND_GLOBAL:
+                r = "rdm(a.global," + index(op) + "," + number(w) + ")";
+                break;
+            case OPERAND_CONSTANT:
+                r = "rdm(" + image_name("constant",op.size,NATIVE_CONSTANTS) + "," + index(op) + "," + number(w) + ")";
+                break;
+            default:
+                error("invalid source operand");
+            }
+        }
+
+        if( op.abs ) r = "wabs(" + r + ")";
+        if( (op.neg>>c)&1 ) r = "wneg(" + r + ")";
+        return r;
+    }
+
+    // t[c] written to destination under write mask
+    std::string store( const host_instruction& inst ) const
+    {
+        const host_operand& op = inst.operand[0];
+        std::string         r;
+
+        for(int c=0;c<4;c++) {
+            std::string t = "t[" + number(c) + "]";
+
+            if( !(op.mask&(1<<c)) ) continue;
+            if( inst.saturate ) r += t + " = wsat(" + t + "); ";
+
+            switch( op.kind ) {
+            case OPERAND_REGISTER:
+                r += slot_name(op.slot) + ".c[" + number(c) + "] = " + t + "; ";
+                break;
+            case OPERAND_INDEXED:
+                r += "wrx(" + array_name(op.slot) + "," + number(op.size) + "," + index(op) + "," + number(c) + "," + t + "); ";
+                break;
+            case OPERAND_GLOBAL:
+                r += "wrm(a.global," + index(op) + "," + number(c) + "," + t + "); ";
+                break;
+            default:
+                error("invalid destination");
+            }
+        }
+
+        return r;
+    }
+
+    // t[c] = f(sources) for components in write mask
+    std::string alu( const host_instruction& inst, const char* f, int n ) const
+    {
+        std::string r;
+
+        if( inst.count<n+1 ) error("missing operand");
+        for(int c=0;c<4;c++) {
+            if( !(inst.operand[0].mask&(1<<c)) ) continue;
+
+            r += "t[" + number(c) + "] = " + f + "(";
+            for(int k=1;k<=n;k++) r += (k>1 ? "," : "") + word(inst,k,c);
+            r += "); ";
+        }
+
+        return r;
+    }
+
+    std::string dbl( const host_instruction& inst, int k ) const
+    {
+        return "md(" + word(inst,k,0) + "," + word(inst,k,1) + ")";
+    }
+
+    std::string relop( const host_instruction& inst ) const
+    {
+        static const char* op[] = { "==", "!=", "<", "<=", ">", ">=" };
+        return word(inst,0,0) + ".f" + op[inst.func] + word(inst,1,0) + ".f";
+    }
+
+    std::string lds_name( int id ) const
+    {
+        return "lds" + number(id);
+    }
+
+    std::string lds_size( int id ) const
+    {
+        return number(lds_words[std::distance(program.lds.begin(),program.lds.find(id))]);
+    }
+
+    //
+    // instructions other than flow control
+    //
+
+    std::string code( const host_instruction& inst ) const
+    {
+        static const struct { int opcode; const char* f; int n; } table[] = {
+            { OP_MOV, "op_mov", 1 }, { OP_ADD, "op_add", 2 }, { OP_SUB, "op_sub", 2 }, { OP_MUL, "op_mul", 2 },
+            { OP_MAD, "op_mad", 3 }, { OP_FMA, "op_fma", 3 }, { OP_DIV, "op_div", 2 }, { OP_MOD, "op_mod", 2 },
+            { OP_MIN, "op_min", 2 }, { OP_MAX, "op_max", 2 }, { OP_ABS, "op_abs", 1 }, { OP_FRC, "op_frc", 1 },
+            { OP_FLR, "op_flr", 1 }, { OP_RND, "op_rnd", 1 }, { OP_SQRT, "op_sqrt", 1 }, { OP_RSQ, "op_rsq", 1 },
+            { OP_RCP, "op_rcp", 1 }, { OP_EXN, "op_exn", 1 }, { OP_LN, "op_ln", 1 }, { OP_EXP, "op_exp", 1 },
+            { OP_LOG, "op_log", 1 }, { OP_SIN, "op_sin", 1 }, { OP_COS, "op_cos", 1 }, { OP_EQ, "op_eq", 2 },
+            { OP_NE, "op_ne", 2 }, { OP_LT, "op_lt", 2 }, { OP_GE, "op_ge", 2 }, { OP_CMOV_LOGICAL, "op_cmov", 3 },
+            { OP_IADD, "op_iadd", 2 }, { OP_INEGATE, "op_inegate", 1 }, { OP_IMUL, "op_imul", 2 }, { OP_UMUL, "op_imul", 2 },
+            { OP_IMUL_HIGH, "op_imul_high", 2 }, { OP_UMUL_HIGH, "op_umul_high", 2 }, { OP_IMAD, "op_imad", 3 },
+            { OP_UMAD, "op_imad", 3 }, { OP_UDIV, "op_udiv", 2 }, { OP_UMOD, "op_umod", 2 }, { OP_IAND, "op_iand", 2 },
+            { OP_IOR, "op_ior", 2 }, { OP_IXOR, "op_ixor", 2 }, { OP_INOT, "op_inot", 1 }, { OP_ISHL, "op_ishl", 2 },
+            { OP_ISHR, "op_ishr", 2 }, { OP_USHR, "op_ushr", 2 }, { OP_IEQ, "op_ieq", 2 }, { OP_INE, "op_ine", 2 },
+            { OP_ILT, "op_ilt", 2 }, { OP_IGE, "op_ige", 2 }, { OP_ULT, "op_ult", 2 }, { OP_UGE, "op_uge", 2 },
+            { OP_IMIN, "op_imin", 2 }, { OP_IMAX, "op_imax", 2 }, { OP_UMIN, "op_umin", 2 }, { OP_UMAX, "op_umax", 2 },
+            { OP_IBIT_EXTRACT, "op_ibit_extract", 3 }, { OP_UBIT_EXTRACT, "op_ubit_extract", 3 }, { OP_BFI, "op_bfi", 3 },
+            { OP_BITALIGN, "op_bitalign", 3 }, { OP_BYTEALIGN, "op_bytealign", 3 },
+            { OP_ITOF, "op_itof", 1 }, { OP_UTOF, "op_utof", 1 }, { OP_FTOI, "op_ftoi", 1 }, { OP_FTOU, "op_ftou", 1 },
+            { OP_DADD, "op_dadd", -2 }, { OP_DMUL, "op_dmul", -2 }, { OP_DDIV, "op_ddiv", -2 }, { OP_DMIN, "op_dmin", -2 },
+            { OP_DMAX, "op_dmax", -2 }, { OP_DFRAC, "op_dfrac", -1 }, { OP_DSQRT, "op_dsqrt", -1 }, { OP_DRSQ, "op_drsq", -1 },
+            { OP_DRCP, "op_drcp", -1 }, { OP_DEQ, "op_deq", -3 }, { OP_DNE, "op_dne", -3 }, { OP_DLT, "op_dlt", -3 },
+            { OP_DGE, "op_dge", -3 },
+            { -1, NULL, 0 }
+        };
+
+        std::string r;
+        int         k;
+
+        for(k=0;table[k].f && table[k].opcode!=inst.opcode;k++);
+
+        if( table[k].f && table[k].n>0 ) return alu(inst,table[k].f,table[k].n) + store(inst);
+        if( table[k].f ) {
+            std::string f = table[k].f;
+
+            // double in ( x, y ) of sources, -1 unary, -2 binary, -3 compare
+            switch( table[k].n ) {
+            case -1: return "sd(" + f + "(" + dbl(inst,1) + "),t); " + store(inst);
+            case -2: return "sd(" + f + "(" + dbl(inst,1) + "," + dbl(inst,2) + "),t); " + store(inst);
+            case -3: return "rep(bm(" + f + "(" + dbl(inst,1) + "," + dbl(inst,2) + ")),t); " + store(inst);
+            }
+        }
+
+        const host_operand& d = inst.operand[0];
+
+        switch( inst.opcode ) {
+        case OP_DP2:
+        case OP_DP3:
+        case OP_DP4:
+            r = "t[0].f = 0.0f";
+            for(k=0;k<inst.opcode-OP_DP2+2;k++) r += "+" + word(inst,1,k) + ".f*" + word(inst,2,k) + ".f";
+            return r + "; t[1] = t[2] = t[3] = t[0]; " + store(inst);
+        case OP_F2D:
+            return "sd((double)" + word(inst,1,0) + ".f,t); " + store(inst);
+        case OP_D2F:
+            return "rep(wf((float)" + dbl(inst,1) + ").u,t); " + store(inst);
+        case OP_DMAD:
+            return "sd(" + dbl(inst,1) + "*" + dbl(inst,2) + "+" + dbl(inst,3) + ",t); " + store(inst);
+        case OP_DFREXP:
+            return "int e; sd(std::frexp(" + dbl(inst,1) + ",&e),t); t[0].i = t[1].i = e; " + store(inst);
+        case OP_DLDEXP:
+            return "sd(std::ldexp(" + dbl(inst,1) + "," + word(inst,2,0) + ".i),t); " + store(inst);
+
+        case OP_SAMPLE:
+        case OP_LOAD: {
+            const host_resource& res = program.resource.find(inst.resource)->second;
+            std::string          img = image_name("input",inst.resource,NATIVE_INPUTS);
+
+            if( inst.opcode==OP_LOAD ) r = "load(" + img + "," + number(res.dimension) + ",";
+            else r = "sample(" + img + "," + number(res.dimension) + "," + (res.normalized ? "true" : "false") + "," + number(inst.offset[0]) + "," + number(inst.offset[1]) + ",";
+            return r + word(inst,1,0) + "," + word(inst,1,1) + ",t); " + store(inst);
+        }
+
+        case OP_UAV_LOAD:
+        case OP_UAV_RAW_LOAD:
+        case OP_UAV_STRUCT_LOAD:
+        case OP_UAV_STORE:
+        case OP_UAV_RAW_STORE:
+        case OP_UAV_STRUCT_STORE:
+        case OP_UAV_ATOMIC: {
+            const host_uav& u = program.uav.find(inst.resource)->second;
+            std::string     m = image_name("uav",inst.resource,NATIVE_UAVS) + "," + number(u.type) + "," + number(u.stride) + ",";
+            int             a = inst.opcode==OP_UAV_STORE ? 0 : 1;
+
+            // UAV compare and exchange takes ( value, compare )
+            if( inst.opcode==OP_UAV_ATOMIC ) {
+                a = inst.returns ? 1 : 0;
+                r = "uav_atomic(" + m + number(inst.func) + "," + word(inst,a,0) + "," + word(inst,a,1) + "," + word(inst,a+1,0) + ".u,";
+                r += inst.func==ATOMIC_CMP ? word(inst,a+2,0) + ".u)" : std::string("0u)");
+                if( !inst.returns ) return r + "; ";
+                return "rep(" + r + ",t); " + store(inst);
+            }
+
+            if( inst.opcode==OP_UAV_LOAD || inst.opcode==OP_UAV_RAW_LOAD || inst.opcode==OP_UAV_STRUCT_LOAD ) {
+                return "uav_load(" + m + word(inst,1,0) + "," + word(inst,1,1) + ",t); " + store(inst);
+            }
+
+            for(k=0;k<4;k++) r += "t[" + number(k) + "] = " + word(inst,a+1,k) + "; ";
+            return r + "uav_store(" + m + word(inst,a,0) + "," + word(inst,a,1) + ",t," + number(a ? d.mask : 0xF) + "); ";
+        }
+
+        case OP_LDS_LOAD:
+            return "rep(lds_read(" + lds_name(inst.resource) + "," + lds_size(inst.resource) + ",lds_address(" + number(program.lds.find(inst.resource)->second.stride) + "," + word(inst,1,0) + "," + word(inst,1,1) + ")),t); " + store(inst);
+        case OP_LDS_STORE:
+            return "lds_write(" + lds_name(inst.resource) + "," + lds_size(inst.resource) + ",lds_address(" + number(program.lds.find(inst.resource)->second.stride) + "," + word(inst,0,0) + "," + word(inst,0,1) + ")," + word(inst,1,0) + ".u); ";
+        case OP_LDS_LOAD_VEC:
+        case OP_LDS_STORE_VEC:
+            r = "int p = lds_address(" + number(program.lds.find(inst.resource)->second.stride) + "," + word(inst,1,0) + "," + word(inst,2,0) + "); ";
+            for(k=0;k<4;k++) {
+                if( inst.opcode==OP_LDS_LOAD_VEC ) r += "t[" + number(k) + "].u = lds_read(" + lds_name(inst.resource) + "," + lds_size(inst.resource) + ",p+" + number(k) + "); ";
+                else if( d.mask&(1<<k) ) r += "lds_write(" + lds_name(inst.resource) + "," + lds_size(inst.resource) + ",p+" + number(k) + "," + word(inst,3,k) + ".u); ";
+            }
+            return inst.opcode==OP_LDS_LOAD_VEC ? r + store(inst) : r;
+        case OP_LDS_ATOMIC: {
+            // LDS compare and exchange takes ( compare, value )
+            int a = inst.returns ? 1 : 0;
+
+            r = "lds_atomic(" + lds_name(inst.resource) + "," + lds_size(inst.resource) + ",lds_address(" + number(program.lds.find(inst.resource)->second.stride) + "," + word(inst,a,0) + "," + word(inst,a,1) + ")," + number(inst.func) + ",";
+            if( inst.func==ATOMIC_CMP ) r += word(inst,a+2,0) + ".u," + word(inst,a+1,0) + ".u)";
+            else r += word(inst,a+1,0) + ".u,0u)";
+            if( !inst.returns ) return r + "; ";
+            return "rep(" + r + ",t); " + store(inst);
+        }
+
+        case OP_FENCE:
+            return "";
+        }
+
+        error("instruction cannot be translated");
+        return r;
+    }
+
+    //
+    // structured flow control, returns index of instruction which ended the block
+    //
+
+    bool has_return( int pc ) const
+    {
+        for(;pc<(int)program.code.size();pc++) {
+            int op = program.code[pc].opcode;
+
+            if( op==OP_RET ) return true;
+            if( op==OP_ENDFUNC || op==OP_ENDMAIN || op==OP_END || op==OP_FUNC ) return false;
+        }
+        return false;
+    }
+
+    void block( int pc, const std::string& exit, int calls )
+    {
+        for(;pc<(int)program.code.size();pc++) {
+            const host_instruction& inst = program.code[pc];
+
+            switch( inst.opcode ) {
+            case OP_IF_LOGICALNZ:
+                line("if( " + word(inst,0,0) + ".u!=0 ) {");
+                indent++;
+                break;
+            case OP_IF_LOGICALZ:
+                line("if( " + word(inst,0,0) + ".u==0 ) {");
+                indent++;
+                break;
+            case OP_IFC:
+                line("if( " + relop(inst) + " ) {");
+                indent++;
+                break;
+            case OP_ELSE:
+                indent--;
+                line("} else {");
+                indent++;
+                break;
+            case OP_ENDIF:
+            case OP_ENDLOOP:
+                indent--;
+                line("}");
+                break;
+            case OP_WHILELOOP:
+                line("for(;;) {");
+                indent++;
+                break;
+            case OP_BREAK:              line("break;"); break;
+            case OP_CONTINUE:           line("continue;"); break;
+            case OP_BREAKC:             line("if( " + relop(inst) + " ) break;"); break;
+            case OP_CONTINUEC:          line("if( " + relop(inst) + " ) continue;"); break;
+            case OP_BREAK_LOGICALZ:     line("if( " + word(inst,0,0) + ".u==0 ) break;"); break;
+            case OP_BREAK_LOGICALNZ:    line("if( " + word(inst,0,0) + ".u!=0 ) break;"); break;
+            case OP_CONTINUE_LOGICALZ:  line("if( " + word(inst,0,0) + ".u==0 ) continue;"); break;
+            case OP_CONTINUE_LOGICALNZ: line("if( " + word(inst,0,0) + ".u!=0 ) continue;"); break;
+            case OP_RET:
+                line("goto " + exit + ";");
+                break;
+            case OP_CALL: {
+                std::string ret = "ret" + number(label++);
+                bool        used = has_return(inst.target);
+
+                if( calls>=32 ) error("recursive function call");
+                line("{");
+                indent++;
+                block(inst.target,ret,calls+1);
+                indent--;
+                line("}");
+                if( used ) line(ret + ": ;");
+                break;
+            }
+            case OP_FUNC:
+            case OP_ENDFUNC:
+            case OP_ENDMAIN:
+            case OP_END:
+                return;
+            default: {
+                std::string c = code(inst);
+
+                if( c.find("t[")!=std::string::npos || c.find(",t)")!=std::string::npos ) line("{ W t[4]; " + c + "}");
+                else if( !c.empty() ) line("{ " + c + "}");
+            }
+            }
+        }
+    }
+
+    //
+    // declarations
+    //
+
+    void registers()
+    {
+        unsigned    k;
+        int         s;
+
+        name.resize(program.slot_count);
+        used.assign(program.slot_count,false);
+        for(s=0;s<program.slot_count;s++) name[s] = "s" + number(s);
+        for(k=0;k<program.indexed.size();k++) {
+            for(s=0;s<program.indexed[k].second;s++) name[program.indexed[k].first+s] = "x" + number(program.indexed[k].first) + "[" + number(s) + "]";
+        }
+    }
+
+    std::string literal( const host_slot_init& l ) const
+    {
+        return str( boost::format("const V %s = {{ {0x%08Xu}, {0x%08Xu}, {0x%08Xu}, {0x%08Xu} }};") % slot_name(l.slot) % l.value[0] % l.value[1] % l.value[2] % l.value[3] );
+    }
+
+    void declare_registers()
+    {
+        std::vector<bool>   done(program.slot_count,false);
+        unsigned            k;
+        int                 s;
+
+        for(k=0;k<program.literal.size();k++) {
+            if( used[program.literal[k].slot] ) line(literal(program.literal[k]));
+            done[program.literal[k].slot] = true;
+        }
+        for(k=0;k<program.indexed.size();k++) {
+            bool any = false;
+
+            for(s=0;s<program.indexed[k].second;s++) {
+                any |= used[program.indexed[k].first+s];
+                done[program.indexed[k].first+s] = true;
+            }
+            if( !any ) continue;
+            line("V x" + number(program.indexed[k].first) + "[" + number(program.indexed[k].second) + "];");
+            line("std::memset(x" + number(program.indexed[k].first) + ",0,sizeof(x" + number(program.indexed[k].first) + "));");
+        }
+        for(s=0;s<program.slot_count;s++) {
+            if( !done[s] && used[s] ) line("V " + slot_name(s) + " = zero;");
+        }
+
+        for(k=0;k<program.constant.size();k++) {
+            const host_slot_init& c = program.constant[k];
+            std::string           img = image_name("constant",c.source,NATIVE_CONSTANTS);
+
+            if( !used[c.slot] ) continue;
+            for(int i=0;i<4;i++) line(slot_name(c.slot) + ".c[" + number(i) + "] = rdm(" + img + "," + number(c.element) + "," + number(i) + ");");
+        }
+
+        for(k=0;k<program.special.size();k++) {
+            static const char* value[][4] = {
+                { "abs[0]", "abs[1]", "abs[2]", "0" },
+                { "flat", "flat", "flat", "flat" },
+                { "tid[0]", "tid[1]", "tid[2]", "0" },
+                { "l", "l", "l", "l" },
+                { "gid[0]", "gid[1]", "gid[2]", "0" },
+                { "group", "group", "group", "group" }
+            };
+            const host_slot_init& p = program.special[k];
+            std::string           r;
+
+            if( !used[p.slot] ) continue;
+            r = slot_name(p.slot);
+            if( p.source==SPECIAL_WIN_COORD ) {
+                line(r + ".c[0].f = (float)(gid[0]*" + number(local[0]) + "+l)+0.5f;");
+                line(r + ".c[1].f = (float)gid[1]+0.5f;");
+                line(r + ".c[2].u = 0u;");
+                line(r + ".c[3].f = 1.0f;");
+                continue;
+            }
+            for(int i=0;i<4;i++) line(r + ".c[" + number(i) + "].i = " + value[p.source][i] + ";");
+        }
+    }
+
+    void pixel_outputs()
+    {
+        for(unsigned k=0;k<program.output.size();k++) {
+            std::string img = image_name("output",program.output[k].second,NATIVE_OUTPUTS);
+            std::string reg = slot_name(program.output[k].first);
+
+            line("if( gid[1]<" + img + ".height && x<" + img + ".width ) {");
+            line("    for(int c=0;c<" + img + ".components;c++) " + img + ".data[(gid[1]*" + img + ".width+x)*" + img + ".components+c] = " + reg + ".c[c].u;");
+            line("}");
+        }
+    }
+
+public:
+    host_translator( const host_program& p, std::ostream& o ) : program(p), out(o), sink(&o), indent(0), label(0)
+    {
+        // pixel shader runs tiles of 64x1 pixels like host_executor
+        if( program.type==HOST_PIXEL_SHADER ) {
+            local[0] = 64;
+            local[1] = local[2] = 1;
+        }
+        else {
+            for(int c=0;c<3;c++) local[c] = program.group[c];
+        }
+    }
+
+    void translate()
+    {
+        std::map<int,host_lds>::const_iterator  i;
+        bool                                    fence = false;
+        unsigned                                k;
+
+        for(k=0;k<program.code.size();k++) fence |= program.code[k].opcode==OP_FENCE;
+        if( fence && !program.lds.empty() ) error("LDS kernel with fence needs lock-step execution of work-group, use host::kernel");
+
+        registers();
+        for(i=program.lds.begin();i!=program.lds.end();i++) lds_words.push_back(std::max((i->second.size+3)/4,1));
+
+        out << "// generated by CAL++ from IL kernel\n\n";
+        out << native_prelude();
+
+        out << "extern \"C\" int cal_il_native_abi()\n{\n    return " << NATIVE_ABI_VERSION << ";\n}\n\n";
+        out << "extern \"C\" void cal_il_native_run( const native_args* args, int first, int count )\n{\n";
+        indent = 1;
+
+        line("const native_args& a = *args;");
+        line("const V zero = {{ {0u}, {0u}, {0u}, {0u} }};");
+        for(k=0,i=program.lds.begin();i!=program.lds.end();i++,k++) line("u32 " + lds_name(i->first) + "[" + number(lds_words[k]) + "];");
+        line("");
+        line("for(int g=first;g<first+count;g++) {");
+        indent++;
+        line("const int gid[3] = { g%a.count[0], (g/a.count[0])%a.count[1], g/(a.count[0]*a.count[1]) };");
+        line("const int group = gid[0] + gid[1]*a.count[0] + gid[2]*a.count[0]*a.count[1];");
+        line("(void)group;");
+        for(i=program.lds.begin();i!=program.lds.end();i++) line("std::memset(" + lds_name(i->first) + ",0,sizeof(" + lds_name(i->first) + "));");
+        line("");
+        line(str( boost::format("for(int l=0;l<%i;l++) {") % (local[0]*local[1]*local[2]) ));
+        indent++;
+
+        line(str( boost::format("const int tid[3] = { l%%%i, (l/%i)%%%i, l/%i };") % local[0] % local[0] % local[1] % (local[0]*local[1]) ));
+        line(str( boost::format("const int abs[3] = { gid[0]*%i+tid[0], gid[1]*%i+tid[1], gid[2]*%i+tid[2] };") % local[0] % local[1] % local[2] ));
+        line(str( boost::format("const int flat = abs[0] + abs[1]*a.count[0]*%i + abs[2]*a.count[0]*%i*a.count[1]*%i;") % local[0] % local[0] % local[1] ));
+        line("(void)tid; (void)abs; (void)flat;");
+        if( program.type==HOST_PIXEL_SHADER ) {
+            line("const int x = gid[0]*" + number(local[0]) + "+l;");
+            line("if( x>=a.domain[0] ) break;");
+        }
+        line("");
+
+        std::ostringstream  body;
+        int                 depth = indent;
+
+        sink = &body;
+        block(0,"done",0);
+        if( has_return(0) ) line("done: ;");
+        if( program.type==HOST_PIXEL_SHADER ) pixel_outputs();
+
+        sink = &out;
+        declare_registers();
+        line("");
+        out << body.str();
+        indent = depth;
+
+        indent--;
+        line("}");
+        indent--;
+        line("}");
+        out << "}\n";
+    }
+};
+
+} // detail
+
+//
+// C++ source of IL kernel ( complete header and code ), see host_translator
+// source defines extern "C" cal_il_native_abi() and cal_il_native_run( args, first group, number of groups )
+//
+
+inline void translate( const detail::host_program& program, std::ostream& out )
+{
+    detail::host_translator(program,out).translate();
+}
+
+inline std::string translate( const std::string& source )
+{
+    detail::host_program    program;
+    std::ostringstream      out;
+
+    compile(source,program);
+    translate(program,out);
+    return out.str();
+}
+
+} // host
+} // il
+} // cal
+
+#endif
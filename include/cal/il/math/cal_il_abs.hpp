@@ -47,7 +47,7 @@ struct cal_unary_abs<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("abs %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
+        return (detail::il_format("abs %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
     }
 };
 
@@ -59,7 +59,7 @@ struct cal_unary_abs<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("abs  %1%,%2%\n") % mask_output(make_swizzle(r,1,2,0,0)) % make_swizzle(s0,1,2,1,2)).str();
+        return (detail::il_format("abs  %1%,%2%\n") % mask_output(make_swizzle(r,1,2,0,0)) % make_swizzle(s0,1,2,1,2)).str();
     }
 };
 
@@ -71,7 +71,7 @@ struct cal_unary_abs<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("abs %1%,%2%\n") % r % s0).str();
+        return (detail::il_format("abs %1%,%2%\n") % r % s0).str();
     }
 };
 
@@ -83,7 +83,7 @@ struct cal_unary_abs<double_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %1%,%2%\n"
+        return (detail::il_format("mov %1%,%2%\n"
                               "mov %3%,%4%_abs\n") % r % s0 % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,2,2,2)).str();
     }    
 };
@@ -96,7 +96,7 @@ struct cal_unary_abs<double2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov %1%,%2%\n"
+        return (detail::il_format("mov %1%,%2%\n"
                               "mov %3%,%4%_abs\n") % r % s0 % mask_output(make_swizzle(r,2,4,0,0)) % make_swizzle(s0,2,2,4,4)).str();
     }
 };
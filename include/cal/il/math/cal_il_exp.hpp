@@ -53,7 +53,7 @@ struct cal_unary_exp<float_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("exn %s,%s\n") % r % s0).str();
+        return (detail::il_format("exn %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -65,7 +65,7 @@ struct cal_unary_exp<float2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov r%3%.xy,%2%\n"
+        return (detail::il_format("mov r%3%.xy,%2%\n"
                               "exn r%4%.x,r%3%.x\n"
                               "exn r%4%.y,r%3%.y\n"
                               "mov %1%,r%4%.xy\n") % r % s0 % t0 % (t0+1)).str();
@@ -80,11 +80,11 @@ struct cal_unary_exp<float4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov r%3%,%2%\n"
-                              "exn r%4%.x,%3%.x\n"
-                              "exn r%4%.y,%3%.y\n"
-                              "exn r%4%.z,%3%.z\n"
-                              "exn r%4%.w,%3%.w\n"
+        return (detail::il_format("mov r%3%,%2%\n"
+                              "exn r%4%.x,r%3%.x\n"
+                              "exn r%4%.y,r%3%.y\n"
+                              "exn r%4%.z,r%3%.z\n"
+                              "exn r%4%.w,r%3%.w\n"
                               "mov %1%,r%4%\n") % r % s0 % t0 % (t0+1)).str();
     }
 };
@@ -48,7 +48,7 @@ struct cal_unary_floor<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("flr %s,%s\n") % r % s0).str();
+        return (detail::il_format("flr %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -60,7 +60,7 @@ struct cal_unary_floor<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("flr %s,%s\n") % r % s0).str();
+        return (detail::il_format("flr %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -72,7 +72,7 @@ struct cal_unary_floor<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("flr %s,%s\n") % r % s0).str();
+        return (detail::il_format("flr %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -48,7 +48,7 @@ struct cal_unary_frac<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("frc %s,%s\n") % r % s0).str();
+        return (detail::il_format("frc %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -60,7 +60,7 @@ struct cal_unary_frac<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("frc %s,%s\n") % r % s0).str();
+        return (detail::il_format("frc %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -72,7 +72,7 @@ struct cal_unary_frac<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("frc %s,%s\n") % r % s0).str();
+        return (detail::il_format("frc %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -84,7 +84,7 @@ struct cal_unary_frac<double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("dfrac %s,%s\n") % r % s0).str();
+        return (detail::il_format("dfrac %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -96,7 +96,7 @@ struct cal_unary_frac<double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("dfrac %1%,%3%\n"
+        return (detail::il_format("dfrac %1%,%3%\n"
                               "dfrac %2%,%4%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                  % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)).str();
     }    
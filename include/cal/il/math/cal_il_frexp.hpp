@@ -48,7 +48,7 @@ struct cal_unary_frexp<double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("dfrexp %s,%s\n") % r % s0).str();
+        return (detail::il_format("dfrexp %s,%s\n") % r % s0).str();
     }
 };
 
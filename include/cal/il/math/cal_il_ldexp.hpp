@@ -48,7 +48,7 @@ struct cal_binary_ldexp<double_type,int_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dldexp %1%,%2%,%3%\n") % r % s0 % s1).str();
+        return (detail::il_format("dldexp %1%,%2%,%3%\n") % r % s0 % s1).str();
     }    
 };
 
@@ -60,7 +60,7 @@ struct cal_binary_ldexp<double2_type,int2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dldexp %1%,%3%,%5%\n"
+        return (detail::il_format("dldexp %1%,%3%,%5%\n"
                               "dldexp %2%,%4%,%6%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                       % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                       % make_swizzle(s1,1,0,0,0) % make_swizzle(s1,2,0,0,0)).str();
@@ -52,7 +52,7 @@ struct cal_unary_log<float_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("ln %s,%s\n") % r % s0).str();
+        return (detail::il_format("ln %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -64,9 +64,9 @@ struct cal_unary_log<float2_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov r%3%.xy,%2%\n"
-                              "ln  r%4%.x,r%3%.x\n"
-                              "ln  r%4%.y,r%3%.y\n"
+        return (detail::il_format("mov r%3%.xy,%2%\n"
+                              "ln r%4%.x,r%3%.x\n"
+                              "ln r%4%.y,r%3%.y\n"
                               "mov %1%,r%4%.xy\n") % r % s0 % t0 % (t0+1)).str();
     }    
 };
@@ -79,11 +79,11 @@ struct cal_unary_log<float4_type>
     
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("mov r%3%,%2%\n"
-                              "ln  r%4%.x,%3%.x\n"
-                              "ln  r%4%.y,%3%.y\n"
-                              "ln  r%4%.z,%3%.z\n"
-                              "ln  r%4%.w,%3%.w\n"
+        return (detail::il_format("mov r%3%,%2%\n"
+                              "ln r%4%.x,r%3%.x\n"
+                              "ln r%4%.y,r%3%.y\n"
+                              "ln r%4%.z,r%3%.z\n"
+                              "ln r%4%.w,r%3%.w\n"
                               "mov %1%,r%4%\n") % r % s0 % t0 % (t0+1)).str();
     }    
 };
@@ -48,7 +48,7 @@ struct cal_binary_min<float_type,float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("min %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("min %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -60,7 +60,7 @@ struct cal_binary_min<float2_type,float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("min %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("min %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -72,7 +72,7 @@ struct cal_binary_min<float4_type,float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("min %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("min %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -84,7 +84,7 @@ struct cal_binary_min<double_type,double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dmin %s,%s,%s\n") % r % s0 % s1).str();
+        return (detail::il_format("dmin %s,%s,%s\n") % r % s0 % s1).str();
     }
 };
 
@@ -96,7 +96,7 @@ struct cal_binary_min<double2_type,double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, const std::string& s1, int t0 )
     {
-        return (boost::format("dmin %1%,%3%,%5%\n"
+        return (detail::il_format("dmin %1%,%3%,%5%\n"
                               "dmin %2%,%4%,%6%\n") % make_swizzle(r ,1,2,0,0) % make_swizzle(r ,3,4,0,0)
                                                     % make_swizzle(s0,1,2,0,0) % make_swizzle(s0,3,4,0,0)
                                                     % make_swizzle(s1,1,2,0,0) % make_swizzle(s1,3,4,0,0)).str();
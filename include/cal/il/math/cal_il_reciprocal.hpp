@@ -50,7 +50,7 @@ struct cal_unary_rcp<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rcp %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
+        return (detail::il_format("rcp %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
     }
 };
 
@@ -62,7 +62,7 @@ struct cal_unary_rcp<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rcp %1%,%2%\n"
+        return (detail::il_format("rcp %1%,%2%\n"
                               "rcp %3%,%4%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1)
                                                % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,2,2,2) ).str();
     }
@@ -76,7 +76,7 @@ struct cal_unary_rcp<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rcp %1%,%2%\n"
+        return (detail::il_format("rcp %1%,%2%\n"
                               "rcp %3%,%4%\n"
                               "rcp %5%,%6%\n"
                               "rcp %7%,%8%\n" ) % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1)
@@ -94,7 +94,7 @@ struct cal_unary_rcp<double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("drcp %1%,%2%\n") % r % make_swizzle(s0,1,2,1,2) ).str();
+        return (detail::il_format("drcp %1%,%2%\n") % r % make_swizzle(s0,1,2,1,2) ).str();
     }
 };
 
@@ -106,7 +106,7 @@ struct cal_unary_rcp<double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("drcp %1%,%2%\n"
+        return (detail::il_format("drcp %1%,%2%\n"
                               "drcp %3%,%4%\n") % make_swizzle(r,1,2,0,0) % make_swizzle(s0,1,2,1,2)
                                                 % make_swizzle(r,3,4,0,0) % make_swizzle(s0,3,4,3,4) ).str();
     }
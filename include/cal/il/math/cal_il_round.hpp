@@ -50,7 +50,7 @@ struct cal_unary_round<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rnd %s,%s\n") % r % s0).str();
+        return (detail::il_format("rnd %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -62,7 +62,7 @@ struct cal_unary_round<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rnd %s,%s\n") % r % s0).str();
+        return (detail::il_format("rnd %s,%s\n") % r % s0).str();
     }    
 };
 
@@ -74,7 +74,7 @@ struct cal_unary_round<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rnd %s,%s\n") % r % s0).str();
+        return (detail::il_format("rnd %s,%s\n") % r % s0).str();
     }    
 };
 
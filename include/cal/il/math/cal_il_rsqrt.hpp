@@ -50,7 +50,7 @@ struct cal_unary_rsq<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rsq %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
+        return (detail::il_format("rsq %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
     }
 };
 
@@ -62,7 +62,7 @@ struct cal_unary_rsq<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rsq %1%,%2%\n"
+        return (detail::il_format("rsq %1%,%2%\n"
                               "rsq %3%,%4%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1)
                                                % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,2,2,2) ).str();
     }
@@ -76,7 +76,7 @@ struct cal_unary_rsq<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("rsq %1%,%2%\n"
+        return (detail::il_format("rsq %1%,%2%\n"
                               "rsq %3%,%4%\n"
                               "rsq %5%,%6%\n"
                               "rsq %7%,%8%\n" ) % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1)
@@ -94,7 +94,7 @@ struct cal_unary_rsq<double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("drsq %1%,%2%\n") % mask_output(make_swizzle(r,1,2,0,0)) % make_swizzle(s0,1,2,1,2) ).str();
+        return (detail::il_format("drsq %1%,%2%\n") % mask_output(make_swizzle(r,1,2,0,0)) % make_swizzle(s0,1,2,1,2) ).str();
     }
 };
 
@@ -106,7 +106,7 @@ struct cal_unary_rsq<double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("drsq %1%,%2%\n"
+        return (detail::il_format("drsq %1%,%2%\n"
                               "drsq %3%,%4%\n") % mask_output(make_swizzle(r,1,2,0,0)) % make_swizzle(s0,1,2,1,2)
                                                 % mask_output(make_swizzle(r,3,4,0,0)) % make_swizzle(s0,3,4,3,4) ).str();
     }
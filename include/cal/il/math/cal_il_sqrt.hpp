@@ -51,7 +51,7 @@ struct cal_unary_sqrt<float_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("sqrt %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
+        return (detail::il_format("sqrt %1%,%2%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1) ).str();
     }
 };
 
@@ -63,7 +63,7 @@ struct cal_unary_sqrt<float2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("sqrt %1%,%2%\n"
+        return (detail::il_format("sqrt %1%,%2%\n"
                               "sqrt %3%,%4%\n") % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1)
                                                 % mask_output(make_swizzle(r,2,0,0,0)) % make_swizzle(s0,2,2,2,2) ).str();
     }
@@ -77,7 +77,7 @@ struct cal_unary_sqrt<float4_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("sqrt %1%,%2%\n"
+        return (detail::il_format("sqrt %1%,%2%\n"
                               "sqrt %3%,%4%\n"
                               "sqrt %5%,%6%\n"
                               "sqrt %7%,%8%\n" ) % mask_output(make_swizzle(r,1,0,0,0)) % make_swizzle(s0,1,1,1,1)
@@ -95,7 +95,7 @@ struct cal_unary_sqrt<double_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("dsqrt %1%,%2%\n") % make_swizzle(r,1,2,0,0) % make_swizzle(s0,1,2,1,2) ).str();
+        return (detail::il_format("dsqrt %1%,%2%\n") % make_swizzle(r,1,2,0,0) % make_swizzle(s0,1,2,1,2) ).str();
     }
 };
 
@@ -107,7 +107,7 @@ struct cal_unary_sqrt<double2_type>
 
     static std::string emitCode( const std::string& r, const std::string& s0, int t0 )
     {
-        return (boost::format("dsqrt %1%,%2%\n"
+        return (detail::il_format("dsqrt %1%,%2%\n"
                               "dsqrt %3%,%4%\n") % make_swizzle(r,1,2,0,0) % make_swizzle(s0,1,2,1,2)
                                                  % make_swizzle(r,3,4,0,0) % make_swizzle(s0,3,4,3,4) ).str();
     }
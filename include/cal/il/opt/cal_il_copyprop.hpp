@@ -0,0 +1,412 @@
+/*
+ * C++ to IL compiler/generator copy propagation and coalescing
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_COPYPROP_H
+#define __CAL_IL_COPYPROP_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// plain register copy "mov dst,src" without modifiers
+//
+
+inline bool is_copy( const instruction& inst )
+{
+    if( inst.opcode!="mov" || inst.operand.size()!=2 || !inst.text.empty() ) return false;
+
+    const instruction_operand& dst = inst.operand[0];
+    const instruction_operand& src = inst.operand[1];
+
+    if( temp_register(dst.name)<0 || !dst.modifier.empty() ) return false;
+    if( !src.modifier.empty() || src.name.find('[')!=std::string::npos || src.name=="mem" ) return false;
+
+    return true;
+}
+
+//
+// copy which does not change register ( "mov r1.xy,r1.xyzw" )
+//
+
+inline bool is_identity_copy( const instruction& inst )
+{
+    if( !is_copy(inst) || inst.operand[0].name!=inst.operand[1].name ) return false;
+
+    int mask = write_mask(inst.operand[0]);
+    for(int c=0;c<4;c++) {
+        if( (mask&(1<<c)) && swizzle_component(inst.operand[1].swizzle,c)!=c ) return false;
+    }
+
+    return true;
+}
+
+//
+// removes instructions marked in remove vector
+//
+
+inline void compact_code( instruction_list& code, const std::vector<char>& remove )
+{
+    unsigned i,j;
+
+    for(i=0,j=0;i<code.size();i++) {
+        if( remove[i] ) continue;
+        if( i!=j ) code[j] = code[i];
+        j++;
+    }
+    code.resize(j);
+}
+
+class copy_table
+{
+protected:
+    typedef std::pair<int,int>                          component;      // register, component
+    typedef std::pair<std::string,int>                  source;         // operand name, component
+
+    std::map<component,source>                          copy;
+    std::map<std::string,std::set<component> >         user;
+
+public:
+    void clear()
+    {
+        copy.clear();
+        user.clear();
+    }
+
+    const source* find( int r, int c ) const
+    {
+        std::map<component,source>::const_iterator i = copy.find(std::make_pair(r,c));
+        if( i==copy.end() ) return NULL;
+        return &i->second;
+    }
+
+    void remove( int r, int c )
+    {
+        std::map<component,source>::iterator i = copy.find(std::make_pair(r,c));
+        if( i==copy.end() ) return;
+
+        user[i->second.first].erase(i->first);
+        copy.erase(i);
+    }
+
+    // register or named operand component was written
+    void kill( const std::string& name, int c )
+    {
+        std::map<std::string,std::set<component> >::iterator iu = user.find(name);
+        if( iu==user.end() ) return;
+
+        std::set<component>::iterator is = iu->second.begin();
+        while( is!=iu->second.end() ) {
+            std::map<component,source>::iterator ic = copy.find(*is);
+            if( ic!=copy.end() && ic->second.second==c ) {
+                copy.erase(ic);
+                iu->second.erase(is++);
+            } else ++is;
+        }
+    }
+
+    void add( int r, int c, const std::string& name, int s )
+    {
+        copy[std::make_pair(r,c)] = std::make_pair(name,s);
+        user[name].insert(std::make_pair(r,c));
+    }
+};
+
+//
+// rewrites source operand reading copied register to read copy source
+//
+
+inline bool propagate_operand( instruction_operand& op, int mask, bool temp_only, const copy_table& table )
+{
+    std::string name,swizzle;
+    int         r = temp_register(op.name);
+    int         c,s;
+
+    if( r<0 ) return false;
+
+    for(c=0;c<4;c++) {
+        s = swizzle_component(op.swizzle,c);
+
+        if( !(mask&(1<<c)) ) {
+            swizzle += 'x';
+            continue;
+        }
+        if( s<0 ) {
+            swizzle += s==-1 ? '0' : '1';
+            continue;
+        }
+
+        const std::pair<std::string,int>* src = table.find(r,s);
+        if( !src ) return false;
+        if( !name.empty() && name!=src->first ) return false;
+        if( temp_only && temp_register(src->first)<0 ) return false;
+
+        name     = src->first;
+        swizzle += "xyzw"[src->second];
+    }
+
+    if( name.empty() ) return false;
+
+    // keep swizzle short when possible
+    if( swizzle=="xyzw" ) swizzle.clear();
+    else if( op.swizzle.length()==1 && swizzle[0]==swizzle[1] && swizzle[0]==swizzle[2] && swizzle[0]==swizzle[3] ) swizzle.erase(1);
+
+    if( name==op.name && swizzle==op.swizzle ) return false;
+
+    // unused components are filled with x, use first used component instead
+    if( mask!=0xF && swizzle.length()==4 ) {
+        char fill = 'x';
+        for(c=0;c<4;c++) if( mask&(1<<c) ) { fill = swizzle[c]; break; }
+        for(c=0;c<4;c++) if( !(mask&(1<<c)) ) swizzle[c] = fill;
+    }
+
+    op.name    = name;
+    op.swizzle = swizzle;
+    return true;
+}
+
+//
+// rewrites temporary registers used as index ( "g[r5.x+1]" )
+//
+
+inline bool propagate_index( instruction_operand& op, const copy_table& table )
+{
+    std::string::size_type  p,e;
+    bool                    changed=false;
+
+    if( op.name.find('[')==std::string::npos ) return false;
+
+    for(p=op.name.find('[');p<op.name.length();p=e) {
+        for(e=p+1;e<op.name.length() && (std::isalnum(op.name[e]) || op.name[e]=='.');e++);
+
+        int                    r = temp_register(op.name.substr(p+1,e-p-3));
+        std::string::size_type l = e-p-1;
+
+        if( r<0 || l<4 || op.name[e-2]!='.' || !is_swizzle_letter(op.name[e-1]) ) {
+            e = op.name.find('[',p+1);
+            continue;
+        }
+
+        const std::pair<std::string,int>* src = table.find(r,swizzle_component(op.name.substr(e-1,1),0));
+        if( !src || temp_register(src->first)<0 ) {
+            e = op.name.find('[',p+1);
+            continue;
+        }
+
+        std::string idx = src->first + "." + "xyzw"[src->second];
+        op.name.replace(p+1,l,idx);
+        e = op.name.find('[',p+1);
+        changed = true;
+    }
+
+    return changed;
+}
+
+//
+// forward propagation of copies inside basic blocks
+//
+
+inline int propagate_copies( instruction_list& code, const flow_graph& graph )
+{
+    copy_table  table;
+    unsigned    b,k,first;
+    int         c,changed=0;
+
+    for(b=0;b<graph.block.size();b++) {
+        table.clear();
+
+        for(int i=graph.block[b].first;i<=graph.block[b].last;i++) {
+            instruction& inst = code[i];
+            bool         dst  = has_destination(inst);
+
+            if( inst.opcode.empty() || is_declaration(inst) ) continue;
+
+            // sources
+            first = dst ? 1 : 0;
+            if( inst.text.empty() ) {
+                // only mov has components which are known not to be read
+                int  mask = (dst && inst.opcode=="mov") ? write_mask(inst.operand[0]) : 0xF;
+                bool temp_only = !is_pure(inst) && inst.opcode!="mov";
+
+                for(k=first;k<inst.operand.size();k++) {
+                    if( propagate_operand(inst.operand[k],mask,temp_only,table) ) changed++;
+                }
+                for(k=0;k<inst.operand.size();k++) {
+                    if( propagate_index(inst.operand[k],table) ) changed++;
+                }
+            }
+
+            if( !dst ) continue;
+
+            // destination
+            const instruction_operand& d = inst.operand[0];
+            int                        r = temp_register(d.name);
+            int                        mask = write_mask(d);
+
+            for(c=0;c<4;c++) {
+                if( !(mask&(1<<c)) ) continue;
+                table.kill(d.name,c);
+                if( r>=0 ) table.remove(r,c);
+            }
+
+            if( is_copy(inst) && inst.operand[1].name!=d.name ) {
+                for(c=0;c<4;c++) {
+                    int s = swizzle_component(inst.operand[1].swizzle,c);
+                    if( (mask&(1<<c)) && s>=0 ) table.add(r,c,inst.operand[1].name,s);
+                }
+            }
+        }
+    }
+
+    return changed;
+}
+
+//
+// backward walk over blocks with liveness
+// removes copies to dead registers and coalesces "op rA,...; mov rB,rA" into "op rB,..."
+//
+
+inline int remove_copies( instruction_list& code, const flow_graph& graph, const liveness_info& liveness )
+{
+    std::vector<char>   remove(code.size(),0);
+    std::set<int>       touched;
+    unsigned            b,k;
+    int                 c,removed=0;
+
+    for(b=0;b<graph.block.size();b++) {
+        boost::dynamic_bitset<> live = liveness.live_out[b];
+
+        for(int j=graph.block[b].last;j>=graph.block[b].first;j--) {
+            instruction&           inst = code[j];
+            const register_access& a    = liveness.access[j];
+
+            if( is_copy(inst) && (int)a.def.size()==1 ) {
+                int  dst  = a.def[0].first;
+                int  mask = a.def[0].second;
+                bool dead = true;
+
+                for(c=0;c<4;c++) {
+                    if( (mask&(1<<c)) && live.test(4*dst+c) ) dead=false;
+                }
+
+                if( dead || is_identity_copy(inst) ) {
+                    remove[j] = 1;
+                    removed++;
+                    continue;
+                }
+
+                // coalescing
+                int src = temp_register(inst.operand[1].name);
+                int id  = src>=0 ? liveness.map.find(src) : -1;
+                bool ok = id>=0 && id!=dst && !touched.count(id) && !touched.count(dst);
+
+                for(c=0;c<4 && ok;c++) {
+                    if( !(mask&(1<<c)) ) continue;
+                    if( swizzle_component(inst.operand[1].swizzle,c)!=c || live.test(4*id+c) ) ok=false;
+                }
+
+                int def = -1;
+                for(int i=j-1;i>=graph.block[b].first && ok && def<0;i--) {
+                    const register_access& ai = liveness.access[i];
+
+                    for(k=0;k<ai.def.size();k++) {
+                        if( ai.def[k].first==id && (ai.def[k].second&mask) ) {
+                            if( ai.def[k].second==mask && code[i].text.empty() && temp_register(code[i].operand[0].name)==src ) def=i;
+                            else ok=false;
+                        }
+                        if( ai.def[k].first==dst && (ai.def[k].second&mask) && def<0 ) ok=false;
+                    }
+                    if( def>=0 ) break;
+
+                    for(k=0;k<ai.use.size();k++) {
+                        if( (ai.use[k].first==id || ai.use[k].first==dst) && (ai.use[k].second&mask) ) ok=false;
+                    }
+                }
+
+                if( ok && def>=0 ) {
+                    code[def].operand[0].name = inst.operand[0].name;
+                    remove[j] = 1;
+                    removed++;
+                    touched.insert(id);
+                    touched.insert(dst);
+
+                    // value of rB is produced earlier now, rA no longer used
+                    for(c=0;c<4;c++) {
+                        if( mask&(1<<c) ) live.reset(4*dst+c);
+                    }
+                    continue;
+                }
+            }
+
+            for(k=0;k<a.def.size();k++) {
+                for(c=0;c<4;c++) {
+                    if( a.def[k].second&(1<<c) ) live.reset(4*a.def[k].first+c);
+                }
+            }
+            for(k=0;k<a.use.size();k++) {
+                for(c=0;c<4;c++) {
+                    if( a.use[k].second&(1<<c) ) live.set(4*a.use[k].first+c);
+                }
+            }
+        }
+    }
+
+    compact_code(code,remove);
+    return removed;
+}
+
+//
+// copy propagation, returns number of removed instructions
+//
+
+inline int copyprop( instruction_list& code )
+{
+    int removed=0,r;
+
+    do {
+        flow_graph      graph;
+        liveness_info   liveness;
+
+        graph.build(code);
+        propagate_copies(code,graph);
+        liveness.compute(code,graph);
+
+        r = remove_copies(code,graph,liveness);
+        removed += r;
+    } while( r>0 );
+
+    return removed;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * C++ to IL compiler/generator static kernel cost model
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_COST_H
+#define __CAL_IL_COST_H
+
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+#include <cal/il/opt/cal_il_regalloc.hpp>
+
+namespace cal {
+namespace il {
+
+//
+// static instruction counts of IL kernel ( loops are not unrolled, every instruction counts once )
+// register and wavefront estimates follow Evergreen limits
+//
+
+struct kernel_cost
+{
+    int     alu_float;              // float ALU instructions ( mov, cmov_logical and exports included )
+    int     alu_int;                // integer and bit instructions, conversions to integer
+    int     alu_double;             // double precision instructions and conversions
+    int     alu_transcendental;     // exp, log, rcp, rsq, sqrt, sin, cos, ...
+    int     fetch;                  // sample, load and global buffer reads
+    int     lds;                    // LDS and GDS reads and writes
+    int     uav;                    // UAV loads and stores, global buffer writes
+    int     atomic;                 // UAV, LDS and GDS atomics
+    int     flow;                   // flow control instructions ( loops, branches, calls )
+    int     other;                  // fences, discard, ...
+
+    int     alu;                    // sum of ALU classes
+    double  alu_fetch_ratio;        // ALU instructions per fetch or UAV access ( 0 without memory access )
+
+    int     max_live;               // peak number of simultaneously live vec4 temporary registers
+    int     indexed_temps;          // registers in dcl_indexed_temp_array declarations
+    int     registers;              // estimated GPRs per thread ( max_live + indexed_temps kept in registers, at least 1 )
+    int     scratch_registers;      // registers above 128 GPR limit, indexed temps are placed in scratch memory
+    int     threads_per_group;      // from dcl_num_thread_per_group ( 0 when not declared )
+    int     wavefronts_per_simd;    // estimated resident wavefronts limited by registers
+    int     resident_threads;       // wavefronts_per_simd * wavefront size * number of SIMDs ( 0 when unknown )
+};
+
+namespace detail {
+
+//
+// register file holds 256 vec4 registers per lane, 8 of them are reserved for clause temporaries
+// single thread uses at most 128 GPRs, dispatcher keeps at most 496 wavefronts on whole chip
+//
+
+static const int COST_AVAILABLE_GPR  = 248;
+static const int COST_MAX_GPR        = 128;
+static const int COST_MAX_WAVEFRONTS = 496;
+
+inline bool opcode_in( const std::string& op, const char* const* list )
+{
+    for(;*list;list++) {
+        if( op==*list ) return true;
+    }
+    return false;
+}
+
+inline bool is_double_opcode( const std::string& op )
+{
+    static const char* const list[] = { "dadd", "dmul", "dmad", "dfma", "ddiv", "dfrac", "dfrexp", "dldexp", "deq", "dge", "dlt", "dne",
+                                        "dmax", "dmin", "dsqrt", "drcp", "drsq", "dabs", "dmov", "dmovc", "dtoi", "dtou", "itod", "utod",
+                                        "f2d", "d2f", NULL };
+    return opcode_in(op,list);
+}
+
+inline bool is_transcendental_opcode( const std::string& op )
+{
+    static const char* const list[] = { "exp", "log", "loge", "rcp", "rsq", "sqrt", "sin", "cos", "sincos", "pow", "div", NULL };
+    return opcode_in(op.substr(0,op.find('_')),list);
+}
+
+inline bool is_integer_opcode( const std::string& op )
+{
+    static const char* const list[] = { "ftoi", "ftou", "bitalign", "bytealign", "bfi", "bfm", "countbits", "firstbit", "ffb_hi", "ffb_lo", NULL };
+
+    if( op[0]=='i' || op[0]=='u' ) return true;
+    return opcode_in(op,list);
+}
+
+//
+// adds instruction to its class
+//
+
+inline void classify_instruction( const instruction& inst, kernel_cost& cost )
+{
+    std::string             op = base_opcode(inst.opcode);
+    instruction_flow_type   t = flow_type(inst);
+    unsigned                k;
+
+    if( t!=FLOW_NONE ) {
+        if( t!=FLOW_FUNC && t!=FLOW_ENDFUNC && t!=FLOW_ENDMAIN && t!=FLOW_END ) cost.flow++;
+        return;
+    }
+
+    if( op.compare(0,4,"uav_")==0 || op.compare(0,4,"lds_")==0 || op.compare(0,4,"gds_")==0 ) {
+        bool access = op.find("load")!=std::string::npos || op.find("store")!=std::string::npos
+                   || op.find("_read_vec")!=std::string::npos || op.find("_write_vec")!=std::string::npos || op.find("_arena_")!=std::string::npos;
+
+        if( !access ) cost.atomic++;
+        else if( op[0]=='u' ) cost.uav++;
+        else cost.lds++;
+        return;
+    }
+
+    if( op.compare(0,6,"sample")==0 || op.compare(0,4,"load")==0 || op.compare(0,5,"fetch")==0 || op.compare(0,6,"gather")==0 ) {
+        cost.fetch++;
+        return;
+    }
+
+    if( op.compare(0,5,"fence")==0 || op.compare(0,7,"discard")==0 || op=="nop" ) {
+        cost.other++;
+        return;
+    }
+
+    // global buffer is accessed with mov
+    if( !inst.operand.empty() && inst.operand[0].name.compare(0,2,"g[")==0 ) {
+        cost.uav++;
+        return;
+    }
+    for(k=1;k<inst.operand.size();k++) {
+        if( inst.operand[k].name.compare(0,2,"g[")==0 ) {
+            cost.fetch++;
+            return;
+        }
+    }
+
+    if( is_double_opcode(op) ) cost.alu_double++;
+    else if( is_transcendental_opcode(op) ) cost.alu_transcendental++;
+    else if( is_integer_opcode(op) ) cost.alu_int++;
+    else cost.alu_float++;
+}
+
+//
+// peak number of vec4 registers with at least one live component
+//
+
+inline int max_live_registers( const flow_graph& graph, const liveness_info& liveness )
+{
+    int         max_live=0;
+    unsigned    b,k;
+    int         c;
+
+    for(b=0;b<graph.block.size();b++) {
+        boost::dynamic_bitset<> live = liveness.live_out[b];
+
+        max_live = std::max(max_live,interference_graph::count_live(live));
+
+        for(int j=graph.block[b].last;j>=graph.block[b].first;j--) {
+            const register_access& a = liveness.access[j];
+
+            for(k=0;k<a.def.size();k++) {
+                for(c=0;c<4;c++) {
+                    if( a.def[k].second&(1<<c) ) live.reset(4*a.def[k].first+c);
+                }
+            }
+            for(k=0;k<a.use.size();k++) {
+                for(c=0;c<4;c++) {
+                    if( a.use[k].second&(1<<c) ) live.set(4*a.use[k].first+c);
+                }
+            }
+
+            max_live = std::max(max_live,interference_graph::count_live(live));
+        }
+    }
+
+    return max_live;
+}
+
+//
+// size of "dcl_indexed_temp_array x0[16]"
+//
+
+inline int indexed_temp_size( const instruction& inst )
+{
+    std::string::size_type p;
+
+    if( inst.operand.empty() ) return 0;
+    p = inst.operand[0].name.find('[');
+    if( p==std::string::npos ) return 0;
+
+    return std::atoi(inst.operand[0].name.c_str()+p+1);
+}
+
+//
+// code must contain complete program ( main, functions and matching flow control )
+// simd_count 0 when number of SIMDs is unknown
+//
+
+inline void estimate_cost( const instruction_list& code, kernel_cost& cost, int wavefront_size, int simd_count )
+{
+    unsigned i;
+
+    std::memset( &cost, 0, sizeof(cost) );
+
+    for(i=0;i<code.size();i++) {
+        const instruction& inst = code[i];
+        std::string        op = base_opcode(inst.opcode);
+
+        if( inst.opcode.empty() ) continue;
+        if( is_declaration(inst) ) {
+            if( op=="dcl_indexed_temp_array" ) cost.indexed_temps += indexed_temp_size(inst);
+            if( op=="dcl_num_thread_per_group" && !inst.operand.empty() ) {
+                cost.threads_per_group = 1;
+                for(unsigned k=0;k<inst.operand.size();k++) cost.threads_per_group *= std::max(std::atoi(inst.operand[k].name.c_str()),1);
+            }
+            continue;
+        }
+
+        classify_instruction(inst,cost);
+    }
+
+    cost.alu = cost.alu_float + cost.alu_int + cost.alu_double + cost.alu_transcendental;
+    if( cost.fetch+cost.uav>0 ) cost.alu_fetch_ratio = (double)cost.alu/(cost.fetch+cost.uav);
+
+    if( !code.empty() ) {
+        flow_graph      graph;
+        liveness_info   liveness;
+
+        graph.build(code);
+        liveness.compute(code,graph);
+        cost.max_live = max_live_registers(graph,liveness);
+    }
+
+    cost.registers = std::max(cost.max_live+cost.indexed_temps,1);
+    if( cost.registers>COST_MAX_GPR && cost.indexed_temps>0 ) {
+        cost.scratch_registers = std::min(cost.registers-COST_MAX_GPR,cost.indexed_temps);
+        cost.registers -= cost.scratch_registers;
+    }
+    cost.wavefronts_per_simd = COST_AVAILABLE_GPR/cost.registers;
+    if( simd_count>0 ) cost.wavefronts_per_simd = std::min(cost.wavefronts_per_simd,COST_MAX_WAVEFRONTS/simd_count);
+
+    // wavefronts of one group are scheduled together
+    if( cost.threads_per_group>0 && wavefront_size>0 ) {
+        int group = (cost.threads_per_group+wavefront_size-1)/wavefront_size;
+        cost.wavefronts_per_simd -= cost.wavefronts_per_simd%group;
+    }
+
+    cost.resident_threads = cost.wavefronts_per_simd*wavefront_size*simd_count;
+}
+
+} // detail
+
+//
+// static cost of IL source text
+// wavefront_size and simd_count describe target device ( simd_count 0 when unknown )
+//
+
+inline kernel_cost estimate_cost( const std::string& source, int wavefront_size=64, int simd_count=0 )
+{
+    detail::instruction_list    code;
+    kernel_cost                 cost;
+
+    detail::parse_code(source,code);
+    detail::estimate_cost(code,cost,wavefront_size,simd_count);
+
+    return cost;
+}
+
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,197 @@
+/*
+ * C++ to IL compiler/generator common subexpression elimination
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_CSE_H
+#define __CAL_IL_CSE_H
+
+#include <map>
+#include <string>
+#include <boost/lexical_cast.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// local value numbering
+// every register component and every constant operand component gets a value number
+//
+
+class value_numbering
+{
+protected:
+    std::map<std::pair<int,int>,int>    reg_value;
+    std::map<std::string,int>           named_value;
+    int                                 next_value;
+
+public:
+    value_numbering() : next_value(0) {}
+
+    void clear()
+    {
+        reg_value.clear();
+        named_value.clear();
+    }
+
+    int fresh()
+    {
+        return next_value++;
+    }
+
+    int get( int r, int c )
+    {
+        std::map<std::pair<int,int>,int>::iterator i = reg_value.find(std::make_pair(r,c));
+        if( i!=reg_value.end() ) return i->second;
+        return reg_value[std::make_pair(r,c)] = fresh();
+    }
+
+    void set( int r, int c, int v )
+    {
+        reg_value[std::make_pair(r,c)] = v;
+    }
+
+    void invalidate( const std::string& name )
+    {
+        for(int c=0;c<4;c++) named_value.erase(name + "." + "xyzw"[c]);
+    }
+
+    // value number of output component c of source operand ( constants 0 and 1 give -1 and -2 )
+    int get( const instruction_operand& op, int c )
+    {
+        int r = temp_register(op.name);
+        int s = swizzle_component(op.swizzle,c);
+
+        if( s<0 ) return s;
+        if( r>=0 ) return get(r,s);
+
+        std::string name = op.name + "." + "xyzw"[s];
+        std::map<std::string,int>::iterator i = named_value.find(name);
+        if( i!=named_value.end() ) return i->second;
+        return named_value[name] = fresh();
+    }
+};
+
+struct cse_entry
+{
+    int reg;
+    int value[4];
+};
+
+//
+// replaces pure instructions computing value already available in register by mov
+// works inside basic blocks, copies are left for copy propagation
+//
+
+inline int cse( instruction_list& code )
+{
+    flow_graph                          graph;
+    value_numbering                     vn;
+    std::map<std::string,cse_entry>     table;
+    int                                 eliminated=0;
+    unsigned                            b,k;
+    int                                 c;
+
+    graph.build(code);
+
+    for(b=0;b<graph.block.size();b++) {
+        vn.clear();
+        table.clear();
+
+        for(int i=graph.block[b].first;i<=graph.block[b].last;i++) {
+            instruction& inst = code[i];
+
+            if( !has_destination(inst) ) continue;
+
+            const instruction_operand& dst = inst.operand[0];
+            int                        r   = temp_register(dst.name);
+            int                        mask = write_mask(dst);
+            int                        value[4];
+
+            if( r<0 ) {
+                vn.invalidate(dst.name);
+                continue;
+            }
+
+            if( inst.opcode=="mov" && inst.operand.size()==2 && dst.modifier.empty() && inst.operand[1].modifier.empty() && !is_memory_operand(inst.operand[1]) ) {
+                for(c=0;c<4;c++) value[c] = vn.get(inst.operand[1],c);
+                for(c=0;c<4;c++) if( mask&(1<<c) ) vn.set(r,c,value[c]);
+                continue;
+            }
+
+            if( !is_pure(inst) ) {
+                for(c=0;c<4;c++) if( mask&(1<<c) ) vn.set(r,c,vn.fresh());
+                continue;
+            }
+
+            std::string key = inst.opcode + " " + dst.swizzle + dst.modifier;
+            for(k=1;k<inst.operand.size();k++) {
+                key += ",";
+                for(c=0;c<4;c++) key += boost::lexical_cast<std::string>(vn.get(inst.operand[k],c)) + ":";
+                key += inst.operand[k].modifier;
+            }
+
+            std::map<std::string,cse_entry>::iterator ientry = table.find(key);
+            bool                                      valid  = ientry!=table.end();
+
+            for(c=0;c<4 && valid;c++) {
+                if( (mask&(1<<c)) && vn.get(ientry->second.reg,c)!=ientry->second.value[c] ) valid=false;
+            }
+
+            if( valid ) {
+                instruction_operand src;
+
+                src.name = "r" + boost::lexical_cast<std::string>(ientry->second.reg);
+
+                inst.opcode = "mov";
+                inst.operand.resize(2);
+                inst.operand[0].modifier.clear();
+                inst.operand[1] = src;
+                inst.text.clear();
+
+                for(c=0;c<4;c++) if( mask&(1<<c) ) vn.set(r,c,ientry->second.value[c]);
+                eliminated++;
+                continue;
+            }
+
+            cse_entry entry;
+            entry.reg = r;
+            for(c=0;c<4;c++) {
+                entry.value[c] = -1;
+                if( mask&(1<<c) ) {
+                    entry.value[c] = vn.fresh();
+                    vn.set(r,c,entry.value[c]);
+                }
+            }
+            table[key] = entry;
+        }
+    }
+
+    return eliminated;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
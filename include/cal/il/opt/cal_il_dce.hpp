@@ -0,0 +1,130 @@
+/*
+ * C++ to IL compiler/generator dead code elimination
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_DCE_H
+#define __CAL_IL_DCE_H
+
+#include <string>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+#include <cal/il/opt/cal_il_copyprop.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// instructions which must be kept even if their result is never read
+// stores to g[], UAV, LDS and outputs, atomics, fences, flow control and unparsed lines
+//
+
+inline bool has_side_effects( const instruction& inst )
+{
+    std::string op = base_opcode(inst.opcode);
+
+    if( !inst.text.empty() || !has_destination(inst) ) return true;
+    if( temp_register(inst.operand[0].name)<0 ) return true;
+
+    // atomics returning previous value ( uav_read_add, lds_read_cmp_xchg, ... )
+    if( op.compare(0,4,"uav_")==0 || op.compare(0,4,"lds_")==0 || op.compare(0,4,"gds_")==0 ) {
+        return op.find("_read_")!=std::string::npos;
+    }
+
+    return false;
+}
+
+//
+// backward walk over blocks with liveness, removes instructions writing only dead components
+//
+
+inline int remove_dead( instruction_list& code, const flow_graph& graph, const liveness_info& liveness )
+{
+    std::vector<char>   remove(code.size(),0);
+    unsigned            b,k;
+    int                 c,removed=0;
+
+    for(b=0;b<graph.block.size();b++) {
+        boost::dynamic_bitset<> live = liveness.live_out[b];
+
+        for(int j=graph.block[b].last;j>=graph.block[b].first;j--) {
+            const register_access& a = liveness.access[j];
+
+            if( !code[j].opcode.empty() && !is_declaration(code[j]) && !has_side_effects(code[j]) && a.def.size()==1 ) {
+                bool dead = true;
+
+                for(c=0;c<4;c++) {
+                    if( (a.def[0].second&(1<<c)) && live.test(4*a.def[0].first+c) ) dead=false;
+                }
+
+                if( dead ) {
+                    remove[j] = 1;
+                    removed++;
+                    continue;
+                }
+            }
+
+            for(k=0;k<a.def.size();k++) {
+                for(c=0;c<4;c++) {
+                    if( a.def[k].second&(1<<c) ) live.reset(4*a.def[k].first+c);
+                }
+            }
+            for(k=0;k<a.use.size();k++) {
+                for(c=0;c<4;c++) {
+                    if( a.use[k].second&(1<<c) ) live.set(4*a.use[k].first+c);
+                }
+            }
+        }
+    }
+
+    compact_code(code,remove);
+    return removed;
+}
+
+//
+// dead code elimination, returns number of removed instructions
+//
+
+inline int dce( instruction_list& code )
+{
+    int removed=0,r;
+
+    do {
+        flow_graph      graph;
+        liveness_info   liveness;
+
+        graph.build(code);
+        liveness.compute(code,graph);
+
+        r = remove_dead(code,graph,liveness);
+        removed += r;
+    } while( r>0 );
+
+    return removed;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,356 @@
+/*
+ * C++ to IL compiler/generator control flow graph and register liveness
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_FLOWGRAPH_H
+#define __CAL_IL_FLOWGRAPH_H
+
+#include <map>
+#include <vector>
+#include <stdexcept>
+#include <cstdlib>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// dense numbering of temporary registers used in code
+//
+
+struct register_map
+{
+    std::map<int,int>   index;     // IL register -> dense id
+    std::vector<int>    reg;       // dense id -> IL register
+
+    int get( int r )
+    {
+        std::map<int,int>::iterator i = index.find(r);
+        if( i!=index.end() ) return i->second;
+
+        index[r] = (int)reg.size();
+        reg.push_back(r);
+        return (int)reg.size()-1;
+    }
+
+    int find( int r ) const
+    {
+        std::map<int,int>::const_iterator i = index.find(r);
+        if( i==index.end() ) return -1;
+        return i->second;
+    }
+
+    int size() const { return (int)reg.size(); }
+};
+
+//
+// register accesses of one instruction ( dense ids and component masks )
+//
+
+struct register_access
+{
+    std::vector<std::pair<int,int> > def;
+    std::vector<std::pair<int,int> > use;
+};
+
+struct access_collector
+{
+    register_map&                       map;
+    std::vector<std::pair<int,int> >&   out;
+    int                                 mask;
+
+    access_collector( register_map& _map, std::vector<std::pair<int,int> >& _out, int _mask ) : map(_map), out(_out), mask(_mask) {}
+
+    void operator()( std::string::size_type, std::string::size_type, int r ) const
+    {
+        out.push_back( std::make_pair(map.get(r),mask) );
+    }
+};
+
+inline void get_register_access( const instruction& inst, register_map& map, register_access& acc )
+{
+    unsigned i,first;
+
+    acc.def.clear();
+    acc.use.clear();
+
+    if( inst.opcode.empty() || is_declaration(inst) ) return;
+
+    first = 0;
+    if( has_destination(inst) ) {
+        const instruction_operand& dst = inst.operand[0];
+        int r = temp_register(dst.name);
+
+        if( r>=0 ) acc.def.push_back( std::make_pair(map.get(r),write_mask(dst)) );
+        else for_each_temp( dst.name, access_collector(map,acc.use,0xF) );
+        first = 1;
+    }
+
+    for(i=first;i<inst.operand.size();i++) {
+        const instruction_operand& src = inst.operand[i];
+        int r = temp_register(src.name);
+
+        if( r>=0 ) acc.use.push_back( std::make_pair(map.get(r),read_mask(src)) );
+        else for_each_temp( src.name, access_collector(map,acc.use,0xF) );
+    }
+}
+
+//
+// control flow graph built from structured IL flow control
+// every flow control instruction forms its own block, straight line code between them forms one block
+//
+
+struct flow_graph
+{
+    struct block_info
+    {
+        int                 first;
+        int                 last;
+        std::vector<int>    succ;
+        std::vector<int>    pred;
+    };
+
+    std::vector<block_info> block;
+    std::vector<int>        block_of;     // instruction -> block
+
+    void build( const instruction_list& code )
+    {
+        std::vector<std::vector<int> >  succ(code.size());
+        std::vector<int>                loop_stack,if_stack,else_of(code.size(),-1),end_of(code.size(),-1);
+        std::map<int,int>               func_entry;
+        std::map<int,std::vector<int> > return_sites;
+        std::vector<int>                func_of(code.size(),-1);
+        int                             n = (int)code.size(),current_func=-1;
+        int                             i;
+
+        block.clear();
+        block_of.assign(code.size(),-1);
+
+        // match structured flow control
+        for(i=0;i<n;i++) {
+            func_of[i] = current_func;
+
+            switch( flow_type(code[i]) ) {
+            case FLOW_WHILELOOP:
+                loop_stack.push_back(i);
+                break;
+            case FLOW_ENDLOOP:
+                if( loop_stack.empty() ) throw std::runtime_error("endloop without whileloop");
+                end_of[loop_stack.back()] = i;
+                end_of[i] = loop_stack.back();
+                loop_stack.pop_back();
+                break;
+            case FLOW_IF:
+                if_stack.push_back(i);
+                break;
+            case FLOW_ELSE:
+                if( if_stack.empty() ) throw std::runtime_error("else without if");
+                else_of[if_stack.back()] = i;
+                break;
+            case FLOW_ENDIF:
+                if( if_stack.empty() ) throw std::runtime_error("endif without if");
+                end_of[if_stack.back()] = i;
+                if( else_of[if_stack.back()]>=0 ) end_of[else_of[if_stack.back()]] = i;
+                if_stack.pop_back();
+                break;
+            case FLOW_FUNC:
+                current_func = std::atoi(code[i].operand.empty() ? "0" : code[i].operand[0].name.c_str());
+                func_entry[current_func] = i;
+                func_of[i] = current_func;
+                break;
+            case FLOW_ENDFUNC:
+                current_func = -1;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if( !loop_stack.empty() || !if_stack.empty() ) throw std::runtime_error("unbalanced IL flow control");
+
+        for(i=0;i<n;i++) {
+            if( flow_type(code[i])==FLOW_CALL && !code[i].operand.empty() ) {
+                return_sites[std::atoi(code[i].operand[0].name.c_str())].push_back(i+1);
+            }
+        }
+
+        // instruction successors
+        for(i=0;i<n;i++) {
+            std::vector<int>& s = succ[i];
+            int               loop = -1;
+
+            switch( flow_type(code[i]) ) {
+            case FLOW_BREAK:
+            case FLOW_BREAKC:
+            case FLOW_CONTINUE:
+            case FLOW_CONTINUEC:
+                for(int j=(int)i-1,depth=0;j>=0;j--) {
+                    instruction_flow_type t = flow_type(code[j]);
+                    if( t==FLOW_ENDLOOP ) depth++;
+                    else if( t==FLOW_WHILELOOP ) { if( depth==0 ) { loop=j; break; } depth--; }
+                }
+                if( loop<0 ) throw std::runtime_error("break or continue outside loop");
+                break;
+            default:
+                break;
+            }
+
+            switch( flow_type(code[i]) ) {
+            case FLOW_ENDLOOP:
+                s.push_back(end_of[i]);
+                break;
+            case FLOW_BREAK:
+                s.push_back(end_of[loop]+1);
+                break;
+            case FLOW_BREAKC:
+                s.push_back(end_of[loop]+1);
+                s.push_back(i+1);
+                break;
+            case FLOW_CONTINUE:
+                s.push_back(loop);
+                break;
+            case FLOW_CONTINUEC:
+                s.push_back(loop);
+                s.push_back(i+1);
+                break;
+            case FLOW_IF:
+                s.push_back(i+1);
+                if( else_of[i]>=0 ) s.push_back(else_of[i]+1);
+                else s.push_back(end_of[i]);
+                break;
+            case FLOW_ELSE:
+                s.push_back(end_of[i]);
+                break;
+            case FLOW_CALL:
+                if( !code[i].operand.empty() && func_entry.count(std::atoi(code[i].operand[0].name.c_str())) ) {
+                    s.push_back(func_entry[std::atoi(code[i].operand[0].name.c_str())]);
+                } else s.push_back(i+1);
+                break;
+            case FLOW_RET:
+                if( func_of[i]>=0 ) s = return_sites[func_of[i]];
+                break;
+            case FLOW_ENDFUNC:
+            case FLOW_ENDMAIN:
+            case FLOW_END:
+                break;
+            default:
+                s.push_back(i+1);
+            }
+
+            for(unsigned k=0;k<s.size();) {
+                if( s[k]>=n ) s.erase(s.begin()+k);
+                else k++;
+            }
+        }
+
+        // blocks
+        for(i=0;i<n;i++) {
+            bool flow  = flow_type(code[i])!=FLOW_NONE;
+            bool start = i==0 || flow || flow_type(code[i-1])!=FLOW_NONE;
+
+            if( start ) {
+                block.push_back(block_info());
+                block.back().first = i;
+            }
+            block.back().last = i;
+            block_of[i] = (int)block.size()-1;
+        }
+
+        for(unsigned b=0;b<block.size();b++) {
+            const std::vector<int>& s = succ[block[b].last];
+            for(unsigned k=0;k<s.size();k++) {
+                block[b].succ.push_back(block_of[s[k]]);
+                block[block_of[s[k]]].pred.push_back(b);
+            }
+        }
+    }
+};
+
+//
+// per component liveness of temporary registers ( bit 4*id+c for component c of register id )
+//
+
+struct liveness_info
+{
+    register_map                            map;
+    std::vector<register_access>            access;
+    std::vector<boost::dynamic_bitset<> >   live_in;
+    std::vector<boost::dynamic_bitset<> >   live_out;
+
+    void compute( const instruction_list& code, const flow_graph& graph )
+    {
+        std::vector<boost::dynamic_bitset<> >   use,def;
+        unsigned                                b,i,k;
+        bool                                    changed;
+
+        access.resize(code.size());
+        for(i=0;i<code.size();i++) get_register_access(code[i],map,access[i]);
+
+        std::size_t bits = 4*map.size();
+
+        use.assign(graph.block.size(),boost::dynamic_bitset<>(bits));
+        def.assign(graph.block.size(),boost::dynamic_bitset<>(bits));
+        live_in.assign(graph.block.size(),boost::dynamic_bitset<>(bits));
+        live_out.assign(graph.block.size(),boost::dynamic_bitset<>(bits));
+
+        for(b=0;b<graph.block.size();b++) {
+            for(int j=graph.block[b].last;j>=graph.block[b].first;j--) {
+                const register_access& a = access[j];
+
+                for(k=0;k<a.def.size();k++) {
+                    for(int c=0;c<4;c++) {
+                        if( !(a.def[k].second&(1<<c)) ) continue;
+                        def[b].set(4*a.def[k].first+c);
+                        use[b].reset(4*a.def[k].first+c);
+                    }
+                }
+                for(k=0;k<a.use.size();k++) {
+                    for(int c=0;c<4;c++) {
+                        if( a.use[k].second&(1<<c) ) use[b].set(4*a.use[k].first+c);
+                    }
+                }
+            }
+        }
+
+        do {
+            changed = false;
+            for(b=graph.block.size();b-->0;) {
+                boost::dynamic_bitset<> out(bits);
+                for(k=0;k<graph.block[b].succ.size();k++) out |= live_in[graph.block[b].succ[k]];
+
+                boost::dynamic_bitset<> in = use[b] | (out - def[b]);
+                if( in!=live_in[b] || out!=live_out[b] ) {
+                    live_in[b]  = in;
+                    live_out[b] = out;
+                    changed     = true;
+                }
+            }
+        } while( changed );
+    }
+};
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * C++ to IL compiler/generator algebraic identity simplification
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_FOLD_H
+#define __CAL_IL_FOLD_H
+
+#include <map>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// values of literal registers ( index -> 4 components )
+//
+
+typedef std::map<int,boost::array<boost::uint32_t,4> >  literal_table;
+
+inline void get_literals( const instruction_list& code, literal_table& literal )
+{
+    for(unsigned i=0;i<code.size();i++) {
+        const instruction& inst = code[i];
+
+        if( inst.opcode!="dcl_literal" || inst.operand.size()!=5 || inst.operand[0].name.compare(0,1,"l")!=0 ) continue;
+
+        boost::array<boost::uint32_t,4>& v = literal[std::atoi(inst.operand[0].name.c_str()+1)];
+        for(int c=0;c<4;c++) v[c] = (boost::uint32_t)std::strtoul(inst.operand[c+1].name.c_str(),NULL,0);
+    }
+}
+
+//
+// true when every component read by dst mask has ( value & mask )==v
+// constant swizzles "0" and "1" are float 0.0 and 1.0
+//
+
+inline bool is_constant_operand( const instruction_operand& op, int dst_mask, const literal_table& literal, boost::uint32_t mask, boost::uint32_t v )
+{
+    literal_table::const_iterator   il = literal.end();
+    boost::uint32_t                 value;
+
+    if( !op.modifier.empty() ) return false;
+    if( op.name.length()>1 && op.name[0]=='l' && std::isdigit(op.name[1]) ) il = literal.find(std::atoi(op.name.c_str()+1));
+
+    for(int c=0;c<4;c++) {
+        if( !(dst_mask&(1<<c)) ) continue;
+
+        int s = swizzle_component(op.swizzle,c);
+        if( s==-1 ) value = 0;
+        else if( s==-2 ) value = 0x3F800000;
+        else if( il!=literal.end() ) value = il->second[s];
+        else return false;
+
+        if( (value&mask)!=v ) return false;
+    }
+
+    return true;
+}
+
+struct identity_rule
+{
+    const char*     opcode;
+    int             operand;        // 1 or 2, commutative rules check both
+    bool            commutative;
+    boost::uint32_t mask;
+    boost::uint32_t value;
+};
+
+//
+// x+(-0.0), x-0.0, x*1.0, x+0, x*1, x&0xFFFFFFFF, x|0, x^0, x<<0, x>>0
+// float x+0.0 is not an identity for x=-0.0
+//
+
+inline const identity_rule* get_identity_rules()
+{
+    static const identity_rule rules[] = {
+        { "add",  1, true,  0xFFFFFFFF, 0x80000000 },
+        { "sub",  2, false, 0xFFFFFFFF, 0x00000000 },
+        { "mul",  1, true,  0xFFFFFFFF, 0x3F800000 },
+        { "iadd", 1, true,  0xFFFFFFFF, 0x00000000 },
+        { "imul", 1, true,  0xFFFFFFFF, 0x00000001 },
+        { "umul", 1, true,  0xFFFFFFFF, 0x00000001 },
+        { "iand", 1, true,  0xFFFFFFFF, 0xFFFFFFFF },
+        { "ior",  1, true,  0xFFFFFFFF, 0x00000000 },
+        { "ixor", 1, true,  0xFFFFFFFF, 0x00000000 },
+        { "ishl", 2, false, 0x0000001F, 0x00000000 },
+        { "ishr", 2, false, 0x0000001F, 0x00000000 },
+        { "ushr", 2, false, 0x0000001F, 0x00000000 },
+        { NULL,   0, false, 0,          0 }
+    };
+
+    return rules;
+}
+
+//
+// mad with multiplier 1 becomes add, mad with zero addend becomes mul
+//
+
+inline bool simplify_mad( instruction& inst, const literal_table& literal )
+{
+    std::string     add,mul;
+    boost::uint32_t one,zero;
+    int             mask = write_mask(inst.operand[0]);
+
+    if( inst.opcode=="mad" || inst.opcode=="fma" ) { add="add";  mul="mul";  one=0x3F800000; zero=0x80000000; }
+    else if( inst.opcode=="imad" ) { add="iadd"; mul="imul"; one=1; zero=0; }
+    else if( inst.opcode=="umad" ) { add="iadd"; mul="umul"; one=1; zero=0; }
+    else return false;
+
+    if( inst.operand.size()!=4 ) return false;
+
+    for(int k=1;k<=2;k++) {
+        if( !is_constant_operand(inst.operand[k],mask,literal,0xFFFFFFFF,one) ) continue;
+
+        inst.opcode = add;
+        inst.operand.erase(inst.operand.begin()+k);
+        return true;
+    }
+
+    if( is_constant_operand(inst.operand[3],mask,literal,0xFFFFFFFF,zero) ) {
+        inst.opcode = mul;
+        inst.operand.resize(3);
+        return true;
+    }
+
+    return false;
+}
+
+inline bool simplify_identity( instruction& inst, const literal_table& literal )
+{
+    const identity_rule*    rule;
+    int                     mask = write_mask(inst.operand[0]);
+
+    if( inst.operand.size()!=3 ) return false;
+
+    for(rule=get_identity_rules();rule->opcode;rule++) {
+        if( inst.opcode!=rule->opcode ) continue;
+
+        for(int k=rule->operand;k<=(rule->commutative ? 2 : rule->operand);k++) {
+            if( !is_constant_operand(inst.operand[k],mask,literal,rule->mask,rule->value) ) continue;
+
+            inst.opcode = "mov";
+            inst.operand.erase(inst.operand.begin()+k);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//
+// replaces instructions with identity literal operand by mov ( removed later by copy propagation )
+// returns number of simplified instructions
+//
+
+inline int fold( instruction_list& code, const literal_table& literal )
+{
+    int simplified=0;
+
+    for(unsigned i=0;i<code.size();i++) {
+        instruction& inst = code[i];
+        bool         changed = false;
+
+        if( !inst.text.empty() || !has_destination(inst) || !inst.operand[0].modifier.empty() ) continue;
+
+        while( simplify_mad(inst,literal) ) changed = true;
+        if( simplify_identity(inst,literal) ) changed = true;
+
+        if( changed ) simplified++;
+    }
+
+    return simplified;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,331 @@
+/*
+ * C++ to IL compiler/generator if-conversion
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_IFCONV_H
+#define __CAL_IL_IFCONV_H
+
+#include <string>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/cal_il_format.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// highest temporary register used by code ( -1 when there is none )
+//
+
+struct max_temp_finder
+{
+    int& max;
+
+    max_temp_finder( int& _max ) : max(_max) {}
+
+    void operator()( std::string::size_type pos, std::string::size_type len, int r ) const
+    {
+        if( r>max ) max = r;
+    }
+};
+
+inline int max_temp_register( const instruction_list& code )
+{
+    int max=-1;
+
+    for(unsigned i=0;i<code.size();i++) {
+        for_each_temp( code[i].text, max_temp_finder(max) );
+        for(unsigned k=0;k<code[i].operand.size();k++) for_each_temp( code[i].operand[k].name, max_temp_finder(max) );
+    }
+
+    return max;
+}
+
+//
+// instruction which can be executed unconditionally
+// no side effects and no memory access except texture sampling ( coordinates are clamped by sampler )
+// result in temporary register
+//
+
+inline bool is_predicable( const instruction& inst )
+{
+    bool sample = base_opcode(inst.opcode).compare(0,6,"sample")==0 && has_destination(inst);
+
+    if( !inst.text.empty() || !(sample || is_pure(inst)) ) return false;
+    if( inst.opcode.compare(0,7,"discard")==0 ) return false;
+    if( temp_register(inst.operand[0].name)<0 || !inst.operand[0].modifier.empty() ) return false;
+
+    return true;
+}
+
+//
+// condition of if instruction as mask with all components set when condition holds
+// comparisons are computed into new register, logical conditions are used directly
+// unless their register is written inside the block
+//
+
+inline bool get_ifconv_condition( const instruction& inst, const std::vector<char>& written, int& next, instruction_list& out, instruction_operand& cond, bool& negate )
+{
+    std::string op = base_opcode(inst.opcode);
+    std::string relop;
+    instruction cmp;
+
+    if( !inst.text.empty() ) return false;
+    negate = false;
+
+    if( op=="if_logicalnz" || op=="if_logicalz" ) {
+        if( inst.operand.size()!=1 ) return false;
+
+        int r = temp_register(inst.operand[0].name);
+        int s = swizzle_component(inst.operand[0].swizzle,0);
+
+        if( s<0 || inst.operand[0].name.find('[')!=std::string::npos ) return false;
+        negate = op=="if_logicalz";
+        cond = inst.operand[0];
+
+        if( (r>=0 && r<(int)written.size() && written[r]) || !cond.modifier.empty() ) {
+            cmp.opcode = "mov";
+            cmp.operand.resize(2);
+            cmp.operand[0].name = make_register('r',next++);
+            cmp.operand[0].swizzle = "x";
+            cmp.operand[1] = inst.operand[0];
+            out.push_back(cmp);
+
+            cond = cmp.operand[0];
+            s = 0;
+        }
+
+        cond.swizzle = std::string(4,"xyzw"[s]);
+        return true;
+    }
+
+    cmp.operand.resize(1);
+    cmp.operand[0].name = make_register('r',next++);
+    cmp.operand[0].swizzle = "x";
+
+    if( op=="ifnz" ) {
+        if( inst.operand.size()!=1 ) return false;
+
+        // swizzle "0" reads constant zero
+        cmp.opcode = "ne";
+        cmp.operand.push_back(inst.operand[0]);
+        cmp.operand.push_back(inst.operand[0]);
+        cmp.operand[2].swizzle = "0";
+        cmp.operand[2].modifier.clear();
+    }
+    else if( op=="ifc_relop" ) {
+        std::string::size_type p = inst.opcode.find('(');
+
+        if( inst.operand.size()!=2 || p==std::string::npos ) return false;
+        relop = inst.opcode.substr(p+1,inst.opcode.length()-p-2);
+
+        // le and gt are ge and lt with swapped operands
+        if( relop=="lt" || relop=="ge" || relop=="eq" || relop=="ne" ) {
+            cmp.opcode = relop;
+            cmp.operand.push_back(inst.operand[0]);
+            cmp.operand.push_back(inst.operand[1]);
+        }
+        else if( relop=="le" || relop=="gt" ) {
+            cmp.opcode = relop=="le" ? "ge" : "lt";
+            cmp.operand.push_back(inst.operand[1]);
+            cmp.operand.push_back(inst.operand[0]);
+        }
+        else return false;
+    }
+    else return false;
+
+    out.push_back(cmp);
+    cond = cmp.operand[0];
+    cond.swizzle = "xxxx";
+
+    return true;
+}
+
+//
+// source swizzle reading the same components as write mask ( "_y__" gives "y", "xy" gives "xyyy" )
+//
+
+inline std::string mask_swizzle( int mask )
+{
+    std::string s(4,' ');
+    char        fill=0;
+
+    for(int c=0;c<4;c++) {
+        if( (mask&(1<<c)) && !fill ) fill = "xyzw"[c];
+    }
+    for(int c=0;c<4;c++) s[c] = (mask&(1<<c)) ? "xyzw"[c] : fill;
+
+    if( s[0]==s[1] && s[0]==s[2] && s[0]==s[3] ) s.erase(1);
+    if( s=="xyzw" ) s.clear();
+    return s;
+}
+
+//
+// instruction computes result into new register, cmov_logical merges it with previous value
+// later instructions of the block read merged value which is correct when block is taken
+// and discarded by their own merge when it is not
+// results not live after the block are written directly
+//
+
+inline void predicate_instruction( const instruction& inst, const instruction_operand& cond, bool taken, bool merge_result, int& next, instruction_list& out )
+{
+    instruction         value = inst;
+    instruction         merge;
+    instruction_operand result;
+    instruction_operand old;
+
+    if( !merge_result ) {
+        out.push_back(inst);
+        return;
+    }
+
+    value.operand[0].name = make_register('r',next++);
+    out.push_back(value);
+
+    result.name = value.operand[0].name;
+    result.swizzle = mask_swizzle(write_mask(inst.operand[0]));
+    old.name = inst.operand[0].name;
+    old.swizzle = result.swizzle;
+
+    merge.opcode = "cmov_logical";
+    merge.operand.push_back(inst.operand[0]);
+    merge.operand.push_back(cond);
+    merge.operand.push_back(taken ? result : old);
+    merge.operand.push_back(taken ? old : result);
+    out.push_back(merge);
+}
+
+//
+// components of register live after the block
+//
+
+inline int live_components( const liveness_info& liveness, const boost::dynamic_bitset<>& live, int r )
+{
+    int id = liveness.map.find(r);
+    int mask = 0;
+
+    if( id<0 ) return 0;
+    for(int c=0;c<4;c++) {
+        if( live.test(4*id+c) ) mask |= 1<<c;
+    }
+    return mask;
+}
+
+inline bool reads_register( const instruction& inst, int r )
+{
+    for(unsigned k=1;k<inst.operand.size();k++) {
+        if( temp_register(inst.operand[k].name)==r ) return true;
+    }
+    return false;
+}
+
+//
+// replaces innermost "if ... [else ...] endif" blocks with at most limit instructions
+// by code evaluating both sides and selecting results with cmov_logical
+// blocks with stores, atomics, global or LDS reads, calls or loops keep branches
+// returns number of converted blocks
+//
+
+inline int ifconv( instruction_list& code, int limit )
+{
+    int     converted=0;
+    int     next = max_temp_register(code)+1;
+    bool    changed;
+
+    do {
+        flow_graph      graph;
+        liveness_info   liveness;
+        int             first_converted = (int)code.size();
+
+        graph.build(code);
+        liveness.compute(code,graph);
+        changed = false;
+
+        // last blocks first, liveness of earlier code stays valid
+        for(int i=(int)code.size()-1;i>=0;i--) {
+            if( flow_type(code[i])!=FLOW_IF ) continue;
+
+            std::vector<char>   written;
+            int                 els=-1,end=-1,count=0,j;
+            bool                ok=true;
+
+            for(j=i+1;j<(int)code.size() && ok;j++) {
+                instruction_flow_type ft = flow_type(code[j]);
+
+                if( ft==FLOW_ELSE && els<0 ) { els = j; continue; }
+                if( ft==FLOW_ENDIF ) { end = j; break; }
+                if( ft!=FLOW_NONE ) ok = false; // nested block is converted first
+                else if( code[j].opcode.empty() ) continue;
+                else if( !is_predicable(code[j]) ) ok = false;
+                else {
+                    int r = temp_register(code[j].operand[0].name);
+                    if( r>=(int)written.size() ) written.resize(r+1,0);
+                    written[r] = 1;
+                    count++;
+                }
+            }
+
+            // block containing converted code waits for next round with new liveness
+            if( !ok || end<0 || count>limit || end>=first_converted ) continue;
+
+            instruction_list                out;
+            instruction_operand             cond;
+            bool                            negate;
+            const boost::dynamic_bitset<>&  live = liveness.live_in[graph.block_of[end]];
+
+            if( !get_ifconv_condition(code[i],written,next,out,cond,negate) ) continue;
+
+            for(j=i+1;j<end;j++) {
+                if( j==els ) continue;
+                if( code[j].opcode.empty() ) {
+                    out.push_back(code[j]);
+                    continue;
+                }
+
+                int  r = temp_register(code[j].operand[0].name);
+                bool merge_result = (live_components(liveness,live,r)&write_mask(code[j].operand[0]))!=0;
+
+                // then part must not change registers read by else part
+                for(int k=els+1;els>=0 && j<els && k<end && !merge_result;k++) merge_result = reads_register(code[k],r);
+
+                predicate_instruction(code[j],cond,(els<0 || j<els)!=negate,merge_result,next,out);
+            }
+
+            code.erase(code.begin()+i,code.begin()+end+1);
+            code.insert(code.begin()+i,out.begin(),out.end());
+
+            first_converted = i;
+            converted++;
+            changed = true;
+        }
+    } while( changed );
+
+    return converted;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * C++ to IL compiler/generator function inlining
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_INLINE_H
+#define __CAL_IL_INLINE_H
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <cal/il/cal_il_instruction.hpp>
+
+namespace cal {
+namespace il {
+
+//
+// inlining policy of il_func ( applied by CAL_OPT_INLINE )
+//
+
+enum CALILInlineEnum
+{
+    CAL_INLINE_AUTO   = 0,      // inlined when small or called from few places
+    CAL_INLINE_ALWAYS = 1,
+    CAL_INLINE_NEVER  = 2
+};
+
+namespace detail {
+
+struct inline_function
+{
+    int     first;      // func
+    int     last;       // endfunc
+    int     body_end;   // final ret or endfunc
+    int     size;       // instructions in body
+    int     calls;
+    bool    leaf;       // no calls and no early returns
+};
+
+inline int call_target( const instruction& inst )
+{
+    return inst.operand.empty() ? -1 : std::atoi(inst.operand[0].name.c_str());
+}
+
+inline void get_inline_functions( const instruction_list& code, std::map<int,inline_function>& func )
+{
+    int i,j;
+
+    for(i=0;i<(int)code.size();i++) {
+        if( flow_type(code[i])!=FLOW_FUNC ) continue;
+
+        inline_function f;
+        f.first = i;
+        f.size = 0;
+        f.calls = 0;
+        f.leaf = true;
+
+        for(j=i+1;j<(int)code.size() && flow_type(code[j])!=FLOW_ENDFUNC;j++);
+        f.last = j;
+        f.body_end = (j>i+1 && flow_type(code[j-1])==FLOW_RET) ? j-1 : j;
+
+        for(j=i+1;j<f.body_end;j++) {
+            instruction_flow_type t = flow_type(code[j]);
+
+            if( t==FLOW_CALL || t==FLOW_RET || t==FLOW_FUNC ) f.leaf = false;
+            if( !code[j].opcode.empty() && !is_declaration(code[j]) ) f.size++;
+        }
+
+        func[call_target(code[i])] = f;
+        i = f.last;
+    }
+
+    for(i=0;i<(int)code.size();i++) {
+        if( flow_type(code[i])!=FLOW_CALL ) continue;
+
+        std::map<int,inline_function>::iterator ifunc = func.find(call_target(code[i]));
+        if( ifunc!=func.end() ) ifunc->second.calls++;
+    }
+}
+
+//
+// replaces calls with copy of function body, argument movs are left for copy propagation
+// functions are inlined bottom up, only bodies without calls are copied
+// CAL_INLINE_AUTO functions are inlined when they have at most max_calls call sites ( at least 1 )
+// or at most max_size instructions, endmain is removed when no function is left
+// returns number of inlined calls
+//
+
+inline int inline_calls( instruction_list& code, const std::map<int,int>& policy, int max_size, int max_calls )
+{
+    int     inlined=0;
+    bool    changed;
+
+    if( max_calls<1 ) max_calls = 1;
+
+    do {
+        std::map<int,inline_function>           func;
+        std::map<int,inline_function>::iterator ifunc;
+        std::vector<char>                       selected;
+        instruction_list                        result;
+
+        get_inline_functions(code,func);
+        changed = false;
+
+        for(ifunc=func.begin();ifunc!=func.end();++ifunc) {
+            std::map<int,int>::const_iterator   ipolicy = policy.find(ifunc->first);
+            int                                 p = ipolicy!=policy.end() ? ipolicy->second : CAL_INLINE_AUTO;
+            const inline_function&              f = ifunc->second;
+
+            if( !f.leaf || f.calls==0 || p==CAL_INLINE_NEVER ) continue;
+            if( p==CAL_INLINE_AUTO && f.calls>max_calls && f.size>max_size ) continue;
+
+            selected.resize(code.size(),0);
+            for(int j=f.first;j<=f.last;j++) selected[j] = 1;
+            changed = true;
+        }
+
+        if( !changed ) break;
+
+        for(unsigned i=0;i<code.size();i++) {
+            if( selected[i] ) continue;
+
+            if( flow_type(code[i])==FLOW_CALL ) {
+                ifunc = func.find(call_target(code[i]));
+
+                if( ifunc!=func.end() && selected[ifunc->second.first] ) {
+                    result.insert(result.end(),code.begin()+ifunc->second.first+1,code.begin()+ifunc->second.body_end);
+                    inlined++;
+                    continue;
+                }
+            }
+
+            result.push_back(code[i]);
+        }
+
+        code.swap(result);
+    } while( changed );
+
+    for(unsigned i=0;i<code.size() && inlined>0;i++) {
+        if( flow_type(code[i])==FLOW_FUNC ) return inlined;
+    }
+    for(unsigned i=0;i<code.size() && inlined>0;) {
+        if( flow_type(code[i])==FLOW_ENDMAIN ) code.erase(code.begin()+i);
+        else i++;
+    }
+
+    return inlined;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * C++ to IL compiler/generator loop invariant code motion
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_LICM_H
+#define __CAL_IL_LICM_H
+
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+#include <cal/il/opt/cal_il_copyprop.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// instruction which can be computed once before the loop
+// pure, result in temporary register, no unparsed text
+//
+
+inline bool is_hoistable( const instruction& inst )
+{
+    if( !inst.text.empty() || !is_pure(inst) ) return false;
+    return temp_register(inst.operand[0].name)>=0;
+}
+
+//
+// moves invariant instructions of loop starting at code[first] in front of it
+// operands are literals, constant buffers, input registers or registers not written in the loop
+// written components must not be live at loop entry ( value from before the loop is never read )
+// returns number of moved instructions
+//
+
+inline int hoist_loop( instruction_list& code, int first, int last, const flow_graph& graph, const liveness_info& liveness )
+{
+    const boost::dynamic_bitset<>&  live = liveness.live_in[graph.block_of[first]];
+    std::vector<int>                written(4*liveness.map.size(),0);   // writes of register component inside loop
+    std::vector<char>               hoist(code.size(),0);
+    instruction_list                moved;
+    int                             i,c,count=0;
+    unsigned                        k;
+
+    for(i=first+1;i<last;i++) {
+        const register_access& a = liveness.access[i];
+
+        // registers written by called function are not visible here
+        if( flow_type(code[i])==FLOW_CALL ) return 0;
+
+        for(k=0;k<a.def.size();k++) {
+            for(c=0;c<4;c++) {
+                if( a.def[k].second&(1<<c) ) written[4*a.def[k].first+c]++;
+            }
+        }
+    }
+
+    // instructions are visited in order, result of moved instruction is invariant for later ones
+    for(i=first+1;i<last;i++) {
+        const register_access&  a = liveness.access[i];
+        bool                    invariant = is_hoistable(code[i]) && a.def.size()==1;
+
+        for(k=0;k<a.use.size() && invariant;k++) {
+            for(c=0;c<4;c++) {
+                if( (a.use[k].second&(1<<c)) && written[4*a.use[k].first+c]>0 ) invariant = false;
+            }
+        }
+
+        for(c=0;c<4 && invariant;c++) {
+            int bit = 4*a.def[0].first+c;
+
+            if( !(a.def[0].second&(1<<c)) ) continue;
+            if( written[bit]!=1 || live.test(bit) ) invariant = false;
+        }
+
+        if( !invariant ) continue;
+
+        for(c=0;c<4;c++) {
+            if( a.def[0].second&(1<<c) ) written[4*a.def[0].first+c]--;
+        }
+
+        hoist[i] = 1;
+        moved.push_back(code[i]);
+        count++;
+    }
+
+    if( count==0 ) return 0;
+
+    compact_code(code,hoist);
+    code.insert(code.begin()+first,moved.begin(),moved.end());
+
+    return count;
+}
+
+//
+// loop invariant code motion for whileloop ... endloop
+// inner loops first, code moved out of inner loop can be moved further in next round
+// hoisted[n] receives number of instructions moved out of n-th loop ( in code order )
+// returns total number of moved instructions
+//
+
+inline int licm( instruction_list& code, std::vector<int>& hoisted )
+{
+    int     total=0;
+    bool    changed;
+
+    do {
+        flow_graph          graph;
+        liveness_info       liveness;
+        std::vector<int>    loop_start,loop_end,stack;
+        int                 i;
+
+        graph.build(code);
+        liveness.compute(code,graph);
+        changed = false;
+
+        for(i=0;i<(int)code.size();i++) {
+            instruction_flow_type t = flow_type(code[i]);
+
+            if( t==FLOW_WHILELOOP ) {
+                stack.push_back((int)loop_start.size());
+                loop_start.push_back(i);
+                loop_end.push_back(-1);
+            }
+            else if( t==FLOW_ENDLOOP && !stack.empty() ) {
+                loop_end[stack.back()] = i;
+                stack.pop_back();
+            }
+        }
+
+        if( hoisted.size()<loop_start.size() ) hoisted.resize(loop_start.size(),0);
+
+        // last loop first, inner loop starts after its outer loop
+        // liveness is recomputed after every change
+        for(i=(int)loop_start.size()-1;i>=0 && !changed;i--) {
+            int n = hoist_loop(code,loop_start[i],loop_end[i],graph,liveness);
+
+            if( n>0 ) {
+                hoisted[i] += n;
+                total += n;
+                changed = true;
+            }
+        }
+    } while( changed );
+
+    return total;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,257 @@
+/*
+ * C++ to IL compiler/generator multiply-add fusion
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_MAD_H
+#define __CAL_IL_MAD_H
+
+#include <string>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+#include <cal/il/opt/cal_il_copyprop.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// instructions which can be produced by mad fusion
+//
+
+enum CALILFuseEnum
+{
+    FUSE_FLOAT   = 1,       // mul+add -> mad
+    FUSE_FMA     = 2,       // mul+add -> fma ( instead of mad )
+    FUSE_DOUBLE  = 4,       // dmul+dadd -> dmad
+    FUSE_INTEGER = 8        // imul+iadd -> imad, umul+iadd -> umad
+};
+
+inline std::string fused_opcode( const std::string& mul, int kinds )
+{
+    if( mul=="mul" && (kinds&FUSE_FLOAT) ) return (kinds&FUSE_FMA) ? "fma" : "mad";
+    if( mul=="dmul" && (kinds&FUSE_DOUBLE) ) return "dmad";
+    if( mul=="imul" && (kinds&FUSE_INTEGER) ) return "imad";
+    if( mul=="umul" && (kinds&FUSE_INTEGER) ) return "umad";
+    return std::string();
+}
+
+inline const char* add_opcode( const std::string& mul )
+{
+    if( mul=="mul" ) return "add";
+    if( mul=="dmul" ) return "dadd";
+    return "iadd";
+}
+
+//
+// source operand of mul as seen through add operand swizzle
+//
+
+inline instruction_operand compose_operand( const instruction_operand& src, const std::string& swizzle, int mask )
+{
+    instruction_operand r = src;
+    std::string         s;
+
+    for(int c=0;c<4;c++) {
+        int k = (mask&(1<<c)) ? swizzle_component(swizzle,c) : 0;
+        int v = swizzle_component(src.swizzle,k);
+
+        s += v>=0 ? "xyzw"[v] : (v==-1 ? '0' : '1');
+    }
+
+    if( s[0]==s[1] && s[0]==s[2] && s[0]==s[3] ) s.erase(1);
+    r.swizzle = (s=="xyzw") ? std::string() : s;
+    return r;
+}
+
+inline bool reads_components( const register_access& a, int id, int mask )
+{
+    for(unsigned k=0;k<a.use.size();k++) {
+        if( a.use[k].first==id && (a.use[k].second&mask) ) return true;
+    }
+    return false;
+}
+
+inline bool writes_components( const register_access& a, int id, int mask )
+{
+    for(unsigned k=0;k<a.def.size();k++) {
+        if( a.def[k].first==id && (a.def[k].second&mask) ) return true;
+    }
+    return false;
+}
+
+struct register_finder
+{
+    int     reg;
+    bool&   found;
+
+    register_finder( int _reg, bool& _found ) : reg(_reg), found(_found) {}
+
+    void operator()( std::string::size_type pos, std::string::size_type len, int r ) const
+    {
+        if( r==reg ) found = true;
+    }
+};
+
+inline bool references_register( const instruction_operand& op, int r )
+{
+    bool found = false;
+    for_each_temp( op.name, register_finder(r,found) );
+    return found;
+}
+
+//
+// tries to fuse add at position i with mul defining its operand k
+// mul result must be used only by the add and mul operands must not change in between
+// returns position of fused mul or -1
+//
+
+inline int fuse_operand( instruction_list& code, int first, int i, unsigned k, const boost::dynamic_bitset<>& live, const liveness_info& liveness, int kinds, const std::vector<char>& used )
+{
+    const instruction&  add  = code[i];
+    const instruction_operand& op = add.operand[k];
+    int                 mask = write_mask(add.operand[0]);
+    int                 r    = temp_register(op.name);
+    int                 id   = r>=0 ? liveness.map.find(r) : -1;
+    int                 read = 0;
+    int                 j,m,c;
+
+    if( id<0 || !op.modifier.empty() ) return -1;
+    if( references_register(add.operand[0],r) || references_register(add.operand[3-k],r) ) return -1;
+
+    for(c=0;c<4;c++) {
+        int s = swizzle_component(op.swizzle,c);
+        if( !(mask&(1<<c)) ) continue;
+        if( s<0 ) return -1;
+        read |= 1<<s;
+    }
+
+    // closest earlier instruction writing read components
+    for(j=i-1;j>=first && !writes_components(liveness.access[j],id,read);j--) {
+        if( reads_components(liveness.access[j],id,read) ) return -1;
+    }
+    if( j<first || used[j] ) return -1;
+
+    const instruction& mul = code[j];
+
+    if( !mul.text.empty() || mul.operand.size()!=3 || add_opcode(mul.opcode)!=add.opcode ) return -1;
+    if( fused_opcode(mul.opcode,kinds).empty() || !mul.operand[0].modifier.empty() ) return -1;
+    if( temp_register(mul.operand[0].name)!=r || (write_mask(mul.operand[0])&read)!=read ) return -1;
+    if( is_memory_operand(mul.operand[1]) || is_memory_operand(mul.operand[2]) ) return -1;
+    if( !mul.operand[1].modifier.empty() || !mul.operand[2].modifier.empty() ) return -1;
+
+    // mul result is dead after add
+    int written = write_mask(mul.operand[0]);
+    for(c=0;c<4;c++) {
+        if( (written&(1<<c)) && live.test(4*id+c) ) return -1;
+    }
+
+    // reads of other mul components between mul and add, changes of mul operands
+    const register_access& amul = liveness.access[j];
+    for(m=j+1;m<i;m++) {
+        const register_access& a = liveness.access[m];
+
+        if( reads_components(a,id,written) ) return -1;
+        for(unsigned u=0;u<amul.use.size();u++) {
+            if( writes_components(a,amul.use[u].first,amul.use[u].second) ) return -1;
+        }
+    }
+
+    instruction fused;
+    fused.opcode = fused_opcode(mul.opcode,kinds);
+    fused.operand.push_back(add.operand[0]);
+    fused.operand.push_back(compose_operand(mul.operand[1],op.swizzle,mask));
+    fused.operand.push_back(compose_operand(mul.operand[2],op.swizzle,mask));
+    fused.operand.push_back(add.operand[3-k]);
+
+    code[i] = fused;
+    return j;
+}
+
+//
+// fuses multiply with single use in following add into mad/fma/dmad/imad/umad
+// returns number of fused instruction pairs
+//
+
+inline int fuse_mad( instruction_list& code, int kinds )
+{
+    int fused=0,n;
+
+    do {
+        flow_graph              graph;
+        liveness_info           liveness;
+        std::vector<char>       used(code.size(),0);
+        std::vector<char>       remove(code.size(),0);
+        unsigned                b,k;
+        int                     c;
+
+        graph.build(code);
+        liveness.compute(code,graph);
+        n = 0;
+
+        for(b=0;b<graph.block.size();b++) {
+            boost::dynamic_bitset<> live = liveness.live_out[b];
+
+            // live sets after each instruction of the block
+            std::vector<boost::dynamic_bitset<> > live_after(graph.block[b].last-graph.block[b].first+1);
+            for(int j=graph.block[b].last;j>=graph.block[b].first;j--) {
+                const register_access& a = liveness.access[j];
+
+                live_after[j-graph.block[b].first] = live;
+                for(k=0;k<a.def.size();k++) {
+                    for(c=0;c<4;c++) if( a.def[k].second&(1<<c) ) live.reset(4*a.def[k].first+c);
+                }
+                for(k=0;k<a.use.size();k++) {
+                    for(c=0;c<4;c++) if( a.use[k].second&(1<<c) ) live.set(4*a.use[k].first+c);
+                }
+            }
+
+            for(int i=graph.block[b].first;i<=graph.block[b].last;i++) {
+                const instruction& add = code[i];
+
+                if( used[i] || !add.text.empty() || add.operand.size()!=3 || !has_destination(add) ) continue;
+                if( add.opcode!="add" && add.opcode!="dadd" && add.opcode!="iadd" ) continue;
+
+                for(k=1;k<=2;k++) {
+                    int j = fuse_operand(code,graph.block[b].first,i,k,live_after[i-graph.block[b].first],liveness,kinds,used);
+                    if( j<0 ) continue;
+
+                    used[i] = used[j] = 1;
+                    remove[j] = 1;
+                    n++;
+                    break;
+                }
+            }
+        }
+
+        compact_code(code,remove);
+        fused += n;
+    } while( n>0 );
+
+    return fused;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
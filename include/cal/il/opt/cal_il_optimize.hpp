@@ -0,0 +1,162 @@
+/*
+ * C++ to IL compiler/generator optimization passes
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_OPTIMIZE_H
+#define __CAL_IL_OPTIMIZE_H
+
+#include <map>
+#include <cstring>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+#include <cal/il/opt/cal_il_regalloc.hpp>
+#include <cal/il/opt/cal_il_fold.hpp>
+#include <cal/il/opt/cal_il_cse.hpp>
+#include <cal/il/opt/cal_il_copyprop.hpp>
+#include <cal/il/opt/cal_il_dce.hpp>
+#include <cal/il/opt/cal_il_mad.hpp>
+#include <cal/il/opt/cal_il_slp.hpp>
+#include <cal/il/opt/cal_il_ifconv.hpp>
+#include <cal/il/opt/cal_il_inline.hpp>
+#include <cal/il/opt/cal_il_licm.hpp>
+#include <cal/il/opt/cal_il_schedule.hpp>
+
+namespace cal {
+namespace il {
+
+//
+// optimization passes run by Source::end ( set Source::info().optimize after Source::begin )
+//
+
+enum CALILOptimizeEnum
+{
+    CAL_OPT_NONE     = 0,
+    CAL_OPT_REGALLOC = 1,
+    CAL_OPT_CSE      = 2,
+    CAL_OPT_COPYPROP = 4,
+    CAL_OPT_FOLD     = 8,
+    CAL_OPT_DCE      = 16,
+    CAL_OPT_MAD      = 32,
+    CAL_OPT_SLP      = 64,
+    CAL_OPT_IFCONV   = 128,
+    CAL_OPT_INLINE   = 256,
+    CAL_OPT_LICM     = 512,
+    CAL_OPT_SCHEDULE = 1024
+};
+
+struct optimize_info
+{
+    regalloc_info   regalloc;
+    int             cse_eliminated;     // instructions replaced by copy of earlier result
+    int             copies_removed;     // mov instructions removed by copy propagation
+    int             identities_folded;  // instructions with identity literal operand ( x*1, x+0, ... )
+    int             dead_removed;       // instructions removed by dead code elimination
+    int             mad_fused;          // mul+add pairs fused into single instruction
+    int             slp_merged;         // scalar instructions merged into vector instructions
+    int             ifs_converted;      // if blocks replaced by cmov_logical
+    int             calls_inlined;      // calls replaced by function body
+    int             licm_hoisted;       // loop invariant instructions moved in front of their loop
+    int             licm_loop[16];      // licm_hoisted for first 16 loops ( in order of whileloop in code )
+    int             fetches_scheduled;  // fetches moved in front of independent instructions
+};
+
+namespace detail {
+
+//
+// properties of generated code and target used by passes
+//
+
+struct optimize_target
+{
+    literal_table       literal;
+    int                 fuse;               // FUSE_* instructions allowed by mad fusion
+    int                 ifconv_limit;       // largest if block ( in instructions ) converted to cmov_logical
+    std::map<int,int>   inline_policy;      // function id -> CAL_INLINE_*
+    int                 inline_size;        // CAL_INLINE_AUTO functions with at most this many instructions are inlined
+    int                 inline_calls;       // CAL_INLINE_AUTO functions with at most this many call sites are inlined
+    int                 schedule_registers; // live vec4 registers allowed when fetches are moved up
+
+    optimize_target() : fuse(0), ifconv_limit(8), inline_size(0), inline_calls(1), schedule_registers(32) {}
+};
+
+inline void optimize( instruction_list& code, int flags, optimize_info& info, const optimize_target& target )
+{
+    if( flags&CAL_OPT_INLINE ) info.calls_inlined += inline_calls(code,target.inline_policy,target.inline_size,target.inline_calls);
+    if( flags&CAL_OPT_FOLD ) info.identities_folded += fold(code,target.literal);
+    if( flags&CAL_OPT_CSE ) info.cse_eliminated += cse(code);
+    if( flags&CAL_OPT_COPYPROP ) info.copies_removed += copyprop(code);
+    if( flags&CAL_OPT_DCE ) info.dead_removed += dce(code);
+    if( flags&CAL_OPT_LICM ) {
+        std::vector<int> hoisted;
+
+        info.licm_hoisted += licm(code,hoisted);
+        for(unsigned i=0;i<hoisted.size() && i<16;i++) info.licm_loop[i] += hoisted[i];
+    }
+    if( flags&CAL_OPT_IFCONV ) {
+        // block size is measured after cleanup, merged results can have new copies to propagate
+        int converted = ifconv(code,target.ifconv_limit);
+
+        if( converted>0 && (flags&CAL_OPT_COPYPROP) ) info.copies_removed += copyprop(code);
+        if( converted>0 && (flags&CAL_OPT_DCE) ) info.dead_removed += dce(code);
+        info.ifs_converted += converted;
+    }
+    if( flags&CAL_OPT_MAD ) info.mad_fused += fuse_mad(code,target.fuse);
+    if( flags&CAL_OPT_SLP ) info.slp_merged += slp(code);
+    if( flags&CAL_OPT_SCHEDULE ) info.fetches_scheduled += schedule(code,target.schedule_registers);
+    if( flags&CAL_OPT_REGALLOC ) regalloc(code,info.regalloc);
+}
+
+} // detail
+
+//
+// runs optimization passes on IL source text
+// mad fusion uses non IEEE mad, dmad and integer mad
+// if-conversion evaluates both sides of if blocks with up to 8 instructions
+// functions called from single place are inlined
+// loop invariant instructions are computed once in front of the loop
+// fetches are moved up while at most 32 vec4 registers are live
+//
+
+inline std::string optimize( const std::string& source, int flags, optimize_info* info=NULL )
+{
+    detail::instruction_list    code;
+    detail::optimize_target     target;
+    optimize_info               _info;
+    std::string                 r;
+
+    std::memset( &_info, 0, sizeof(_info) );
+    target.fuse = detail::FUSE_FLOAT|detail::FUSE_DOUBLE|detail::FUSE_INTEGER;
+
+    detail::parse_code(source,code);
+    detail::get_literals(code,target.literal);
+    detail::optimize(code,flags,_info,target);
+    detail::emit_code(code,r);
+
+    if( !source.empty() && source[source.length()-1]!='\n' ) r.erase(r.length()-1);
+    if( info ) *info = _info;
+
+    return r;
+}
+
+} // il
+} // cal
+
+#endif
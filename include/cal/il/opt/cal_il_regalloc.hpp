@@ -0,0 +1,238 @@
+/*
+ * C++ to IL compiler/generator register allocation
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_REGALLOC_H
+#define __CAL_IL_REGALLOC_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+
+namespace cal {
+namespace il {
+
+struct regalloc_info
+{
+    int original_register_count;    // temporary registers used by generated code
+    int register_count;             // temporary registers after allocation
+    int max_live;                   // peak number of simultaneously live vec4 registers
+};
+
+namespace detail {
+
+//
+// interference graph
+// two registers interfere when the same component of both is live at the same time
+//
+
+struct interference_graph
+{
+    std::vector<std::vector<int> >  edge;
+    int                             max_live;
+
+    void add( int a, int b )
+    {
+        if( a==b ) return;
+        edge[a].push_back(b);
+        edge[b].push_back(a);
+    }
+
+    static int count_live( const boost::dynamic_bitset<>& live )
+    {
+        int      n=0,last=-1;
+        std::size_t i;
+
+        for(i=live.find_first();i!=boost::dynamic_bitset<>::npos;i=live.find_next(i)) {
+            if( (int)(i/4)!=last ) { last=(int)(i/4); n++; }
+        }
+        return n;
+    }
+
+    void build( const instruction_list& code, const flow_graph& graph, const liveness_info& liveness )
+    {
+        std::size_t i;
+        unsigned    b,k;
+        int         c;
+
+        edge.assign(liveness.map.size(),std::vector<int>());
+        max_live = 0;
+
+        if( code.empty() ) return;
+
+        for(b=0;b<graph.block.size();b++) {
+            boost::dynamic_bitset<> live = liveness.live_out[b];
+
+            max_live = std::max(max_live,count_live(live));
+
+            for(int j=graph.block[b].last;j>=graph.block[b].first;j--) {
+                const register_access& a = liveness.access[j];
+
+                for(k=0;k<a.def.size();k++) {
+                    for(c=0;c<4;c++) {
+                        if( !(a.def[k].second&(1<<c)) ) continue;
+                        for(i=live.find_first();i!=boost::dynamic_bitset<>::npos;i=live.find_next(i)) {
+                            if( (int)(i%4)==c ) add(a.def[k].first,(int)(i/4));
+                        }
+                    }
+                }
+                for(k=0;k<a.def.size();k++) {
+                    for(c=0;c<4;c++) {
+                        if( a.def[k].second&(1<<c) ) live.reset(4*a.def[k].first+c);
+                    }
+                }
+                for(k=0;k<a.use.size();k++) {
+                    for(c=0;c<4;c++) {
+                        if( a.use[k].second&(1<<c) ) live.set(4*a.use[k].first+c);
+                    }
+                }
+
+                max_live = std::max(max_live,count_live(live));
+            }
+        }
+
+        // registers read before being written keep their values apart
+        const boost::dynamic_bitset<>& entry = liveness.live_in[0];
+        for(i=entry.find_first();i!=boost::dynamic_bitset<>::npos;i=entry.find_next(i)) {
+            for(std::size_t j=entry.find_next(i);j!=boost::dynamic_bitset<>::npos;j=entry.find_next(j)) {
+                if( i%4==j%4 ) add((int)(i/4),(int)(j/4));
+            }
+        }
+    }
+};
+
+struct register_renamer
+{
+    const std::vector<int>&     color;
+    const register_map&         map;
+    std::string&                out;
+    const std::string&          src;
+    std::string::size_type&     last;
+
+    register_renamer( const std::vector<int>& _color, const register_map& _map, std::string& _out, const std::string& _src, std::string::size_type& _last ) :
+        color(_color), map(_map), out(_out), src(_src), last(_last) {}
+
+    void operator()( std::string::size_type pos, std::string::size_type len, int r ) const
+    {
+        int id = map.find(r);
+        if( id<0 ) return;
+
+        out += src.substr(last,pos-last);
+        out += "r";
+        out += boost::lexical_cast<std::string>(color[id]);
+        last = pos+len;
+    }
+};
+
+inline bool rename_registers( std::string& s, const std::vector<int>& color, const register_map& map )
+{
+    std::string             r;
+    std::string::size_type  last=0;
+
+    for_each_temp( s, register_renamer(color,map,r,s,last) );
+    if( last==0 ) return false;
+
+    r += s.substr(last);
+    if( r==s ) return false;
+
+    s = r;
+    return true;
+}
+
+//
+// renumbers temporary registers so registers with disjoint live ranges share one IL register
+// code must contain complete program ( main, functions and matching flow control )
+//
+
+inline void regalloc( instruction_list& code, regalloc_info& info )
+{
+    flow_graph          graph;
+    liveness_info       liveness;
+    interference_graph  interference;
+    std::vector<int>    color;
+    std::vector<char>   used;
+    unsigned            i,k;
+    int                 n;
+
+    graph.build(code);
+    liveness.compute(code,graph);
+    interference.build(code,graph,liveness);
+
+    n = liveness.map.size();
+    info.original_register_count = n;
+    info.max_live                = interference.max_live;
+    info.register_count          = 0;
+
+    // greedy coloring in order of first appearance
+    color.assign(n,-1);
+    for(int id=0;id<n;id++) {
+        const std::vector<int>& e = interference.edge[id];
+
+        used.assign(e.size()+1,0);
+        for(k=0;k<e.size();k++) {
+            if( color[e[k]]>=0 && color[e[k]]<(int)used.size() ) used[color[e[k]]] = 1;
+        }
+
+        for(k=0;used[k];k++);
+        color[id] = k;
+        info.register_count = std::max(info.register_count,(int)k+1);
+    }
+
+    for(i=0;i<code.size();i++) {
+        instruction& inst = code[i];
+
+        if( inst.opcode.empty() || is_declaration(inst) ) continue;
+
+        for(k=0;k<inst.operand.size();k++) rename_registers(inst.operand[k].name,color,liveness.map);
+        if( !inst.text.empty() ) rename_registers(inst.text,color,liveness.map);
+    }
+}
+
+} // detail
+
+//
+// register allocation of IL source text ( comments and declarations are kept unchanged )
+//
+
+inline std::string regalloc( const std::string& source, regalloc_info* info=NULL )
+{
+    detail::instruction_list    code;
+    regalloc_info               _info;
+    std::string                 r;
+
+    detail::parse_code(source,code);
+    detail::regalloc(code,_info);
+    detail::emit_code(code,r);
+
+    if( !source.empty() && source[source.length()-1]!='\n' ) r.erase(r.length()-1);
+    if( info ) *info = _info;
+
+    return r;
+}
+
+} // il
+} // cal
+
+#endif
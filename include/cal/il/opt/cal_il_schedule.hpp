@@ -0,0 +1,361 @@
+/*
+ * C++ to IL compiler/generator instruction scheduling
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_SCHEDULE_H
+#define __CAL_IL_SCHEDULE_H
+
+#include <set>
+#include <vector>
+#include <cassert>
+#include <boost/dynamic_bitset.hpp>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// ordering constraints of instruction apart from its registers
+//
+
+enum schedule_kind
+{
+    SCHEDULE_ALU = 0,       // pure, moves freely
+    SCHEDULE_FETCH,         // read only resource ( sample, load ), moves freely
+    SCHEDULE_READ,          // memory read, stays after preceding writes
+    SCHEDULE_WRITE,         // stores, atomics, outputs, stays in order with all memory accesses
+    SCHEDULE_BARRIER        // comments, declarations, fences, nothing moves across
+};
+
+inline schedule_kind get_schedule_kind( const instruction& inst )
+{
+    std::string op = base_opcode(inst.opcode);
+
+    if( inst.opcode.empty() || is_declaration(inst) || flow_type(inst)!=FLOW_NONE ) return SCHEDULE_BARRIER;
+    if( op.compare(0,5,"fence")==0 || op.compare(0,7,"discard")==0 ) return SCHEDULE_BARRIER;
+    if( !has_destination(inst) || temp_register(inst.operand[0].name)<0 ) return SCHEDULE_WRITE;
+
+    if( op.compare(0,6,"sample")==0 || op.compare(0,4,"load")==0 || op.compare(0,5,"fetch")==0 || op.compare(0,6,"gather")==0 ) return SCHEDULE_FETCH;
+    if( op.compare(0,4,"uav_")==0 || op.compare(0,4,"lds_")==0 || op.compare(0,4,"gds_")==0 ) {
+        // atomics with return value
+        if( op.find("_load")==std::string::npos && op.find("_read_vec")==std::string::npos ) return SCHEDULE_WRITE;
+        return SCHEDULE_READ;
+    }
+    if( !is_pure(inst) ) return SCHEDULE_READ;
+
+    return SCHEDULE_ALU;
+}
+
+//
+// fetch with long latency ( texture, UAV or global buffer read )
+//
+
+inline bool is_long_latency( const instruction& inst, schedule_kind kind )
+{
+    std::string op = base_opcode(inst.opcode);
+
+    if( kind==SCHEDULE_FETCH ) return true;
+    if( kind!=SCHEDULE_READ ) return false;
+    if( op.compare(0,4,"uav_")==0 ) return true;
+
+    for(unsigned k=1;k<inst.operand.size();k++) {
+        if( inst.operand[k].name.compare(0,2,"g[")==0 ) return true;
+    }
+    return false;
+}
+
+//
+// value of register component inside scheduled block
+// value is live after it is written ( or from block entry ) until its last reader is scheduled,
+// last value of component live after the block stays live to the end
+//
+
+struct schedule_value
+{
+    int     bit;
+    int     readers;    // unscheduled readers
+    bool    final;
+    bool    started;
+    bool    live;
+};
+
+//
+// per component data reused between blocks ( only components touched by block are reset )
+//
+
+struct schedule_state
+{
+    std::vector<int>                current;        // value of component, -1 when not accessed yet
+    std::vector<int>                last_write;     // instruction writing current value
+    std::vector<std::vector<int> >  readers;        // instructions reading current value
+    std::vector<int>                count;          // live values of register
+    std::vector<int>                touched;
+
+    void resize( int registers )
+    {
+        current.assign(4*registers,-1);
+        last_write.assign(4*registers,-1);
+        readers.assign(4*registers,std::vector<int>());
+        count.assign(registers,0);
+    }
+
+    void clear()
+    {
+        for(unsigned i=0;i<touched.size();i++) {
+            int bit = touched[i];
+            current[bit] = last_write[bit] = -1;
+            readers[bit].clear();
+            count[bit/4] = 0;
+        }
+        touched.clear();
+    }
+};
+
+struct schedule_pressure
+{
+    std::vector<schedule_value>&    value;
+    std::vector<int>&               count;
+    int                             pressure;
+
+    schedule_pressure( std::vector<schedule_value>& _value, std::vector<int>& _count ) : value(_value), count(_count), pressure(0) {}
+
+    void update( int v )
+    {
+        schedule_value& x = value[v];
+        bool            l = x.started && (x.readers>0 || x.final);
+
+        if( l==x.live ) return;
+        x.live = l;
+
+        if( l ) { if( count[x.bit/4]++==0 ) pressure++; }
+        else { if( --count[x.bit/4]==0 ) pressure--; }
+    }
+};
+
+inline int new_schedule_value( std::vector<schedule_value>& value, schedule_state& state, int bit, bool started )
+{
+    schedule_value v;
+
+    if( state.current[bit]<0 ) state.touched.push_back(bit);
+
+    v.bit = bit;
+    v.readers = 0;
+    v.final = false;
+    v.started = started;
+    v.live = false;
+    value.push_back(v);
+
+    return state.current[bit] = (int)value.size()-1;
+}
+
+enum schedule_queue
+{
+    SCHEDULE_QUEUE_FETCH = 0,
+    SCHEDULE_QUEUE_FEED  = 1,       // fetch depends on it
+    SCHEDULE_QUEUE_OTHER = 2
+};
+
+inline void add_schedule_edge( std::vector<std::vector<int> >& succ, std::vector<int>& npred, int from, int to )
+{
+    if( from<0 || from==to ) return;
+    succ[from].push_back(to);
+    npred[to]++;
+}
+
+//
+// list scheduling of one basic block
+// while live registers stay within budget ready long latency fetches are issued first,
+// then instructions which fetches wait for, results of fetches are used as late as possible
+// otherwise instructions keep their original order, result depends only on input code
+// returns number of fetches moved in front of earlier instructions
+//
+
+inline int schedule_block( instruction_list& code, int first, int last, const liveness_info& liveness, const boost::dynamic_bitset<>& live_out, schedule_state& state, int budget )
+{
+    int                             n = last-first+1;
+    std::vector<std::vector<int> >  succ(n),reads(n),writes(n);
+    std::vector<int>                npred(n,0);
+    std::vector<schedule_kind>      kind(n);
+    std::vector<char>               fetch(n,0);
+    std::vector<int>                queue(n,SCHEDULE_QUEUE_OTHER);
+    std::vector<char>               done(n,0);
+    std::vector<int>                order;
+    std::vector<schedule_value>     value;
+    schedule_pressure               pressure(value,state.count);
+    std::vector<int>                memory_reads,since_barrier;
+    std::set<int>                   ready[3];
+    int                             last_memory_write=-1,barrier=-1,moved=0,lowest=0,i,c;
+    unsigned                        k,j;
+
+    for(i=0;i<n;i++) {
+        kind[i]  = get_schedule_kind(code[first+i]);
+        fetch[i] = is_long_latency(code[first+i],kind[i]);
+        if( fetch[i] ) moved = 1;
+    }
+
+    // nothing to hoist, original order is kept
+    if( !moved || n<2 ) return 0;
+    moved = 0;
+
+    // dependencies ( duplicate edges are counted in npred ) and values of register components
+    for(i=0;i<n;i++) {
+        const register_access& a = liveness.access[first+i];
+
+        if( kind[i]==SCHEDULE_BARRIER ) {
+            for(j=0;j<since_barrier.size();j++) add_schedule_edge(succ,npred,since_barrier[j],i);
+            since_barrier.clear();
+            barrier = i;
+        }
+        else add_schedule_edge(succ,npred,barrier,i);
+        since_barrier.push_back(i);
+
+        if( kind[i]==SCHEDULE_READ || kind[i]==SCHEDULE_WRITE ) {
+            add_schedule_edge(succ,npred,last_memory_write,i);
+
+            if( kind[i]==SCHEDULE_READ ) memory_reads.push_back(i);
+            else {
+                for(j=0;j<memory_reads.size();j++) add_schedule_edge(succ,npred,memory_reads[j],i);
+                memory_reads.clear();
+                last_memory_write = i;
+            }
+        }
+
+        for(k=0;k<a.use.size();k++) {
+            for(c=0;c<4;c++) {
+                int bit = 4*a.use[k].first+c;
+                if( !(a.use[k].second&(1<<c)) ) continue;
+
+                int v = state.current[bit]>=0 ? state.current[bit] : new_schedule_value(value,state,bit,true);
+                value[v].readers++;
+                reads[i].push_back(v);
+
+                add_schedule_edge(succ,npred,state.last_write[bit],i);
+                state.readers[bit].push_back(i);
+            }
+        }
+        for(k=0;k<a.def.size();k++) {
+            for(c=0;c<4;c++) {
+                int bit = 4*a.def[k].first+c;
+                if( !(a.def[k].second&(1<<c)) ) continue;
+
+                add_schedule_edge(succ,npred,state.last_write[bit],i);
+                for(j=0;j<state.readers[bit].size();j++) add_schedule_edge(succ,npred,state.readers[bit][j],i);
+                state.readers[bit].clear();
+                state.last_write[bit] = i;
+
+                writes[i].push_back( new_schedule_value(value,state,bit,false) );
+            }
+        }
+    }
+
+    // last values of components live after the block, components passing through the block
+    for(j=0;j<state.touched.size();j++) value[state.current[state.touched[j]]].final = live_out.test(state.touched[j]);
+    for(std::size_t b=live_out.find_first();b!=boost::dynamic_bitset<>::npos;b=live_out.find_next(b)) {
+        if( state.current[b]<0 ) value[new_schedule_value(value,state,(int)b,true)].final = true;
+    }
+    for(j=0;j<value.size();j++) pressure.update(j);
+
+    // instructions which have to be scheduled before some fetch
+    for(i=n-1;i>=0;i--) {
+        if( fetch[i] ) queue[i] = SCHEDULE_QUEUE_FETCH;
+        for(k=0;k<succ[i].size() && queue[i]==SCHEDULE_QUEUE_OTHER;k++) {
+            if( queue[succ[i][k]]!=SCHEDULE_QUEUE_OTHER ) queue[i] = SCHEDULE_QUEUE_FEED;
+        }
+    }
+
+    for(i=0;i<n;i++) {
+        if( npred[i]==0 ) ready[queue[i]].insert(i);
+    }
+
+    while( !ready[0].empty() || !ready[1].empty() || !ready[2].empty() ) {
+        int q,lowest_ready=-1,next=-1;
+
+        for(q=0;q<3;q++) {
+            if( !ready[q].empty() && (lowest_ready<0 || *ready[q].begin()<lowest_ready) ) lowest_ready = *ready[q].begin();
+        }
+        for(q=0;q<3 && next<0;q++) {
+            if( ready[q].empty() ) continue;
+            if( *ready[q].begin()==lowest_ready || (q!=SCHEDULE_QUEUE_OTHER && pressure.pressure+1<=budget) ) next = *ready[q].begin();
+        }
+        ready[queue[next]].erase(next);
+
+        // fetch issued while earlier instruction waits
+        if( fetch[next] && lowest<next ) moved++;
+
+        order.push_back(next);
+        done[next] = 1;
+        while( lowest<n && done[lowest] ) lowest++;
+
+        for(k=0;k<reads[next].size();k++) {
+            value[reads[next][k]].readers--;
+            pressure.update(reads[next][k]);
+        }
+        for(k=0;k<writes[next].size();k++) {
+            value[writes[next][k]].started = true;
+            pressure.update(writes[next][k]);
+        }
+
+        for(k=0;k<succ[next].size();k++) {
+            int s = succ[next][k];
+            if( --npred[s]==0 ) ready[queue[s]].insert(s);
+        }
+    }
+
+    state.clear();
+    assert( (int)order.size()==n );
+
+    instruction_list block(code.begin()+first,code.begin()+last+1);
+    for(i=0;i<n;i++) code[first+i] = block[order[i]];
+
+    return moved;
+}
+
+//
+// moves texture, UAV and global buffer reads up in their basic block so their latency overlaps ALU work
+// fetch is moved only while number of live vec4 registers stays within budget
+// returns number of moved fetches
+//
+
+inline int schedule( instruction_list& code, int budget )
+{
+    flow_graph          graph;
+    liveness_info       liveness;
+    schedule_state      state;
+    int                 moved=0;
+
+    graph.build(code);
+    liveness.compute(code,graph);
+    state.resize(liveness.map.size());
+
+    for(unsigned b=0;b<graph.block.size();b++) {
+        moved += schedule_block(code,graph.block[b].first,graph.block[b].last,liveness,liveness.live_out[b],state,budget);
+    }
+
+    return moved;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif
@@ -0,0 +1,327 @@
+/*
+ * C++ to IL compiler/generator superword level parallelism
+ *
+ * Copyright (C) 2010, 2011 Artur Kornacki
+ *
+ * This file is part of CAL++.
+ *
+ * CAL++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * CAL++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with CAL++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CAL_IL_SLP_H
+#define __CAL_IL_SLP_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cal/il/cal_il_instruction.hpp>
+#include <cal/il/opt/cal_il_flowgraph.hpp>
+#include <cal/il/opt/cal_il_copyprop.hpp>
+#include <cal/il/opt/cal_il_mad.hpp>
+
+namespace cal {
+namespace il {
+namespace detail {
+
+//
+// instructions computing every output component only from the same component of source swizzles
+//
+
+inline bool is_componentwise( const std::string& opcode )
+{
+    static const char* ops[] = {
+        "mov", "add", "sub", "mul", "div", "mad", "fma", "min", "max", "frc", "abs",
+        "round_nearest", "round_neginf", "round_plusinf", "round_z",
+        "eq", "ne", "lt", "ge", "ieq", "ine", "ilt", "ige", "ult", "uge",
+        "iadd", "imul", "umul", "imad", "umad", "imin", "imax", "umin", "umax",
+        "iand", "ior", "ixor", "inot", "inegate", "ishl", "ishr", "ushr",
+        "ftoi", "ftou", "itof", "utof", "cmov_logical",
+        NULL
+    };
+
+    for(int i=0;ops[i];i++) {
+        if( opcode==ops[i] ) return true;
+    }
+    return false;
+}
+
+//
+// scalar instruction which can become part of vector instruction
+// writes single component of temporary register, no modifiers
+//
+
+inline int slp_component( const instruction& inst )
+{
+    if( !inst.text.empty() || !is_componentwise(inst.opcode) || !is_pure(inst) ) return -1;
+    if( temp_register(inst.operand[0].name)<0 || !inst.operand[0].modifier.empty() ) return -1;
+
+    for(unsigned k=1;k<inst.operand.size();k++) {
+        if( !inst.operand[k].modifier.empty() ) return -1;
+        if( inst.operand[k].name.find('[')!=std::string::npos ) return -1;
+    }
+
+    switch( write_mask(inst.operand[0]) ) {
+    case 1: return 0;
+    case 2: return 1;
+    case 4: return 2;
+    case 8: return 3;
+    }
+    return -1;
+}
+
+//
+// same operation on the same source operands ( destination can differ when results are packed )
+//
+
+inline bool is_isomorphic( const instruction& a, const instruction& b, bool pack )
+{
+    if( a.opcode!=b.opcode || a.operand.size()!=b.operand.size() ) return false;
+    if( !pack && a.operand[0].name!=b.operand[0].name ) return false;
+
+    for(unsigned k=1;k<a.operand.size();k++) {
+        if( a.operand[k].name!=b.operand[k].name ) return false;
+    }
+    return true;
+}
+
+//
+// components of temporary registers read by scalar instruction
+//
+
+inline bool slp_reads( const instruction& inst, int c, int r, int mask )
+{
+    for(unsigned k=1;k<inst.operand.size();k++) {
+        if( temp_register(inst.operand[k].name)!=r ) continue;
+
+        int s = swizzle_component(inst.operand[k].swizzle,c);
+        if( s>=0 && (mask&(1<<s)) ) return true;
+    }
+    return false;
+}
+
+//
+// instruction j ( component cj ) can be moved up to position f
+//
+
+inline bool slp_movable( const instruction_list& code, const liveness_info& liveness, int f, int j, int cj )
+{
+    const instruction&      inst = code[j];
+    const register_access&  aj   = liveness.access[j];
+
+    for(int m=f;m<j;m++) {
+        const register_access& a = liveness.access[m];
+
+        if( !code[m].text.empty() ) return false;
+
+        // sources of j written, destination of j read or written
+        for(unsigned k=0;k<a.def.size();k++) {
+            int r = liveness.map.reg[a.def[k].first];
+            if( slp_reads(inst,cj,r,a.def[k].second) ) return false;
+            if( a.def[k].first==aj.def[0].first && (a.def[k].second&(1<<cj)) ) return false;
+        }
+        if( reads_components(a,aj.def[0].first,1<<cj) ) return false;
+    }
+
+    return true;
+}
+
+//
+// temporary register usage, registers with single definition and simple uses can be renamed
+//
+
+struct slp_register
+{
+    int                                 defs;
+    int                                 mask;       // components written or read
+    bool                                complex;    // used in index expression or unparsed line
+    std::vector<std::pair<int,int> >    use;        // instruction, operand
+
+    slp_register() : defs(0), mask(0), complex(false) {}
+};
+
+struct slp_complex_marker
+{
+    std::map<int,slp_register>& reg;
+
+    slp_complex_marker( std::map<int,slp_register>& _reg ) : reg(_reg) {}
+
+    void operator()( std::string::size_type pos, std::string::size_type len, int r ) const
+    {
+        reg[r].complex = true;
+    }
+};
+
+inline void get_slp_registers( const instruction_list& code, std::map<int,slp_register>& reg )
+{
+    for(unsigned i=0;i<code.size();i++) {
+        const instruction& inst = code[i];
+        unsigned           first = has_destination(inst) ? 1 : 0;
+
+        if( inst.opcode.empty() || is_declaration(inst) ) continue;
+        if( !inst.text.empty() ) {
+            for_each_temp( inst.text, slp_complex_marker(reg) );
+            continue;
+        }
+
+        for(unsigned k=0;k<inst.operand.size();k++) {
+            int r = temp_register(inst.operand[k].name);
+
+            if( r<0 ) {
+                for_each_temp( inst.operand[k].name, slp_complex_marker(reg) );
+                continue;
+            }
+
+            slp_register& sr = reg[r];
+            sr.mask |= component_mask(inst.operand[k].swizzle);
+            if( k<first ) sr.defs++;
+            else sr.use.push_back(std::make_pair((int)i,(int)k));
+        }
+    }
+}
+
+//
+// single component register which can be moved to other register component
+//
+
+inline bool is_renamable( const std::map<int,slp_register>& reg, int r, int c )
+{
+    std::map<int,slp_register>::const_iterator i = reg.find(r);
+    return i!=reg.end() && i->second.defs==1 && !i->second.complex && i->second.mask==(1<<c);
+}
+
+inline std::string slp_swizzle( const std::vector<int>& component, const std::vector<int>& lane, const std::vector<const instruction*>& member, unsigned k, int mask )
+{
+    std::string s(4,' ');
+    char        fill=0;
+
+    for(unsigned i=0;i<member.size();i++) {
+        int  v = swizzle_component(member[i]->operand[k].swizzle,component[i]);
+        char l = v>=0 ? "xyzw"[v] : (v==-1 ? '0' : '1');
+
+        s[lane[i]] = l;
+        if( !fill ) fill = l;
+    }
+    for(int c=0;c<4;c++) {
+        if( !(mask&(1<<c)) ) s[c] = fill;
+    }
+
+    if( s[0]==s[1] && s[0]==s[2] && s[0]==s[3] ) s.erase(1);
+    if( s=="xyzw" ) s.clear();
+    return s;
+}
+
+//
+// merges isomorphic independent scalar instructions into one vector instruction
+// "sub r1.x,r2.x,r3.x" "sub r4.x,r2.y,r3.y" gives "sub r1.xy__,r2.xyxx,r3.xyxx" and reads of r4.x become r1.y
+// results in other registers are moved only when the register has single definition and single component
+// returns number of removed instructions
+//
+
+inline int slp( instruction_list& code )
+{
+    flow_graph                  graph;
+    liveness_info               liveness;
+    std::map<int,slp_register>  reg;
+    std::vector<char>           remove(code.size(),0);
+    int                         removed=0;
+
+    graph.build(code);
+    liveness.compute(code,graph);
+    get_slp_registers(code,reg);
+
+    for(unsigned b=0;b<graph.block.size();b++) {
+        for(int f=graph.block[b].first;f<=graph.block[b].last;f++) {
+            int cf = slp_component(code[f]);
+            if( remove[f] || cf<0 ) continue;
+
+            int                              r0 = temp_register(code[f].operand[0].name);
+            bool                             pack = is_renamable(reg,r0,cf);
+            std::vector<const instruction*>  member(1,&code[f]);
+            std::vector<int>                 component(1,cf);
+            std::vector<int>                 lane(1,cf);
+            std::vector<int>                 position;
+            int                              mask = 1<<cf;
+
+            for(int j=f+1;j<=graph.block[b].last && mask!=0xF;j++) {
+                int cj = slp_component(code[j]);
+                int rj,l;
+
+                if( !code[j].text.empty() ) break;
+                if( remove[j] || cj<0 || !is_isomorphic(code[f],code[j],pack) ) continue;
+
+                rj = temp_register(code[j].operand[0].name);
+                if( rj==r0 ) l = cj;
+                else {
+                    if( !pack || !is_renamable(reg,rj,cj) ) continue;
+
+                    // prefer lane matching source component
+                    l = swizzle_component(code[j].operand[1].swizzle,cj);
+                    if( l<0 || (mask&(1<<l)) ) for(l=0;l<4 && (mask&(1<<l));l++);
+                }
+                if( mask&(1<<l) ) continue;
+                if( !slp_movable(code,liveness,f,j,cj) ) continue;
+
+                member.push_back(&code[j]);
+                component.push_back(cj);
+                lane.push_back(l);
+                position.push_back(j);
+                mask |= 1<<l;
+            }
+
+            if( member.size()<2 ) continue;
+
+            instruction merged = code[f];
+            std::string dst;
+            for(int c=0;c<4;c++) dst += (mask&(1<<c)) ? "xyzw"[c] : '_';
+            merged.operand[0].swizzle = dst;
+
+            for(unsigned k=1;k<merged.operand.size();k++) {
+                merged.operand[k].swizzle = slp_swizzle(component,lane,member,k,mask);
+            }
+
+            // reads of moved results
+            for(unsigned i=1;i<member.size();i++) {
+                int rj = temp_register(member[i]->operand[0].name);
+                if( rj==r0 ) continue;
+
+                slp_register& sr = reg[rj];
+                for(unsigned u=0;u<sr.use.size();u++) {
+                    instruction_operand& op = code[sr.use[u].first].operand[sr.use[u].second];
+
+                    op.name = merged.operand[0].name;
+                    for(std::string::size_type p=0;p<op.swizzle.length();p++) {
+                        if( op.swizzle[p]=="xyzw"[component[i]] ) op.swizzle[p] = "xyzw"[lane[i]];
+                    }
+                    reg[r0].use.push_back(sr.use[u]);
+                }
+                reg.erase(rj);
+            }
+            reg[r0].mask |= mask;
+
+            code[f] = merged;
+            for(unsigned i=0;i<position.size();i++) remove[position[i]] = 1;
+            removed += position.size();
+        }
+    }
+
+    compact_code(code,remove);
+    return removed;
+}
+
+} // detail
+} // il
+} // cal
+
+#endif